@@ -0,0 +1,242 @@
+/**
+ * @file benchmark.c
+ *
+ * Headless runner of the benchmark demo.
+ *
+ * - Renders into memory with a display driver without a real display
+ * - Advances a virtual tick with a fixed period so every run draws the same frames
+ * - Runs every scene for a fixed number of frames with and without opacity
+ * - Writes the render time, the pixels per second and the p50/p99 frame time of every scene as JSON
+ *
+ * Usage: benchmark [output.json] [frame count]
+ * The logs are printed to stdout so the result is written to `benchmark.json` by default.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _POSIX_C_SOURCE 199309L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl/lvgl.h"
+#include "lv_examples/lv_examples.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCHMARK_OUT_DEF           "benchmark.json"
+#define BENCHMARK_FRAME_CNT_DEF     100
+#define BENCHMARK_FRAME_PERIOD      LV_DISP_DEF_REFR_PERIOD     /*Virtual time between the frames [ms]*/
+#define BENCHMARK_WARMUP_FRAME_CNT  2                           /*Frames drawn before measuring a scene*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint64_t time_sum;      /*Sum of the frame times [ns]*/
+    uint64_t px_sum;        /*Number of rendered pixels*/
+    uint32_t frame_cnt;
+    uint32_t p50;           /*Frame time percentiles [ns]*/
+    uint32_t p99;
+} scene_res_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hal_init(void);
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px);
+static void scene_run(uint32_t scene_id, bool opa, uint32_t frame_cnt, scene_res_t * res);
+static uint64_t time_ns(void);
+static int frame_time_cmp(const void * a, const void * b);
+static void json_write_str(FILE * f, const char * s);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t draw_buf[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+static lv_color_t frame_buf[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+static uint64_t px_act;
+static uint32_t * frame_times;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    const char * out_path = argc > 1 ? argv[1] : BENCHMARK_OUT_DEF;
+    uint32_t frame_cnt = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCHMARK_FRAME_CNT_DEF;
+    if(frame_cnt == 0) frame_cnt = 1;
+
+    FILE * out = fopen(out_path, "w");
+    if(out == NULL) {
+        fprintf(stderr, "Can't open %s\n", out_path);
+        return 1;
+    }
+
+    frame_times = malloc(sizeof(uint32_t) * frame_cnt);
+    if(frame_times == NULL) return 1;
+
+    lv_init();
+    hal_init();
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"hor_res\": %d,\n  \"ver_res\": %d,\n", LV_HOR_RES_MAX, LV_VER_RES_MAX);
+    fprintf(out, "  \"color_depth\": %d,\n  \"frame_cnt\": %u,\n", LV_COLOR_DEPTH, (unsigned)frame_cnt);
+    fprintf(out, "  \"scenes\": [\n");
+
+    uint32_t scene_cnt = lv_demo_benchmark_get_scene_cnt();
+    uint32_t i;
+    for(i = 0; i < scene_cnt * 2; i++) {
+        uint32_t scene_id = i / 2;
+        bool opa = i & 1;
+
+        scene_res_t res;
+        scene_run(scene_id, opa, frame_cnt, &res);
+
+        double time_ms = (double)res.time_sum / 1000000.0;
+        double px_per_sec = res.time_sum ? (double)res.px_sum * 1000000000.0 / (double)res.time_sum : 0.0;
+
+        fprintf(out, "    {\"name\": ");
+        json_write_str(out, lv_demo_benchmark_get_scene_name(scene_id));
+        fprintf(out, ", \"opa\": %s, \"frames\": %u, \"render_time_ms\": %.3f, \"px\": %llu, "
+                "\"px_per_sec\": %.0f, \"frame_p50_ms\": %.3f, \"frame_p99_ms\": %.3f}%s\n",
+                opa ? "true" : "false", (unsigned)res.frame_cnt, time_ms, (unsigned long long)res.px_sum,
+                px_per_sec, (double)res.p50 / 1000000.0, (double)res.p99 / 1000000.0,
+                i + 1 < scene_cnt * 2 ? "," : "");
+    }
+
+    fprintf(out, "  ]\n}\n");
+
+    fclose(out);
+    free(frame_times);
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Initialize a display which renders into `frame_buf`
+ */
+static void hal_init(void)
+{
+    static lv_disp_buf_t disp_buf;
+    lv_disp_buf_init(&disp_buf, draw_buf, NULL, LV_HOR_RES_MAX * LV_VER_RES_MAX);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.buffer = &disp_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.monitor_cb = monitor_cb;
+    lv_disp_drv_register(&disp_drv);
+}
+
+/**
+ * Copy the rendered area into the frame buffer
+ */
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&frame_buf[y * LV_HOR_RES_MAX + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * Count the rendered pixels
+ */
+static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px)
+{
+    (void)drv;
+    (void)time;     /*It's measured with the virtual tick, so useless here*/
+    px_act += px;
+}
+
+/**
+ * Load a scene, draw it on a virtual tick and measure the real time of the frames
+ * @param scene_id index of the scene
+ * @param opa true: run the semi transparent version of the scene
+ * @param frame_cnt number of frames to measure
+ * @param res store the result here
+ */
+static void scene_run(uint32_t scene_id, bool opa, uint32_t frame_cnt, scene_res_t * res)
+{
+    memset(res, 0, sizeof(scene_res_t));
+
+    lv_demo_benchmark_load_scene(scene_id, opa);
+
+    /*Draw the whole screen once so that the first frame of each scene starts from the same state*/
+    lv_obj_invalidate(lv_scr_act());
+    uint32_t i;
+    for(i = 0; i < BENCHMARK_WARMUP_FRAME_CNT; i++) {
+        lv_tick_inc(BENCHMARK_FRAME_PERIOD);
+        lv_task_handler();
+        lv_refr_now(NULL);
+    }
+
+    px_act = 0;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_tick_inc(BENCHMARK_FRAME_PERIOD);
+
+        uint64_t t_start = time_ns();
+        lv_task_handler();
+        lv_refr_now(NULL);
+        uint64_t t = time_ns() - t_start;
+
+        frame_times[i] = t > UINT32_MAX ? UINT32_MAX : (uint32_t)t;
+        res->time_sum += t;
+    }
+
+    res->frame_cnt = frame_cnt;
+    res->px_sum = px_act;
+
+    qsort(frame_times, frame_cnt, sizeof(uint32_t), frame_time_cmp);
+    res->p50 = frame_times[(frame_cnt - 1) * 50 / 100];
+    res->p99 = frame_times[(frame_cnt - 1) * 99 / 100];
+}
+
+/**
+ * Get the time of a monotonic clock
+ * @return the time in nanoseconds
+ */
+static uint64_t time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static int frame_time_cmp(const void * a, const void * b)
+{
+    uint32_t ta = *(const uint32_t *)a;
+    uint32_t tb = *(const uint32_t *)b;
+    return ta < tb ? -1 : (ta > tb ? 1 : 0);
+}
+
+/**
+ * Write a string as a JSON string literal
+ */
+static void json_write_str(FILE * f, const char * s)
+{
+    fputc('"', f);
+    while(*s) {
+        if(*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+        s++;
+    }
+    fputc('"', f);
+}
@@ -21,6 +21,8 @@
 #include <unistd.h>
 #include <errno.h>
 #include <sys/mman.h>
+#include <sys/select.h>
+#include <poll.h>
 #include <inttypes.h>
 
 #include <xf86drm.h>
@@ -31,6 +33,16 @@
 
 #define DIV_ROUND_UP(n, d) (((n) + (d) - 1) / (d))
 
+#ifndef DRM_BUF_CNT
+#define DRM_BUF_CNT 2
+#endif
+
+#if DRM_BUF_CNT < 2 || DRM_BUF_CNT > 3
+#error DRM_BUF_CNT must be 2 or 3
+#endif
+
+#define DRM_EVENT_PERIOD 5 /*ms*/
+
 #define print(msg, ...)	fprintf(stderr, msg, ##__VA_ARGS__);
 #define err(msg, ...)  print("error: " msg "\n", ##__VA_ARGS__)
 #define info(msg, ...) print(msg "\n", ##__VA_ARGS__)
@@ -65,8 +77,16 @@ struct drm_dev {
 	drmModePropertyPtr plane_props[128];
 	drmModePropertyPtr crtc_props[128];
 	drmModePropertyPtr conn_props[128];
-	struct drm_buffer drm_bufs[2]; /* DUMB buffers */
+	struct drm_buffer drm_bufs[DRM_BUF_CNT]; /* DUMB buffers */
 	struct drm_buffer *cur_bufs[2]; /* double buffering handling */
+
+	/* Direct mode: LVGL renders into the DUMB buffers */
+	bool direct;
+	volatile bool flip_pending;
+	struct drm_buffer *shown_buf; /* scanned out */
+	struct drm_buffer *queued_buf; /* committed, waiting for the page flip */
+	lv_area_t prev_damage[LV_INV_BUF_SIZE]; /* areas of the previous frame, to sync the free buffer */
+	uint32_t prev_damage_cnt;
 } drm_dev;
 
 static uint32_t get_plane_property_id(const char *name)
@@ -118,6 +138,13 @@ static void page_flip_handler(int fd, unsigned int sequence, unsigned int tv_sec
 			      unsigned int tv_usec, void *user_data)
 {
 	dbg("flip");
+
+	if (drm_dev.queued_buf) {
+		drm_dev.shown_buf = drm_dev.queued_buf;
+		drm_dev.queued_buf = NULL;
+	}
+
+	drm_dev.flip_pending = false;
 }
 
 static int drm_get_plane_props(void)
@@ -240,12 +267,15 @@ static int drm_add_conn_property(const char *name, uint64_t value)
 	return 0;
 }
 
-static int drm_dmabuf_set_plane(struct drm_buffer *buf)
+static int drm_dmabuf_set_plane(struct drm_buffer *buf, uint32_t damage_blob_id, bool nonblock)
 {
 	int ret;
 	static int first = 1;
 	uint32_t flags = DRM_MODE_PAGE_FLIP_EVENT;
 
+	if (nonblock)
+		flags |= DRM_MODE_ATOMIC_NONBLOCK;
+
 	drm_dev.req = drmModeAtomicAlloc();
 
 	/* On first Atomic commit, do a modeset */
@@ -271,10 +301,15 @@ static int drm_dmabuf_set_plane(struct drm_buffer *buf)
 	drm_add_plane_property("CRTC_W", drm_dev.width);
 	drm_add_plane_property("CRTC_H", drm_dev.height);
 
+	/* Let the kernel and the display controller skip the unchanged regions */
+	if (damage_blob_id)
+		drm_add_plane_property("FB_DAMAGE_CLIPS", damage_blob_id);
+
 	ret = drmModeAtomicCommit(drm_dev.fd, drm_dev.req, flags, NULL);
 	if (ret) {
 		err("drmModeAtomicCommit failed: %s", strerror(errno));
 		drmModeAtomicFree(drm_dev.req);
+		drm_dev.req = NULL;
 		return ret;
 	}
 
@@ -664,14 +699,14 @@ static int drm_setup_buffers(void)
 {
 	int ret;
 
-	/* Allocate DUMB buffers */
-	ret = drm_allocate_dumb(&drm_dev.drm_bufs[0]);
-	if (ret)
-		return ret;
+	int i;
 
-	ret = drm_allocate_dumb(&drm_dev.drm_bufs[1]);
-	if (ret)
-		return ret;
+	/* Allocate DUMB buffers */
+	for (i = 0; i < DRM_BUF_CNT; i++) {
+		ret = drm_allocate_dumb(&drm_dev.drm_bufs[i]);
+		if (ret)
+			return ret;
+	}
 
 	/* Set buffering handling */
 	drm_dev.cur_bufs[0] = NULL;
@@ -680,10 +715,18 @@ static int drm_setup_buffers(void)
 	return 0;
 }
 
+static void drm_wait_flip(void);
+
 void drm_wait_vsync(lv_disp_drv_t *disp_drv)
 {
 	int ret;
 	fd_set fds;
+
+	if (drm_dev.direct) {
+		drm_wait_flip();
+		return;
+	}
+
 	FD_ZERO(&fds);
 	FD_SET(drm_dev.fd, &fds);
 
@@ -705,6 +748,199 @@ void drm_wait_vsync(lv_disp_drv_t *disp_drv)
 	drm_dev.req = NULL;
 }
 
+static void drm_wait_flip(void)
+{
+	int ret;
+	fd_set fds;
+
+	while (drm_dev.flip_pending) {
+		FD_ZERO(&fds);
+		FD_SET(drm_dev.fd, &fds);
+
+		ret = select(drm_dev.fd + 1, &fds, NULL, NULL, NULL);
+		if (ret == -1 && errno == EINTR)
+			continue;
+
+		if (ret < 0) {
+			err("select failed: %s", strerror(errno));
+			drm_dev.flip_pending = false;
+			break;
+		}
+
+		drmHandleEvent(drm_dev.fd, &drm_dev.drm_event_ctx);
+	}
+}
+
+static void drm_event_task(lv_task_t *task)
+{
+	struct pollfd pfd;
+
+	(void)task;
+
+	if (!drm_dev.flip_pending)
+		return;
+
+	/* Handle the page flip without blocking while LVGL renders the next frame */
+	pfd.fd = drm_dev.fd;
+	pfd.events = POLLIN;
+	if (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN))
+		drmHandleEvent(drm_dev.fd, &drm_dev.drm_event_ctx);
+}
+
+static struct drm_buffer *drm_get_buf(const void *map)
+{
+	int i;
+
+	for (i = 0; i < DRM_BUF_CNT; i++) {
+		if (drm_dev.drm_bufs[i].map == map)
+			return &drm_dev.drm_bufs[i];
+	}
+
+	return NULL;
+}
+
+static lv_disp_t *drm_get_disp(lv_disp_drv_t *disp_drv)
+{
+	lv_disp_t *disp = lv_disp_get_next(NULL);
+
+	while (disp && &disp->driver != disp_drv)
+		disp = lv_disp_get_next(disp);
+
+	return disp;
+}
+
+/* Create a FB_DAMAGE_CLIPS blob from the joined invalid areas. Return 0 for a full update. */
+static uint32_t drm_create_damage_blob(lv_disp_t *disp)
+{
+	struct drm_mode_rect rects[LV_INV_BUF_SIZE];
+	uint32_t blob_id = 0;
+	uint32_t cnt = 0;
+	uint32_t i;
+
+	if (!disp || !get_plane_property_id("FB_DAMAGE_CLIPS"))
+		return 0;
+
+	for (i = 0; i < disp->inv_p; i++) {
+		if (disp->inv_area_joined[i])
+			continue;
+
+		rects[cnt].x1 = disp->inv_areas[i].x1;
+		rects[cnt].y1 = disp->inv_areas[i].y1;
+		rects[cnt].x2 = disp->inv_areas[i].x2 + 1;
+		rects[cnt].y2 = disp->inv_areas[i].y2 + 1;
+		cnt++;
+	}
+
+	if (cnt == 0)
+		return 0;
+
+	if (drmModeCreatePropertyBlob(drm_dev.fd, rects, cnt * sizeof(struct drm_mode_rect), &blob_id)) {
+		err("error creating damage blob");
+		return 0;
+	}
+
+	return blob_id;
+}
+
+/* Copy the areas of the previous frame from `src` to `dest`. LVGL copies only the areas of the current frame. */
+static void drm_sync_prev_damage(struct drm_buffer *dest, const struct drm_buffer *src)
+{
+	uint32_t i;
+	lv_coord_t y;
+
+	for (i = 0; i < drm_dev.prev_damage_cnt; i++) {
+		const lv_area_t *a = &drm_dev.prev_damage[i];
+		uint32_t line_size = lv_area_get_width(a) * sizeof(lv_color_t);
+
+		for (y = a->y1; y <= a->y2; y++) {
+			uint32_t offs = y * src->pitch + a->x1 * sizeof(lv_color_t);
+			memcpy((uint8_t *)dest->map + offs, (uint8_t *)src->map + offs, line_size);
+		}
+	}
+}
+
+static void drm_save_prev_damage(lv_disp_t *disp)
+{
+	uint32_t i;
+
+	drm_dev.prev_damage_cnt = 0;
+
+	if (!disp)
+		return;
+
+	for (i = 0; i < disp->inv_p; i++) {
+		if (!disp->inv_area_joined[i])
+			lv_area_copy(&drm_dev.prev_damage[drm_dev.prev_damage_cnt++], &disp->inv_areas[i]);
+	}
+}
+
+static void drm_flush_direct(lv_disp_drv_t *disp_drv, lv_color_t *color_p)
+{
+	struct drm_buffer *fbuf = drm_get_buf(color_p);
+	lv_disp_t *disp = drm_get_disp(disp_drv);
+	uint32_t damage_blob_id;
+	int ret;
+
+	if (!fbuf) {
+		err("Not a DRM buffer");
+		lv_disp_flush_ready(disp_drv);
+		return;
+	}
+
+	/* Only one commit can be pending */
+	drm_wait_flip();
+
+	damage_blob_id = drm_create_damage_blob(disp);
+	ret = drm_dmabuf_set_plane(fbuf, damage_blob_id, true);
+	if (damage_blob_id)
+		drmModeDestroyPropertyBlob(drm_dev.fd, damage_blob_id);
+
+	if (drm_dev.req) {
+		drmModeAtomicFree(drm_dev.req);
+		drm_dev.req = NULL;
+	}
+
+	if (ret) {
+		err("Flush fail");
+		lv_disp_flush_ready(disp_drv);
+		return;
+	}
+
+	drm_dev.queued_buf = fbuf;
+	drm_dev.flip_pending = true;
+
+#if DRM_BUF_CNT == 3
+	/* Render the next frame into the buffer which is neither shown nor queued.
+	 * It misses the previous frame too, so copy its areas here; LVGL copies the current ones
+	 * after the flush. */
+	{
+		lv_disp_buf_t *vdb = disp_drv->buffer;
+		struct drm_buffer *free_buf = NULL;
+		int i;
+
+		for (i = 0; i < DRM_BUF_CNT; i++) {
+			if (&drm_dev.drm_bufs[i] != fbuf && &drm_dev.drm_bufs[i] != drm_dev.shown_buf) {
+				free_buf = &drm_dev.drm_bufs[i];
+				break;
+			}
+		}
+
+		drm_sync_prev_damage(free_buf, fbuf);
+		drm_save_prev_damage(disp);
+
+		if (vdb->buf1 == color_p)
+			vdb->buf2 = free_buf->map;
+		else
+			vdb->buf1 = free_buf->map;
+	}
+#else
+	/* The other buffer is shown until the flip, so LVGL can't render into it before that */
+	drm_wait_flip();
+#endif
+
+	lv_disp_flush_ready(disp_drv);
+}
+
 void drm_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
 	struct drm_buffer *fbuf = drm_dev.cur_bufs[1];
@@ -714,6 +950,11 @@ void drm_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color
 
 	dbg("x %d:%d y %d:%d w %d h %d", area->x1, area->x2, area->y1, area->y2, w, h);
 
+	if (drm_dev.direct) {
+		drm_flush_direct(disp_drv, color_p);
+		return;
+	}
+
 	/* Partial update */
 	if ((w != drm_dev.width || h != drm_dev.height) && drm_dev.cur_bufs[0])
 		memcpy(fbuf->map, drm_dev.cur_bufs[0]->map, fbuf->size);
@@ -728,7 +969,7 @@ void drm_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color
 		drm_wait_vsync(disp_drv);
 
 	/* show fbuf plane */
-	if (drm_dmabuf_set_plane(fbuf)) {
+	if (drm_dmabuf_set_plane(fbuf, 0, false)) {
 		err("Flush fail");
 		return;
 	}
@@ -787,8 +1028,45 @@ void drm_init(void)
 	info("DRM subsystem and buffer mapped successfully");
 }
 
+bool drm_disp_buf_init(lv_disp_buf_t *disp_buf)
+{
+	int i;
+
+	if (drm_dev.fd < 0)
+		return false;
+
+	/* LVGL needs continuous lines */
+	for (i = 0; i < DRM_BUF_CNT; i++) {
+		if (drm_dev.drm_bufs[i].pitch != drm_dev.width * sizeof(lv_color_t)) {
+			info("drm: the pitch of the buffers is not width * pixel size. Can't render into them directly.");
+			return false;
+		}
+	}
+
+	lv_disp_buf_init(disp_buf, drm_dev.drm_bufs[0].map, drm_dev.drm_bufs[1].map,
+			 drm_dev.width * drm_dev.height);
+
+	/* The buffer which is not rendered first will miss the first frame */
+	lv_area_set(&drm_dev.prev_damage[0], 0, 0, drm_dev.width - 1, drm_dev.height - 1);
+	drm_dev.prev_damage_cnt = 1;
+
+	drm_dev.shown_buf = NULL;
+	drm_dev.queued_buf = NULL;
+	drm_dev.flip_pending = false;
+	drm_dev.direct = true;
+
+	lv_task_create(drm_event_task, DRM_EVENT_PERIOD, LV_TASK_PRIO_HIGH, NULL);
+
+	info("drm: rendering directly into %d buffers", DRM_BUF_CNT);
+
+	return true;
+}
+
 void drm_exit(void)
 {
+	if (drm_dev.direct)
+		drm_wait_flip();
+
 	close(drm_dev.fd);
 	drm_dev.fd = -1;
 }
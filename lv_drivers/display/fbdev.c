@@ -71,6 +71,7 @@ static struct fb_fix_screeninfo finfo;
 static char *fbp = 0;
 static long int screensize = 0;
 static int fbfd = 0;
+static bool direct_mode = false;   /*LVGL renders into `fbp` and flush only pans*/
 
 /**********************
  *      MACROS
@@ -158,6 +159,21 @@ void fbdev_exit(void)
  */
 void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
 {
+#if USE_BSD_FBDEV == 0
+    /*The buffer is already in the video memory, just show it.
+     *LVGL copies the changed areas to the other buffer after the flush.*/
+    if(direct_mode) {
+        LV_UNUSED(area);
+        vinfo.xoffset = 0;
+        vinfo.yoffset = (char *)color_p == fbp ? 0 : vinfo.yres;
+        if(ioctl(fbfd, FBIOPAN_DISPLAY, &vinfo) == -1) {
+            perror("Error panning the display");
+        }
+        lv_disp_flush_ready(drv);
+        return;
+    }
+#endif
+
     if(fbp == NULL ||
             area->x2 < 0 ||
             area->y2 < 0 ||
@@ -236,6 +252,64 @@ void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color
     lv_disp_flush_ready(drv);
 }
 
+/**
+ * Use the two halves of a double height virtual framebuffer as the draw buffers of LVGL.
+ * LVGL renders directly into the video memory and `fbdev_flush` only pans to the ready buffer
+ * instead of copying the pixels.
+ * The display driver's `hor_res` and `ver_res` must be the size of the screen (see `fbdev_get_sizes`).
+ * Call it after `fbdev_init`.
+ * @param disp_buf the display buffer to initialize
+ * @return true: `disp_buf` is initialized; false: the framebuffer can't be used directly
+ *         (e.g. its pixel format or line length is different from LVGL's, or the virtual
+ *         resolution can't be doubled). Use `fbdev_flush` with normal draw buffers in this case.
+ */
+bool fbdev_disp_buf_init(lv_disp_buf_t * disp_buf)
+{
+#if USE_BSD_FBDEV
+    LV_UNUSED(disp_buf);
+    return false;
+#else
+    if(fbp == NULL) return false;
+
+    if(vinfo.bits_per_pixel != LV_COLOR_DEPTH || finfo.line_length != vinfo.xres * sizeof(lv_color_t)) {
+        printf("The framebuffer's format differs from LVGL's. Can't render into it directly.\n");
+        return false;
+    }
+
+    /*Get room for two screens*/
+    if(vinfo.yres_virtual < vinfo.yres * 2) {
+        vinfo.yres_virtual = vinfo.yres * 2;
+        if(ioctl(fbfd, FBIOPUT_VSCREENINFO, &vinfo) == -1 ||
+           ioctl(fbfd, FBIOGET_VSCREENINFO, &vinfo) == -1 ||
+           ioctl(fbfd, FBIOGET_FSCREENINFO, &finfo) == -1) {
+            perror("Error setting the virtual resolution");
+            return false;
+        }
+    }
+
+    long int buf_size = finfo.line_length * vinfo.yres;
+    if(vinfo.yres_virtual < vinfo.yres * 2 || buf_size * 2 > screensize) {
+        printf("The framebuffer can't hold two screens. Can't render into it directly.\n");
+        return false;
+    }
+
+    /*Show the second buffer while LVGL renders into the first*/
+    vinfo.xoffset = 0;
+    vinfo.yoffset = vinfo.yres;
+    if(ioctl(fbfd, FBIOPAN_DISPLAY, &vinfo) == -1) {
+        perror("Error panning the display");
+        return false;
+    }
+
+    lv_disp_buf_init(disp_buf, fbp, fbp + buf_size, vinfo.xres * vinfo.yres);
+    direct_mode = true;
+
+    printf("Rendering directly into the framebuffer.\n");
+
+    return true;
+#endif
+}
+
 void fbdev_get_sizes(uint32_t *width, uint32_t *height) {
     if (width)
         *width = vinfo.xres;
@@ -43,6 +43,7 @@ extern "C" {
 void fbdev_init(void);
 void fbdev_exit(void);
 void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+bool fbdev_disp_buf_init(lv_disp_buf_t * disp_buf);
 void fbdev_get_sizes(uint32_t *width, uint32_t *height);
 
 
@@ -38,18 +38,36 @@
 #define MONITOR_VER_RES        LV_VER_RES
 #endif
 
+/*Use a texture with the pixel format of LVGL if possible to copy the pixels without conversion*/
+#if LV_COLOR_DEPTH == 16
+#  define MONITOR_PX_FORMAT    SDL_PIXELFORMAT_RGB565
+#elif LV_COLOR_DEPTH == 24 || LV_COLOR_DEPTH == 32  /*32 is valid but support 24 for backward compatibility too*/
+#  define MONITOR_PX_FORMAT    SDL_PIXELFORMAT_ARGB8888
+#else
+#  define MONITOR_PX_FORMAT    SDL_PIXELFORMAT_ARGB8888
+#  define MONITOR_PX_CONVERT   1   /*Convert the pixels with `lv_color_to32()`*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_COLOR_DEPTH == 16
+typedef uint16_t monitor_px_t;
+#else
+typedef uint32_t monitor_px_t;
+#endif
+
 typedef struct {
     SDL_Window * window;
     SDL_Renderer * renderer;
     SDL_Texture * texture;
     volatile bool sdl_refr_qry;
 #if MONITOR_DOUBLE_BUFFERED
-    uint32_t * tft_fb_act;
+    monitor_px_t * tft_fb_act;
 #else
-    uint32_t tft_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+    monitor_px_t tft_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+    lv_area_t dirty;        /*Union of the areas flushed since the last texture update*/
+    bool dirty_valid;
 #endif
 }monitor_t;
 
@@ -58,6 +76,9 @@ typedef struct {
  **********************/
 static void window_create(monitor_t * m);
 static void window_update(monitor_t * m);
+#if MONITOR_DOUBLE_BUFFERED == 0
+static void fb_copy(monitor_t * m, const lv_area_t * area, lv_color_t * color_p);
+#endif
 int quit_filter(void * userdata, SDL_Event * event);
 static void monitor_sdl_clean_up(void);
 static void monitor_sdl_init(void);
@@ -119,31 +140,14 @@ void monitor_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t
     }
 
 #if MONITOR_DOUBLE_BUFFERED
-    monitor.tft_fb_act = (uint32_t *)color_p;
+    monitor.tft_fb_act = (monitor_px_t *)color_p;
 
     monitor.sdl_refr_qry = true;
 
     /*IMPORTANT! It must be called to tell the system the flush is ready*/
     lv_disp_flush_ready(disp_drv);
 #else
-
-    int32_t y;
-#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
-    int32_t x;
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        for(x = area->x1; x <= area->x2; x++) {
-            monitor.tft_fb[y * disp_drv->hor_res + x] = lv_color_to32(*color_p);
-            color_p++;
-        }
-
-    }
-#else
-    uint32_t w = lv_area_get_width(area);
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        memcpy(&monitor.tft_fb[y * MONITOR_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
-        color_p += w;
-    }
-#endif
+    fb_copy(&monitor, area, color_p);
 
     monitor.sdl_refr_qry = true;
 
@@ -179,31 +183,14 @@ void monitor_flush2(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t
     }
 
 #if MONITOR_DOUBLE_BUFFERED
-    monitor2.tft_fb_act = (uint32_t *)color_p;
+    monitor2.tft_fb_act = (monitor_px_t *)color_p;
 
     monitor2.sdl_refr_qry = true;
 
     /*IMPORTANT! It must be called to tell the system the flush is ready*/
     lv_disp_flush_ready(disp_drv);
 #else
-
-    int32_t y;
-#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
-    int32_t x;
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        for(x = area->x1; x <= area->x2; x++) {
-            monitor2.tft_fb[y * disp_drv->hor_res + x] = lv_color_to32(*color_p);
-            color_p++;
-        }
-
-    }
-#else
-    uint32_t w = lv_area_get_width(area);
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        memcpy(&monitor2.tft_fb[y * disp_drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
-        color_p += w;
-    }
-#endif
+    fb_copy(&monitor2, area, color_p);
 
     monitor2.sdl_refr_qry = true;
 
@@ -354,14 +341,16 @@ static void window_create(monitor_t * m)
 
     m->renderer = SDL_CreateRenderer(m->window, -1, SDL_RENDERER_SOFTWARE);
     m->texture = SDL_CreateTexture(m->renderer,
-                                SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, MONITOR_HOR_RES, MONITOR_VER_RES);
+                                MONITOR_PX_FORMAT, SDL_TEXTUREACCESS_STREAMING, MONITOR_HOR_RES, MONITOR_VER_RES);
     SDL_SetTextureBlendMode(m->texture, SDL_BLENDMODE_BLEND);
 
     /*Initialize the frame buffer to gray (77 is an empirical value) */
 #if MONITOR_DOUBLE_BUFFERED
-    SDL_UpdateTexture(m->texture, NULL, m->tft_fb_act, MONITOR_HOR_RES * sizeof(uint32_t));
+    SDL_UpdateTexture(m->texture, NULL, m->tft_fb_act, MONITOR_HOR_RES * sizeof(monitor_px_t));
 #else
-    memset(m->tft_fb, 0x44, MONITOR_HOR_RES * MONITOR_VER_RES * sizeof(uint32_t));
+    memset(m->tft_fb, 0x44, MONITOR_HOR_RES * MONITOR_VER_RES * sizeof(monitor_px_t));
+    lv_area_set(&m->dirty, 0, 0, MONITOR_HOR_RES - 1, MONITOR_VER_RES - 1);
+    m->dirty_valid = true;
 #endif
 
     m->sdl_refr_qry = true;
@@ -371,10 +360,20 @@ static void window_create(monitor_t * m)
 static void window_update(monitor_t * m)
 {
 #if MONITOR_DOUBLE_BUFFERED == 0
-    SDL_UpdateTexture(m->texture, NULL, m->tft_fb, MONITOR_HOR_RES * sizeof(uint32_t));
+    /*Upload only the changed part. The texture keeps the rest (e.g. when the window is exposed)*/
+    if(m->dirty_valid) {
+        SDL_Rect r;
+        r.x = m->dirty.x1;
+        r.y = m->dirty.y1;
+        r.w = lv_area_get_width(&m->dirty);
+        r.h = lv_area_get_height(&m->dirty);
+        SDL_UpdateTexture(m->texture, &r, &m->tft_fb[m->dirty.y1 * MONITOR_HOR_RES + m->dirty.x1],
+                          MONITOR_HOR_RES * sizeof(monitor_px_t));
+        m->dirty_valid = false;
+    }
 #else
     if(m->tft_fb_act == NULL) return;
-    SDL_UpdateTexture(m->texture, NULL, m->tft_fb_act, MONITOR_HOR_RES * sizeof(uint32_t));
+    SDL_UpdateTexture(m->texture, NULL, m->tft_fb_act, MONITOR_HOR_RES * sizeof(monitor_px_t));
 #endif
     SDL_RenderClear(m->renderer);
 #if LV_COLOR_SCREEN_TRANSP
@@ -389,4 +388,49 @@ static void window_update(monitor_t * m)
     SDL_RenderPresent(m->renderer);
 }
 
+#if MONITOR_DOUBLE_BUFFERED == 0
+/**
+ * Copy the flushed pixels into the frame buffer of a window and mark them to upload
+ * @param m pointer to a monitor
+ * @param area the flushed area. It's clipped to the window.
+ * @param color_p the pixels of `area`
+ */
+static void fb_copy(monitor_t * m, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_area_t a;
+    lv_area_t scr;
+    lv_area_set(&scr, 0, 0, MONITOR_HOR_RES - 1, MONITOR_VER_RES - 1);
+    if(_lv_area_intersect(&a, area, &scr) == false) return;
+
+    int32_t src_w = lv_area_get_width(area);
+    int32_t w = lv_area_get_width(&a);
+    color_p += (a.y1 - area->y1) * src_w + (a.x1 - area->x1);
+
+    int32_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        monitor_px_t * dest = &m->tft_fb[y * MONITOR_HOR_RES + a.x1];
+#if MONITOR_PX_CONVERT
+        int32_t x;
+        for(x = 0; x < w; x++) {
+            dest[x] = lv_color_to32(color_p[x]);
+        }
+#elif LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+        /*Swap the bytes back to get RGB565. It's a simple loop so the compiler can vectorize it.*/
+        const uint16_t * src = (const uint16_t *)color_p;
+        int32_t x;
+        for(x = 0; x < w; x++) {
+            dest[x] = (uint16_t)((src[x] >> 8) | (src[x] << 8));
+        }
+#else
+        memcpy(dest, color_p, w * sizeof(monitor_px_t));
+#endif
+        color_p += src_w;
+    }
+
+    if(m->dirty_valid) _lv_area_join(&m->dirty, &m->dirty, &a);
+    else lv_area_copy(&m->dirty, &a);
+    m->dirty_valid = true;
+}
+#endif
+
 #endif /*USE_MONITOR*/
@@ -279,6 +279,7 @@
 #if USE_DRM
 #  define DRM_CARD          "/dev/dri/card0"
 #  define DRM_CONNECTOR_ID  -1	/* -1 for the first connected one */
+#  define DRM_BUF_CNT       2	/* 2 or 3. Number of buffers LVGL renders into with `drm_disp_buf_init()` */
 #endif
 
 /*********************
@@ -651,6 +651,53 @@ void lv_demo_benchmark(void)
     scene_next_task_cb(NULL);
 }
 
+/**
+ * Get the number of scenes of the benchmark
+ * @return the number of scenes
+ */
+uint32_t lv_demo_benchmark_get_scene_cnt(void)
+{
+    return sizeof(scenes) / sizeof(scene_dsc_t) - 1;
+}
+
+/**
+ * Get the name of a scene
+ * @param scene_id index of the scene (`< lv_demo_benchmark_get_scene_cnt()`)
+ * @return name of the scene
+ */
+const char * lv_demo_benchmark_get_scene_name(uint32_t scene_id)
+{
+    return scenes[scene_id].name;
+}
+
+/**
+ * Create the objects of a scene on the active screen without the title and the timing of `lv_demo_benchmark()`.
+ * The objects of the previously loaded scene are deleted.
+ * It's useful to measure the scenes with a custom timing, e.g. on a virtual tick without display.
+ * @param scene_id index of the scene (`< lv_demo_benchmark_get_scene_cnt()`)
+ * @param opa true: draw the scene with semi transparent objects
+ */
+void lv_demo_benchmark_load_scene(uint32_t scene_id, bool opa)
+{
+    if(scene_bg == NULL) {
+        lv_obj_t * scr = lv_scr_act();
+        lv_obj_reset_style_list(scr, LV_OBJ_PART_MAIN);
+        lv_obj_set_style_local_bg_opa(scr, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+
+        scene_bg = lv_obj_create(scr, NULL);
+        lv_obj_reset_style_list(scene_bg, LV_OBJ_PART_MAIN);
+        lv_obj_set_size(scene_bg, lv_obj_get_width(scr), lv_obj_get_height(scr));
+
+        lv_style_init(&style_common);
+    }
+
+    lv_obj_clean(scene_bg);
+
+    opa_mode = opa;
+    rnd_reset();
+    scenes[scene_id].create_cb();
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -27,6 +27,28 @@ extern "C" {
  **********************/
 void lv_demo_benchmark(void);
 
+/**
+ * Get the number of scenes of the benchmark
+ * @return the number of scenes
+ */
+uint32_t lv_demo_benchmark_get_scene_cnt(void);
+
+/**
+ * Get the name of a scene
+ * @param scene_id index of the scene (`< lv_demo_benchmark_get_scene_cnt()`)
+ * @return name of the scene
+ */
+const char * lv_demo_benchmark_get_scene_name(uint32_t scene_id);
+
+/**
+ * Create the objects of a scene on the active screen without the title and the timing of `lv_demo_benchmark()`.
+ * The objects of the previously loaded scene are deleted.
+ * It's useful to measure the scenes with a custom timing, e.g. on a virtual tick without display.
+ * @param scene_id index of the scene (`< lv_demo_benchmark_get_scene_cnt()`)
+ * @param opa true: draw the scene with semi transparent objects
+ */
+void lv_demo_benchmark_load_scene(uint32_t scene_id, bool opa);
+
 /**********************
  *      MACROS
  **********************/
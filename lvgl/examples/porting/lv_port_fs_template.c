@@ -53,6 +53,8 @@ static lv_fs_res_t fs_remove (lv_fs_drv_t * drv, const char *path);
 static lv_fs_res_t fs_trunc (lv_fs_drv_t * drv, void * file_p);
 static lv_fs_res_t fs_rename (lv_fs_drv_t * drv, const char * oldname, const char * newname);
 static lv_fs_res_t fs_free (lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
+static lv_fs_res_t fs_map (lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p);
+static lv_fs_res_t fs_unmap (lv_fs_drv_t * drv, void * file_p, const void * data, uint32_t size);
 static lv_fs_res_t fs_dir_open (lv_fs_drv_t * drv, void * rddir_p, const char *path);
 static lv_fs_res_t fs_dir_read (lv_fs_drv_t * drv, void * rddir_p, char *fn);
 static lv_fs_res_t fs_dir_close (lv_fs_drv_t * drv, void * rddir_p);
@@ -102,6 +104,8 @@ void lv_port_fs_init(void)
     fs_drv.remove_cb = fs_remove;
     fs_drv.rename_cb = fs_rename;
     fs_drv.trunc_cb = fs_trunc;
+    fs_drv.map_cb = fs_map;
+    fs_drv.unmap_cb = fs_unmap;
 
     fs_drv.rddir_size = sizeof(dir_t);
     fs_drv.dir_close_cb = fs_dir_close;
@@ -324,6 +328,40 @@ static lv_fs_res_t fs_free (lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * fr
     return res;
 }
 
+/**
+ * Map the whole content of a file into the memory (optional)
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a file_t variable
+ * @param data_p pointer to store the address of the content
+ * @param size_p pointer to store the size of the content
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_map (lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p)
+{
+    lv_fs_res_t res = LV_FS_RES_NOT_IMP;
+
+    /* Add your code here*/
+
+    return res;
+}
+
+/**
+ * Release the content of a file mapped by `fs_map` (optional)
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a file_t variable
+ * @param data the address given by `fs_map`
+ * @param size the size given by `fs_map`
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_unmap (lv_fs_drv_t * drv, void * file_p, const void * data, uint32_t size)
+{
+    lv_fs_res_t res = LV_FS_RES_NOT_IMP;
+
+    /* Add your code here*/
+
+    return res;
+}
+
 /**
  * Initialize a 'lv_fs_dir_t' variable for directory reading
  * @param drv pointer to a driver where this function belongs
@@ -91,6 +91,10 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: Use a TLSF (two-level segregated fit) allocator. Allocation and free take constant time
+ * and the adjacent free cells are joined on free (`LV_MEM_AUTO_DEFRAG` is not used) */
+#  define LV_MEM_TLSF         0
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
@@ -101,6 +105,15 @@ typedef int16_t lv_coord_t;
  * The standard functions might or might not be faster depending on their implementation. */
 #define LV_MEMCPY_MEMSET_STD    0
 
+/* 1: Allocate the objects and the `ext_attr` of the common widgets (cont, btn, label, img)
+ * from slabs of equally sized blocks. It reduces the fragmentation of the heap
+ * and the slabs are freed as a whole when a screen is deleted. */
+#define LV_USE_OBJ_POOL         0
+#if LV_USE_OBJ_POOL
+/* Number of blocks in a slab */
+#  define LV_OBJ_POOL_SLAB_CNT  16
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -141,6 +154,10 @@ typedef int16_t lv_coord_t;
 /* Gesture min velocity at release before swipe (pixels)*/
 #define LV_INDEV_DEF_GESTURE_MIN_VELOCITY 3
 
+/* 1: Find the object under the pointer in a grid of the clickable objects of the screens and layers.
+ * The grid is rebuilt only after objects are created, deleted, moved, resized, hidden or made (non) clickable */
+#define LV_INDEV_HIT_INDEX                0
+
 /*==================
  * Feature usage
  *==================*/
@@ -160,8 +177,17 @@ typedef void * lv_anim_user_data_t;
 /* Allow buffering some shadow calculation
  * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
  * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+ * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost per cached shadow*/
 #define LV_SHADOW_CACHE_SIZE    0
+
+/* Number of different shadows (shadow width, spread and radius) to buffer.
+ * The least recently used shadow is dropped if a new one doesn't fit.
+ * Every rendering thread has its own cache. */
+#define LV_SHADOW_CACHE_CNT     4
+
+/* Limit the memory of the buffered shadows of a rendering thread (in bytes).
+ * 0: no limit (at most LV_SHADOW_CACHE_CNT * LV_SHADOW_CACHE_SIZE^2) */
+#define LV_SHADOW_CACHE_MAX_BYTES 0
 #endif
 
 /*1: enable outline drawing on rectangles*/
@@ -208,6 +234,10 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 /*1: Use VG-Lite for CPU offload on NXP RTxxx platforms */
 #define LV_USE_GPU_NXP_VG_LITE   0
 
+/*1: Use SIMD (SSE2/AVX2 or NEON) in the software blending of RGB565 and ARGB8888 colors.
+ *   The instruction set is selected from the compiler's target flags (e.g. `-mavx2`)*/
+#define LV_USE_GPU_SIMD         0
+
 /* 1: Enable file system (might be required for images */
 #define LV_USE_FILESYSTEM       1
 #if LV_USE_FILESYSTEM
@@ -221,6 +251,51 @@ typedef void * lv_fs_drv_user_data_t;
 /*1: Show CPU usage and FPS count in the right bottom corner*/
 #define LV_USE_PERF_MONITOR     0
 
+/*1: Measure the time of the rendering stages (joining the areas, drawing the widgets, blending, masking, image decoding, flushing).
+ *   The times are summed up per frame and the events can be exported as Chrome trace JSON. See `lv_prof.h`*/
+#define LV_USE_PROF     0
+#if LV_USE_PROF
+/*Number of events kept in the event buffer (32 bytes each)*/
+#  define LV_PROF_EVENT_CNT     1024
+
+/*Number of frames whose statistics are kept*/
+#  define LV_PROF_FRAME_CNT     16
+
+/*1: Use a custom time source. 0: use `clock_gettime()` if available, else `lv_tick_get()`*/
+#  define LV_PROF_TIME_CUSTOM   0
+#  if LV_PROF_TIME_CUSTOM
+#    define LV_PROF_TIME_CUSTOM_INCLUDE  "hal_timer.h"          /*Header for the time function*/
+#    define LV_PROF_TIME_CUSTOM_NS_EXPR  (hal_timer_get_ns())   /*Expression evaluating to the current time in ns*/
+#  endif
+#endif
+
+/*1: Don't draw the objects which are fully covered by an opaque sibling above them.
+ *   It relies on the `LV_DESIGN_COVER_CHK` result of the design functions*/
+#define LV_USE_OCCLUSION_CULLING    0
+
+/*1: Store the resolved style properties of the objects' parts in tables so that getting a property
+ *   again in the same state is a single indexed read. Uses about 200 bytes for every drawn part*/
+#define LV_USE_STYLE_RES_TABLE      0
+
+/*1: Render the parts of the invalidated areas in parallel on worker threads (requires POSIX threads).
+ *   Every worker renders into its own buffer (allocated with `lv_mem_alloc`) and the parts are flushed in order.
+ *   The design functions of custom widgets shouldn't modify the objects while drawing.*/
+#define LV_USE_REFR_THREADS     0
+#if LV_USE_REFR_THREADS
+/*Number of worker threads*/
+#  define LV_REFR_THREAD_CNT    4
+#endif
+
+/*1: Call `flush_cb` from a separate thread (requires POSIX threads) to render the next part while the previous is flushed.
+ *   The draw buffers (`buf1` and `buf2` or the buffers given to `lv_disp_buf_init_ring()`) are used as a ring.
+ *   `flush_cb` is called from the flush thread so it can do blocking (e.g. SPI or memcpy) transfers.
+ *   Not used with true double buffering (2 screen sized buffers)*/
+#define LV_USE_FLUSH_THREAD     0
+#if LV_USE_FLUSH_THREAD
+/*Max. number of draw buffers in a ring and max. number of buffers waiting for flushing*/
+#  define LV_DISP_BUF_RING_MAX  4
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #define LV_USE_API_EXTENSION_V6  1
 #define LV_USE_API_EXTENSION_V7  1
@@ -243,6 +318,15 @@ typedef void * lv_fs_drv_user_data_t;
  * LV_IMG_CACHE_DEF_SIZE must be >= 1 */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* Limit the memory used by the decoded images in the cache (in bytes).
+ * The least recently used images are closed if the limit is exceeded. 0: no limit */
+#define LV_IMG_CACHE_DEF_MAX_BYTES  0
+
+/* Buffer the rows of the image files read by the built-in image decoder (in bytes per opened image).
+ * The rows are read in strips of this size (or the whole image if it fits) instead of a read for every line.
+ * 0: seek and read every line in the file */
+#define LV_IMG_DECODER_FILE_BUF_SIZE    0
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -430,6 +514,16 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  */
 #define LV_USE_FONT_COMPRESSED 1
 
+/* Number of decompressed glyphs of compressed fonts to keep in an LRU cache
+ * (every rendering thread has its own cache).
+ * 0: decompress the glyphs every time they are drawn */
+#define LV_FONT_GLYPH_CACHE_CNT 0
+
+/* 1: Build tables on the first use of a font to find the glyph IDs of sparse character ranges
+ *    (e.g. CJK fonts) and the kerning values of kerning pairs without binary search.
+ *    Uses 128 bytes for every 64 code points in use and 1 kB for the kerning pairs of a font. */
+#define LV_USE_FONT_LOOKUP_TABLES 0
+
 /* Enable subpixel rendering */
 #define LV_USE_FONT_SUBPX 1
 #if LV_USE_FONT_SUBPX
@@ -605,6 +699,11 @@ typedef void * lv_obj_user_data_t;
 
 /*Container (dependencies: -*/
 #define LV_USE_CONT     1
+#if LV_USE_CONT
+/*Refresh the layouts and auto-fits of the changed containers in one pass before the next screen refresh
+ *instead of on every change. Call `lv_layout_flush()` to get the new coordinates earlier*/
+#  define LV_CONT_LAYOUT_DEFER    0
+#endif
 
 /*Color picker (dependencies: -*/
 #define LV_USE_CPICKER   1
@@ -646,6 +745,10 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Store the line breaks of the text in labels (6 bytes per line) to avoid measuring the text on every redraw.
+ *Call `lv_label_refr_text()` if a static text is modified*/
+#  define LV_LABEL_LINE_CACHE             0
 #endif
 
 /*LED (dependencies: -)*/
@@ -675,6 +778,10 @@ typedef void * lv_obj_user_data_t;
  * 2: Best precision
  */
 #  define LV_LINEMETER_PRECISE    1
+
+/*Store the end points of the scale lines (16 bytes per line) to not calculate them on every redraw
+ *and refresh only the lines whose color changes when the value changes*/
+#  define LV_LINEMETER_SCALE_CACHE    0
 #endif
 
 /*Mask (dependencies: -)*/
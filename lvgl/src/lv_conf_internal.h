@@ -228,6 +228,16 @@
 #    define  LV_MEM_AUTO_DEFRAG  1
 #  endif
 #endif
+
+/* 1: Use a TLSF (two-level segregated fit) allocator. Allocation and free take constant time
+ * and the adjacent free cells are joined on free (`LV_MEM_AUTO_DEFRAG` is not used) */
+#ifndef LV_MEM_TLSF
+#  ifdef CONFIG_LV_MEM_TLSF
+#    define LV_MEM_TLSF CONFIG_LV_MEM_TLSF
+#  else
+#    define  LV_MEM_TLSF         0
+#  endif
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -262,6 +272,27 @@
 #  endif
 #endif
 
+/* 1: Allocate the objects and the `ext_attr` of the common widgets (cont, btn, label, img)
+ * from slabs of equally sized blocks. It reduces the fragmentation of the heap
+ * and the slabs are freed as a whole when a screen is deleted. */
+#ifndef LV_USE_OBJ_POOL
+#  ifdef CONFIG_LV_USE_OBJ_POOL
+#    define LV_USE_OBJ_POOL CONFIG_LV_USE_OBJ_POOL
+#  else
+#    define  LV_USE_OBJ_POOL         0
+#  endif
+#endif
+#if LV_USE_OBJ_POOL
+/* Number of blocks in a slab */
+#ifndef LV_OBJ_POOL_SLAB_CNT
+#  ifdef CONFIG_LV_OBJ_POOL_SLAB_CNT
+#    define LV_OBJ_POOL_SLAB_CNT CONFIG_LV_OBJ_POOL_SLAB_CNT
+#  else
+#    define  LV_OBJ_POOL_SLAB_CNT  16
+#  endif
+#endif
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -368,6 +399,16 @@
 #  endif
 #endif
 
+/* 1: Find the object under the pointer in a grid of the clickable objects of the screens and layers.
+ * The grid is rebuilt only after objects are created, deleted, moved, resized, hidden or made (non) clickable */
+#ifndef LV_INDEV_HIT_INDEX
+#  ifdef CONFIG_LV_INDEV_HIT_INDEX
+#    define LV_INDEV_HIT_INDEX CONFIG_LV_INDEV_HIT_INDEX
+#  else
+#    define  LV_INDEV_HIT_INDEX                0
+#  endif
+#endif
+
 /*==================
  * Feature usage
  *==================*/
@@ -398,7 +439,7 @@
 /* Allow buffering some shadow calculation
  * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
  * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+ * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost per cached shadow*/
 #ifndef LV_SHADOW_CACHE_SIZE
 #  ifdef CONFIG_LV_SHADOW_CACHE_SIZE
 #    define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -406,6 +447,27 @@
 #    define  LV_SHADOW_CACHE_SIZE    0
 #  endif
 #endif
+
+/* Number of different shadows (shadow width, spread and radius) to buffer.
+ * The least recently used shadow is dropped if a new one doesn't fit.
+ * Every rendering thread has its own cache. */
+#ifndef LV_SHADOW_CACHE_CNT
+#  ifdef CONFIG_LV_SHADOW_CACHE_CNT
+#    define LV_SHADOW_CACHE_CNT CONFIG_LV_SHADOW_CACHE_CNT
+#  else
+#    define  LV_SHADOW_CACHE_CNT     4
+#  endif
+#endif
+
+/* Limit the memory of the buffered shadows of a rendering thread (in bytes).
+ * 0: no limit (at most LV_SHADOW_CACHE_CNT * LV_SHADOW_CACHE_SIZE^2) */
+#ifndef LV_SHADOW_CACHE_MAX_BYTES
+#  ifdef CONFIG_LV_SHADOW_CACHE_MAX_BYTES
+#    define LV_SHADOW_CACHE_MAX_BYTES CONFIG_LV_SHADOW_CACHE_MAX_BYTES
+#  else
+#    define  LV_SHADOW_CACHE_MAX_BYTES 0
+#  endif
+#endif
 #endif
 
 /*1: enable outline drawing on rectangles*/
@@ -529,6 +591,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/*1: Use SIMD (SSE2/AVX2 or NEON) in the software blending of RGB565 and ARGB8888 colors.
+ *   The instruction set is selected from the compiler's target flags (e.g. `-mavx2`)*/
+#ifndef LV_USE_GPU_SIMD
+#  ifdef CONFIG_LV_USE_GPU_SIMD
+#    define LV_USE_GPU_SIMD CONFIG_LV_USE_GPU_SIMD
+#  else
+#    define  LV_USE_GPU_SIMD         0
+#  endif
+#endif
+
 /* 1: Enable file system (might be required for images */
 #ifndef LV_USE_FILESYSTEM
 #  ifdef CONFIG_LV_USE_FILESYSTEM
@@ -559,6 +631,123 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/*1: Measure the time of the rendering stages (joining the areas, drawing the widgets, blending, masking, image decoding, flushing).
+ *   The times are summed up per frame and the events can be exported as Chrome trace JSON. See `lv_prof.h`*/
+#ifndef LV_USE_PROF
+#  ifdef CONFIG_LV_USE_PROF
+#    define LV_USE_PROF CONFIG_LV_USE_PROF
+#  else
+#    define  LV_USE_PROF     0
+#  endif
+#endif
+#if LV_USE_PROF
+/*Number of events kept in the event buffer (32 bytes each)*/
+#ifndef LV_PROF_EVENT_CNT
+#  ifdef CONFIG_LV_PROF_EVENT_CNT
+#    define LV_PROF_EVENT_CNT CONFIG_LV_PROF_EVENT_CNT
+#  else
+#    define  LV_PROF_EVENT_CNT     1024
+#  endif
+#endif
+
+/*Number of frames whose statistics are kept*/
+#ifndef LV_PROF_FRAME_CNT
+#  ifdef CONFIG_LV_PROF_FRAME_CNT
+#    define LV_PROF_FRAME_CNT CONFIG_LV_PROF_FRAME_CNT
+#  else
+#    define  LV_PROF_FRAME_CNT     16
+#  endif
+#endif
+
+/*1: Use a custom time source. 0: use `clock_gettime()` if available, else `lv_tick_get()`*/
+#ifndef LV_PROF_TIME_CUSTOM
+#  ifdef CONFIG_LV_PROF_TIME_CUSTOM
+#    define LV_PROF_TIME_CUSTOM CONFIG_LV_PROF_TIME_CUSTOM
+#  else
+#    define  LV_PROF_TIME_CUSTOM   0
+#  endif
+#endif
+#if LV_PROF_TIME_CUSTOM
+#ifndef LV_PROF_TIME_CUSTOM_INCLUDE
+#  ifdef CONFIG_LV_PROF_TIME_CUSTOM_INCLUDE
+#    define LV_PROF_TIME_CUSTOM_INCLUDE CONFIG_LV_PROF_TIME_CUSTOM_INCLUDE
+#  else
+#    define  LV_PROF_TIME_CUSTOM_INCLUDE  "hal_timer.h"          /*Header for the time function*/
+#  endif
+#endif
+#ifndef LV_PROF_TIME_CUSTOM_NS_EXPR
+#  ifdef CONFIG_LV_PROF_TIME_CUSTOM_NS_EXPR
+#    define LV_PROF_TIME_CUSTOM_NS_EXPR CONFIG_LV_PROF_TIME_CUSTOM_NS_EXPR
+#  else
+#    define  LV_PROF_TIME_CUSTOM_NS_EXPR  (hal_timer_get_ns())   /*Expression evaluating to the current time in ns*/
+#  endif
+#endif
+#endif
+#endif
+
+/*1: Don't draw the objects which are fully covered by an opaque sibling above them.
+ *   It relies on the `LV_DESIGN_COVER_CHK` result of the design functions*/
+#ifndef LV_USE_OCCLUSION_CULLING
+#  ifdef CONFIG_LV_USE_OCCLUSION_CULLING
+#    define LV_USE_OCCLUSION_CULLING CONFIG_LV_USE_OCCLUSION_CULLING
+#  else
+#    define  LV_USE_OCCLUSION_CULLING    0
+#  endif
+#endif
+
+/*1: Store the resolved style properties of the objects' parts in tables so that getting a property
+ *   again in the same state is a single indexed read. Uses about 200 bytes for every drawn part*/
+#ifndef LV_USE_STYLE_RES_TABLE
+#  ifdef CONFIG_LV_USE_STYLE_RES_TABLE
+#    define LV_USE_STYLE_RES_TABLE CONFIG_LV_USE_STYLE_RES_TABLE
+#  else
+#    define  LV_USE_STYLE_RES_TABLE      0
+#  endif
+#endif
+
+/*1: Render the parts of the invalidated areas in parallel on worker threads (requires POSIX threads).
+ *   Every worker renders into its own buffer (allocated with `lv_mem_alloc`) and the parts are flushed in order.
+ *   The design functions of custom widgets shouldn't modify the objects while drawing.*/
+#ifndef LV_USE_REFR_THREADS
+#  ifdef CONFIG_LV_USE_REFR_THREADS
+#    define LV_USE_REFR_THREADS CONFIG_LV_USE_REFR_THREADS
+#  else
+#    define  LV_USE_REFR_THREADS     0
+#  endif
+#endif
+#if LV_USE_REFR_THREADS
+/*Number of worker threads*/
+#ifndef LV_REFR_THREAD_CNT
+#  ifdef CONFIG_LV_REFR_THREAD_CNT
+#    define LV_REFR_THREAD_CNT CONFIG_LV_REFR_THREAD_CNT
+#  else
+#    define  LV_REFR_THREAD_CNT    4
+#  endif
+#endif
+#endif
+
+/*1: Call `flush_cb` from a separate thread (requires POSIX threads) to render the next part while the previous is flushed.
+ *   The draw buffers (`buf1` and `buf2` or the buffers given to `lv_disp_buf_init_ring()`) are used as a ring.
+ *   `flush_cb` is called from the flush thread so it can do blocking (e.g. SPI or memcpy) transfers.
+ *   Not used with true double buffering (2 screen sized buffers)*/
+#ifndef LV_USE_FLUSH_THREAD
+#  ifdef CONFIG_LV_USE_FLUSH_THREAD
+#    define LV_USE_FLUSH_THREAD CONFIG_LV_USE_FLUSH_THREAD
+#  else
+#    define  LV_USE_FLUSH_THREAD     0
+#  endif
+#endif
+#if LV_USE_FLUSH_THREAD
+/*Max. number of draw buffers in a ring and max. number of buffers waiting for flushing*/
+#ifndef LV_DISP_BUF_RING_MAX
+#  ifdef CONFIG_LV_DISP_BUF_RING_MAX
+#    define LV_DISP_BUF_RING_MAX CONFIG_LV_DISP_BUF_RING_MAX
+#  else
+#    define  LV_DISP_BUF_RING_MAX  4
+#  endif
+#endif
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #ifndef LV_USE_API_EXTENSION_V6
 #  ifdef CONFIG_LV_USE_API_EXTENSION_V6
@@ -611,6 +800,27 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Limit the memory used by the decoded images in the cache (in bytes).
+ * The least recently used images are closed if the limit is exceeded. 0: no limit */
+#ifndef LV_IMG_CACHE_DEF_MAX_BYTES
+#  ifdef CONFIG_LV_IMG_CACHE_DEF_MAX_BYTES
+#    define LV_IMG_CACHE_DEF_MAX_BYTES CONFIG_LV_IMG_CACHE_DEF_MAX_BYTES
+#  else
+#    define  LV_IMG_CACHE_DEF_MAX_BYTES  0
+#  endif
+#endif
+
+/* Buffer the rows of the image files read by the built-in image decoder (in bytes per opened image).
+ * The rows are read in strips of this size (or the whole image if it fits) instead of a read for every line.
+ * 0: seek and read every line in the file */
+#ifndef LV_IMG_DECODER_FILE_BUF_SIZE
+#  ifdef CONFIG_LV_IMG_DECODER_FILE_BUF_SIZE
+#    define LV_IMG_DECODER_FILE_BUF_SIZE CONFIG_LV_IMG_DECODER_FILE_BUF_SIZE
+#  else
+#    define  LV_IMG_DECODER_FILE_BUF_SIZE    0
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -1113,6 +1323,28 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Number of decompressed glyphs of compressed fonts to keep in an LRU cache
+ * (every rendering thread has its own cache).
+ * 0: decompress the glyphs every time they are drawn */
+#ifndef LV_FONT_GLYPH_CACHE_CNT
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_CNT
+#    define LV_FONT_GLYPH_CACHE_CNT CONFIG_LV_FONT_GLYPH_CACHE_CNT
+#  else
+#    define  LV_FONT_GLYPH_CACHE_CNT 0
+#  endif
+#endif
+
+/* 1: Build tables on the first use of a font to find the glyph IDs of sparse character ranges
+ *    (e.g. CJK fonts) and the kerning values of kerning pairs without binary search.
+ *    Uses 128 bytes for every 64 code points in use and 1 kB for the kerning pairs of a font. */
+#ifndef LV_USE_FONT_LOOKUP_TABLES
+#  ifdef CONFIG_LV_USE_FONT_LOOKUP_TABLES
+#    define LV_USE_FONT_LOOKUP_TABLES CONFIG_LV_USE_FONT_LOOKUP_TABLES
+#  else
+#    define  LV_USE_FONT_LOOKUP_TABLES 0
+#  endif
+#endif
+
 /* Enable subpixel rendering */
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1556,6 +1788,17 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_USE_CONT     1
 #  endif
 #endif
+#if LV_USE_CONT
+/*Refresh the layouts and auto-fits of the changed containers in one pass before the next screen refresh
+ *instead of on every change. Call `lv_layout_flush()` to get the new coordinates earlier*/
+#ifndef LV_CONT_LAYOUT_DEFER
+#  ifdef CONFIG_LV_CONT_LAYOUT_DEFER
+#    define LV_CONT_LAYOUT_DEFER CONFIG_LV_CONT_LAYOUT_DEFER
+#  else
+#    define  LV_CONT_LAYOUT_DEFER    0
+#  endif
+#endif
+#endif
 
 /*Color picker (dependencies: -*/
 #ifndef LV_USE_CPICKER
@@ -1675,6 +1918,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LABEL_LONG_TXT_HINT          0
 #  endif
 #endif
+
+/*Store the line breaks of the text in labels (6 bytes per line) to avoid measuring the text on every redraw.
+ *Call `lv_label_refr_text()` if a static text is modified*/
+#ifndef LV_LABEL_LINE_CACHE
+#  ifdef CONFIG_LV_LABEL_LINE_CACHE
+#    define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+#  else
+#    define  LV_LABEL_LINE_CACHE             0
+#  endif
+#endif
 #endif
 
 /*LED (dependencies: -)*/
@@ -1752,6 +2005,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LINEMETER_PRECISE    1
 #  endif
 #endif
+
+/*Store the end points of the scale lines (16 bytes per line) to not calculate them on every redraw
+ *and refresh only the lines whose color changes when the value changes*/
+#ifndef LV_LINEMETER_SCALE_CACHE
+#  ifdef CONFIG_LV_LINEMETER_SCALE_CACHE
+#    define LV_LINEMETER_SCALE_CACHE CONFIG_LV_LINEMETER_SCALE_CACHE
+#  else
+#    define  LV_LINEMETER_SCALE_CACHE    0
+#  endif
+#endif
 #endif
 
 /*Mask (dependencies: -)*/
@@ -15,6 +15,15 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_gc.h"
+
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    #include "../lv_widgets/lv_cont.h"
+#endif
+
+#if defined(LV_GC_INCLUDE)
+    #include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -24,10 +33,28 @@
     #warning "LV_INDEV_DRAG_THROW must be greater than 0"
 #endif
 
+#define HIT_INDEX_GRID  16  /*Number of columns and rows of cells in a hit-test index*/
+#define HIT_INDEX_CNT   4   /*Number of screens (and layers) to keep the index of*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_INDEV_HIT_INDEX
+/*The clickable objects of a screen sorted into the cells of a grid*/
+typedef struct {
+    lv_obj_t * root;        /*The indexed screen or layer*/
+    bool valid;             /*false: an object of `root` has changed since the index was built*/
+    lv_area_t grid_area;    /*Click area of `root`, divided into `HIT_INDEX_GRID` x `HIT_INDEX_GRID` cells*/
+    uint8_t * buf;          /*Stores `objs`, `areas` and `cell_objs`. Kept for the next build*/
+    size_t buf_size;        /*Size of `buf` in bytes*/
+    lv_obj_t ** objs;       /*The clickable objects in the order `lv_indev_search_obj` finds them*/
+    lv_area_t * areas;      /*Click areas of `objs` clipped to the click area of their ancestors*/
+    uint32_t * cell_objs;   /*Indexes into `objs` cell by cell*/
+    uint32_t cell_start[HIT_INDEX_GRID * HIT_INDEX_GRID + 1]; /*Start of the cells in `cell_objs`*/
+} lv_indev_hit_index_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -45,6 +72,16 @@ static void indev_drag_throw(lv_indev_proc_t * proc);
 static lv_obj_t * get_dragged_obj(lv_obj_t * obj);
 static void indev_gesture(lv_indev_proc_t * proc);
 static bool indev_reset_check(lv_indev_proc_t * proc);
+#if LV_INDEV_HIT_INDEX
+static lv_indev_hit_index_t * hit_index_get(lv_obj_t * root);
+static bool hit_index_build(lv_indev_hit_index_t * index);
+static bool hit_index_reserve(lv_indev_hit_index_t * index, size_t size);
+static void hit_index_collect(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * clip, uint32_t * cnt);
+static lv_obj_t * hit_index_search(const lv_indev_hit_index_t * index, lv_point_t * point);
+static void hit_index_get_area(const lv_obj_t * obj, lv_area_t * area);
+static inline uint32_t hit_index_cell_x(const lv_indev_hit_index_t * index, lv_coord_t x);
+static inline uint32_t hit_index_cell_y(const lv_indev_hit_index_t * index, lv_coord_t y);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -65,6 +102,10 @@ static lv_obj_t * indev_obj_act = NULL;
  */
 void _lv_indev_init(void)
 {
+#if LV_INDEV_HIT_INDEX
+    _lv_ll_init(&LV_GC_ROOT(_lv_indev_hit_index_ll), sizeof(lv_indev_hit_index_t));
+#endif
+
     lv_indev_reset(NULL, NULL); /*Reset all input devices*/
 }
 
@@ -87,6 +128,12 @@ void _lv_indev_read_task(lv_task_t * task)
     indev_proc_reset_query_handler(indev_act);
 
     if(indev_act->proc.disabled) return;
+
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    /*Search the objects on their new coordinates*/
+    lv_layout_flush();
+#endif
+
     bool more_to_read;
     do {
         /*Read the data*/
@@ -390,6 +437,27 @@ lv_task_t * lv_indev_get_read_task(lv_disp_t * indev)
     return indev->refr_task;
 }
 
+/**
+ * Mark the hit-test index of an object's screen outdated.
+ * Called when an object is created, deleted, moved, resized, hidden, or its click area or state changes.
+ * @param obj pointer to the changed object
+ */
+void _lv_indev_hit_index_invalidate(lv_obj_t * obj)
+{
+#if LV_INDEV_HIT_INDEX
+    lv_obj_t * root = lv_obj_get_screen(obj);
+    lv_indev_hit_index_t * index;
+    _LV_LL_READ(LV_GC_ROOT(_lv_indev_hit_index_ll), index) {
+        if(index->root == root) {
+            index->valid = false;
+            break;
+        }
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -1124,6 +1192,14 @@ static void indev_proc_reset_query_handler(lv_indev_t * indev)
  */
 lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
 {
+#if LV_INDEV_HIT_INDEX
+    /*Look up the objects of the screens and layers in their index*/
+    if(obj->parent == NULL && obj->adv_hittest == 0) {
+        lv_indev_hit_index_t * index = hit_index_get(obj);
+        if(index) return hit_index_search(index, point);
+    }
+#endif
+
     lv_obj_t * found_p = NULL;
 
     /*If the point is on this object check its children too*/
@@ -1555,3 +1631,250 @@ static bool indev_reset_check(lv_indev_proc_t * proc)
 
     return proc->reset_query ? true : false;
 }
+
+#if LV_INDEV_HIT_INDEX
+
+/**
+ * Get the up-to-date hit-test index of a screen. Build it if required.
+ * @param root pointer to a screen or layer
+ * @return pointer to the index or NULL if out of memory
+ */
+static lv_indev_hit_index_t * hit_index_get(lv_obj_t * root)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_indev_hit_index_ll);
+    lv_indev_hit_index_t * index;
+    uint32_t cnt = 0;
+    _LV_LL_READ(*ll, index) {
+        if(index->root == root) break;
+        cnt++;
+    }
+
+    if(index == NULL) {
+        /*Reuse the least recently used index if there are enough*/
+        if(cnt >= HIT_INDEX_CNT) {
+            index = _lv_ll_get_tail(ll);
+        }
+        else {
+            index = _lv_ll_ins_head(ll);
+            LV_ASSERT_MEM(index);
+            if(index == NULL) return NULL;
+            _lv_memset_00(index, sizeof(lv_indev_hit_index_t));
+        }
+        index->root = root;
+        index->valid = false;
+    }
+
+    /*Keep the most recently used index at the head*/
+    lv_indev_hit_index_t * head = _lv_ll_get_head(ll);
+    if(index != head) _lv_ll_move_before(ll, index, head);
+
+    if(index->valid == false) {
+        if(hit_index_build(index) == false) return NULL;
+    }
+
+    return index;
+}
+
+/**
+ * Collect the clickable objects of a screen and sort them into the cells of the grid
+ * @param index pointer to an index with `root` set
+ * @return true: ready; false: out of memory
+ */
+static bool hit_index_build(lv_indev_hit_index_t * index)
+{
+    index->objs = NULL;
+    index->areas = NULL;
+    index->cell_objs = NULL;
+    _lv_memset_00(index->cell_start, sizeof(index->cell_start));
+
+    hit_index_get_area(index->root, &index->grid_area);
+
+    /*Count the clickable objects first*/
+    uint32_t obj_cnt = 0;
+    hit_index_collect(index, index->root, &index->grid_area, &obj_cnt);
+    if(obj_cnt == 0) {
+        index->valid = true;
+        return true;
+    }
+
+    size_t objs_size = obj_cnt * (sizeof(lv_obj_t *) + sizeof(lv_area_t));
+    if(hit_index_reserve(index, objs_size) == false) return false;
+
+    index->objs = (lv_obj_t **)index->buf;
+    index->areas = (lv_area_t *)(index->buf + obj_cnt * sizeof(lv_obj_t *));
+    obj_cnt = 0;
+    hit_index_collect(index, index->root, &index->grid_area, &obj_cnt);
+
+    /*Count the objects of the cells*/
+    uint32_t i;
+    uint32_t x;
+    uint32_t y;
+    for(i = 0; i < obj_cnt; i++) {
+        uint32_t x1 = hit_index_cell_x(index, index->areas[i].x1);
+        uint32_t x2 = hit_index_cell_x(index, index->areas[i].x2);
+        uint32_t y1 = hit_index_cell_y(index, index->areas[i].y1);
+        uint32_t y2 = hit_index_cell_y(index, index->areas[i].y2);
+        for(y = y1; y <= y2; y++) {
+            for(x = x1; x <= x2; x++) {
+                index->cell_start[y * HIT_INDEX_GRID + x]++;
+            }
+        }
+    }
+
+    /*Get the end of the cells*/
+    uint32_t c;
+    for(c = 1; c < HIT_INDEX_GRID * HIT_INDEX_GRID; c++) index->cell_start[c] += index->cell_start[c - 1];
+    uint32_t cell_objs_cnt = index->cell_start[HIT_INDEX_GRID * HIT_INDEX_GRID - 1];
+    index->cell_start[HIT_INDEX_GRID * HIT_INDEX_GRID] = cell_objs_cnt;
+
+    if(hit_index_reserve(index, objs_size + cell_objs_cnt * sizeof(uint32_t)) == false) {
+        index->objs = NULL;
+        index->areas = NULL;
+        return false;
+    }
+    index->objs = (lv_obj_t **)index->buf;
+    index->areas = (lv_area_t *)(index->buf + obj_cnt * sizeof(lv_obj_t *));
+    index->cell_objs = (uint32_t *)(index->buf + objs_size);
+
+    /*Fill the cells from their end with the last objects first.
+     *This way the objects will be in the search order in every cell
+     *and `cell_start` will point to the start of the cells*/
+    i = obj_cnt;
+    while(i > 0) {
+        i--;
+        uint32_t x1 = hit_index_cell_x(index, index->areas[i].x1);
+        uint32_t x2 = hit_index_cell_x(index, index->areas[i].x2);
+        uint32_t y1 = hit_index_cell_y(index, index->areas[i].y1);
+        uint32_t y2 = hit_index_cell_y(index, index->areas[i].y2);
+        for(y = y1; y <= y2; y++) {
+            for(x = x1; x <= x2; x++) {
+                c = y * HIT_INDEX_GRID + x;
+                index->cell_start[c]--;
+                index->cell_objs[index->cell_start[c]] = i;
+            }
+        }
+    }
+
+    index->valid = true;
+    return true;
+}
+
+/**
+ * Make the buffer of an index at least a given size. The content of the buffer is kept.
+ * @param index pointer to an index
+ * @param size the required size in bytes
+ * @return true: ready; false: out of memory
+ */
+static bool hit_index_reserve(lv_indev_hit_index_t * index, size_t size)
+{
+    if(index->buf_size >= size) return true;
+
+    uint8_t * buf = lv_mem_realloc(index->buf, size);
+    LV_ASSERT_MEM(buf);
+    if(buf == NULL) return false;
+
+    index->buf = buf;
+    index->buf_size = size;
+    return true;
+}
+
+/**
+ * Collect the clickable objects of a tree in the order the recursive search would find them:
+ * the children from the top to the bottom first, then the object itself.
+ * @param index pointer to an index. Only count the objects if `objs == NULL`
+ * @param obj pointer to an object
+ * @param clip the click area of the parents. The object can't be found out of it
+ * @param cnt number of collected objects. Incremented by the newly collected objects
+ */
+static void hit_index_collect(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * clip, uint32_t * cnt)
+{
+    /*Nothing can be found on hidden objects*/
+    if(obj->hidden) return;
+
+    /*The area of advanced hit-testing is not known, test it in `hit_index_search`*/
+    lv_area_t area;
+    if(obj->adv_hittest) {
+        lv_area_copy(&area, clip);
+    }
+    else {
+        lv_area_t obj_area;
+        hit_index_get_area(obj, &obj_area);
+        if(_lv_area_intersect(&area, &obj_area, clip) == false) return;
+    }
+
+    lv_obj_t * child;
+    _LV_LL_READ(obj->child_ll, child) {
+        hit_index_collect(index, child, &area, cnt);
+    }
+
+    if(obj->click && (obj->state & LV_STATE_DISABLED) == 0) {
+        if(index->objs) {
+            index->objs[*cnt] = obj;
+            lv_area_copy(&index->areas[*cnt], &area);
+        }
+        (*cnt)++;
+    }
+}
+
+/**
+ * Find the topmost clickable object on a point using an index
+ * @param index pointer to an up-to-date index
+ * @param point pointer to a point
+ * @return pointer to the found object or NULL if there was no suitable object
+ */
+static lv_obj_t * hit_index_search(const lv_indev_hit_index_t * index, lv_point_t * point)
+{
+    if(_lv_area_is_point_on(&index->grid_area, point, 0) == false) return NULL;
+
+    uint32_t c = hit_index_cell_y(index, point->y) * HIT_INDEX_GRID + hit_index_cell_x(index, point->x);
+    uint32_t i;
+    for(i = index->cell_start[c]; i < index->cell_start[c + 1]; i++) {
+        uint32_t id = index->cell_objs[i];
+        if(_lv_area_is_point_on(&index->areas[id], point, 0) == false) continue;
+
+        /*The area is exact unless the object or an ancestor uses advanced hit-testing*/
+        lv_obj_t * obj = index->objs[id];
+        lv_obj_t * parent = obj;
+        while(parent != index->root) {
+            if(parent->adv_hittest && lv_obj_hittest(parent, point) == false) break;
+            parent = parent->parent;
+        }
+
+        if(parent == index->root) return obj;
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the area where an object can be clicked (without advanced hit-testing)
+ * @param obj pointer to an object
+ * @param area store the area here
+ */
+static void hit_index_get_area(const lv_obj_t * obj, lv_area_t * area)
+{
+    lv_area_copy(area, &obj->coords);
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    area->x1 -= obj->ext_click_pad_hor;
+    area->x2 += obj->ext_click_pad_hor;
+    area->y1 -= obj->ext_click_pad_ver;
+    area->y2 += obj->ext_click_pad_ver;
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    area->x1 -= obj->ext_click_pad.x1;
+    area->x2 += obj->ext_click_pad.x2;
+    area->y1 -= obj->ext_click_pad.y1;
+    area->y2 += obj->ext_click_pad.y2;
+#endif
+}
+
+static inline uint32_t hit_index_cell_x(const lv_indev_hit_index_t * index, lv_coord_t x)
+{
+    return ((int32_t)(x - index->grid_area.x1) * HIT_INDEX_GRID) / lv_area_get_width(&index->grid_area);
+}
+
+static inline uint32_t hit_index_cell_y(const lv_indev_hit_index_t * index, lv_coord_t y)
+{
+    return ((int32_t)(y - index->grid_area.y1) * HIT_INDEX_GRID) / lv_area_get_height(&index->grid_area);
+}
+
+#endif /*LV_INDEV_HIT_INDEX*/
@@ -40,6 +40,13 @@ void _lv_indev_init(void);
  */
 void _lv_indev_read_task(lv_task_t * task);
 
+/**
+ * Mark the hit-test index of an object's screen outdated.
+ * Called when an object is created, deleted, moved, resized, hidden, or its click area or state changes.
+ * @param obj pointer to the changed object
+ */
+void _lv_indev_hit_index_invalidate(lv_obj_t * obj);
+
 /**
  * Get the currently processed input device. Can be used in action functions too.
  * @return pointer to the currently processed input device or NULL if no input device processing
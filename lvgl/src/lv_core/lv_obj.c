@@ -21,6 +21,8 @@
 #include "../lv_misc/lv_gc.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_prof.h"
+#include "../lv_font/lv_font_fmt_txt.h"
 #include "../lv_hal/lv_hal.h"
 #include <stdint.h>
 #include <string.h>
@@ -45,6 +47,15 @@
     #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
 #endif
 
+#if LV_USE_OBJ_POOL || (LV_USE_CONT && LV_CONT_LAYOUT_DEFER)
+    #include "../lv_widgets/lv_cont.h"
+#endif
+#if LV_USE_OBJ_POOL
+    #include "../lv_widgets/lv_btn.h"
+    #include "../lv_widgets/lv_label.h"
+    #include "../lv_widgets/lv_img.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -52,6 +63,28 @@
 #define LV_OBJ_DEF_WIDTH    (LV_DPX(100))
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 
+#if LV_USE_OBJ_POOL
+    /*The first pool stores the objects, the others the `ext_attr` of some widgets*/
+    #define OBJ_POOL_NODE       0
+    #define OBJ_POOL_EXT_FIRST  1
+#endif
+
+#if LV_USE_STYLE_RES_TABLE
+    #define RES_TABLE_NA        0xFF
+
+    /*Number of the properties of each type*/
+    #define RES_TABLE_INT_CNT   62
+    #define RES_TABLE_COLOR_CNT 14
+    #define RES_TABLE_OPA_CNT   12
+    #define RES_TABLE_PTR_CNT   5
+
+    /*The first bit of each type in `style_res_table_t.valid`*/
+    #define RES_TABLE_INT_BIT   0
+    #define RES_TABLE_COLOR_BIT 64
+    #define RES_TABLE_OPA_BIT   80
+    #define RES_TABLE_PTR_BIT   96
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -109,6 +142,17 @@ typedef struct {
     uint32_t border_post : 1;
 } style_snapshot_t;
 
+#if LV_USE_STYLE_RES_TABLE
+/*The resolved values of the properties of a style list in the current state of the object*/
+typedef struct {
+    uint32_t valid[4];      /*1 bit for every property. See `RES_TABLE_..._BIT`*/
+    lv_style_int_t int_v[RES_TABLE_INT_CNT];
+    lv_color_t color_v[RES_TABLE_COLOR_CNT];
+    lv_opa_t opa_v[RES_TABLE_OPA_CNT];
+    const void * ptr_v[RES_TABLE_PTR_CNT];
+} style_res_table_t;
+#endif
+
 typedef enum {
     STYLE_COMPARE_SAME,
     STYLE_COMPARE_VISUAL_DIFF,
@@ -142,9 +186,25 @@ static void lv_event_mark_deleted(lv_obj_t * obj);
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
 static void lv_obj_del_async_cb(void * obj);
 static void obj_del_core(lv_obj_t * obj);
+#if LV_USE_OBJ_POOL
+static void obj_pool_init(void);
+static lv_mem_pool_t * ext_pool_get(uint32_t ext_size);
+static lv_mem_pool_t * ext_pool_find(const lv_obj_t * obj);
+static void ext_free(lv_obj_t * obj);
+#endif
 static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop);
 static void update_style_cache_children(lv_obj_t * obj);
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_style_int_t get_style_int_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_color_t get_style_color_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_opa_t get_style_opa_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static const void * get_style_ptr_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+#if LV_USE_STYLE_RES_TABLE
+static lv_style_list_t * res_table_get_list(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static style_res_table_t * res_table_write_start(lv_style_list_t * list);
+static void res_table_write_end(style_res_table_t * t, uint8_t bit);
+static void res_table_invalidate(lv_obj_t * obj, bool children);
+#endif
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot);
 static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, style_snapshot_t * shot2);
 
@@ -155,6 +215,29 @@ static bool lv_initialized = false;
 static lv_event_temp_data_t * event_temp_data_head;
 static const void * event_act_data;
 
+#if LV_USE_STYLE_RES_TABLE
+/*Index of the properties in the arrays of `style_res_table_t` by the ID of the property.
+ *The properties of each type are numbered in the order of their IDs.
+ *Update it if a property is added in `lv_style.h`*/
+#define NA RES_TABLE_NA
+static const uint8_t res_table_idx[] = {
+    NA,  0,  1,  2,  3,  4,  5,  6, NA, NA, NA, NA,  0, NA, NA, NA,    /*0x0.*/
+     7,  8,  9, 10, 11, 12, 13, 14, 15, NA, NA, NA, NA, NA, NA, NA,    /*0x1.*/
+    16, 17, 18, 19, NA, NA, NA, NA, NA,  0,  1, NA,  1, NA, NA, NA,    /*0x2.*/
+    20, 21, 22, 23, NA, NA, NA, NA, NA,  2, NA, NA,  2, NA, NA, NA,    /*0x3.*/
+    24, 25, 26, NA, NA, NA, NA, NA, NA,  3, NA, NA,  3, NA, NA, NA,    /*0x4.*/
+    27, 28, 29, 30, 31, NA, NA, NA, NA,  4, NA, NA,  4, NA, NA, NA,    /*0x5.*/
+    32, 33, NA, NA, NA, NA, NA, NA, NA,  5, NA, NA,  5,  6,  0, NA,    /*0x6.*/
+    34, 35, 36, 37, 38, 39, NA, NA, NA,  6, NA, NA,  7, NA,  1,  2,    /*0x7.*/
+    40, 41, 42, 43, NA, NA, NA, NA, NA,  7,  8,  9,  8, NA,  3, NA,    /*0x8.*/
+    44, 45, 46, 47, 48, NA, NA, NA, NA, 10, NA, NA,  9, NA, NA, NA,    /*0x9.*/
+    49, NA, NA, NA, NA, NA, NA, NA, NA, 11, NA, NA, 10, 11, NA, NA,    /*0xA.*/
+    50, 51, 52, 53, 54, 55, 56, 57, NA, NA, NA, NA, NA, NA,  4, NA,    /*0xB.*/
+    58, 59, 60, 61, NA, NA, NA, NA, NA, 12, 13, NA, NA, NA, NA, NA,    /*0xC.*/
+};
+#undef NA
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -192,6 +275,10 @@ void lv_init(void)
     _lv_group_init();
 #endif
 
+#if LV_USE_PROF
+    _lv_prof_init();
+#endif
+
 #if LV_USE_GPU_STM32_DMA2D
     /*Initialize DMA2D GPU*/
     lv_gpu_stm32_dma2d_init();
@@ -206,9 +293,17 @@ void lv_init(void)
 
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(lv_style_trans_t));
 
+#if LV_USE_OBJ_POOL
+    obj_pool_init();
+#endif
+
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
 
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    _lv_cont_layout_init();
+#endif
+
     lv_theme_t * th = LV_THEME_DEFAULT_INIT(LV_THEME_DEFAULT_COLOR_PRIMARY, LV_THEME_DEFAULT_COLOR_SECONDARY,
                                             LV_THEME_DEFAULT_FLAG,
                                             LV_THEME_DEFAULT_FONT_SMALL, LV_THEME_DEFAULT_FONT_NORMAL, LV_THEME_DEFAULT_FONT_SUBTITLE, LV_THEME_DEFAULT_FONT_TITLE);
@@ -243,6 +338,10 @@ void lv_init(void)
  */
 void lv_deinit(void)
 {
+#if LV_USE_FONT_LOOKUP_TABLES
+    _lv_font_fmt_txt_free_lookup_all();
+#endif
+    _lv_refr_deinit();
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -342,6 +441,9 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
 
 
     _lv_ll_init(&(new_obj->child_ll), sizeof(lv_obj_t));
+#if LV_USE_OBJ_POOL
+    _lv_ll_set_pool(&(new_obj->child_ll), &LV_GC_ROOT(_lv_obj_pool)[OBJ_POOL_NODE]);
+#endif
 
 
     new_obj->ext_draw_pad = 0;
@@ -388,6 +490,9 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
     new_obj->state = LV_STATE_DEFAULT;
 
     new_obj->ext_attr = NULL;
+#if LV_USE_OBJ_POOL
+    new_obj->ext_pool = 0;
+#endif
 
     lv_style_list_init(&new_obj->style_list);
     if(copy == NULL) {
@@ -457,6 +562,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         }
     }
 
+    _lv_indev_hit_index_invalidate(new_obj);
+
     /*Send a signal to the parent to notify it about the new child*/
     if(parent != NULL) {
         parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, new_obj);
@@ -496,6 +603,15 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
     if(par) {
         par->signal_cb(par, LV_SIGNAL_CHILD_CHG, NULL);
     }
+#if LV_USE_OBJ_POOL
+    /*A whole screen was deleted, so give back the emptied slabs to the heap*/
+    else {
+        uint32_t i;
+        for(i = 0; i < LV_OBJ_POOL_CNT; i++) {
+            _lv_mem_pool_trim(&LV_GC_ROOT(_lv_obj_pool)[i]);
+        }
+    }
+#endif
 
     /*Handle if the active screen was deleted*/
     if(act_scr_del)  {
@@ -676,6 +792,7 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     }
 
     lv_obj_invalidate(obj);
+    _lv_indev_hit_index_invalidate(obj);   /*The screen might change*/
 
     lv_obj_t * old_par = obj->parent;
     lv_point_t old_pos;
@@ -692,6 +809,12 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     _lv_ll_chg_list(&obj->parent->child_ll, &parent->child_ll, obj, true);
     obj->parent = parent;
+    _lv_indev_hit_index_invalidate(obj);
+
+#if LV_USE_STYLE_RES_TABLE
+    /*The inherited properties might be different*/
+    res_table_invalidate(obj, true);
+#endif
 
 
     if(new_base_dir != LV_BIDI_DIR_RTL) {
@@ -728,6 +851,7 @@ void lv_obj_move_foreground(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, true);
+    _lv_indev_hit_index_invalidate(obj);
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -751,6 +875,7 @@ void lv_obj_move_background(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, false);
+    _lv_indev_hit_index_invalidate(obj);
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -804,6 +929,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->coords.y2 += diff.y;
 
     refresh_children_position(obj, diff.x, diff.y);
+    _lv_indev_hit_index_invalidate(obj);
 
     /*Inform the object about its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_COORD_CHG, &ori);
@@ -871,6 +997,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
     else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+    _lv_indev_hit_index_invalidate(obj);
 
     /*Send a signal to the object with its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_COORD_CHG, &ori);
@@ -1178,6 +1305,8 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     (void)top;    /*Unused*/
     (void)bottom; /*Unused*/
 #endif
+
+    _lv_indev_hit_index_invalidate(obj);
 }
 
 /*---------------------
@@ -1372,8 +1501,12 @@ bool lv_obj_remove_style_local_prop(lv_obj_t * obj, uint8_t part, lv_style_prope
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
     lv_style_t * style = lv_obj_get_local_style(obj, part);
-    if(style) return lv_style_remove_prop(style, prop);
-    else return false;
+    if(style == NULL) return false;
+
+#if LV_USE_STYLE_RES_TABLE
+    res_table_invalidate(obj, true);
+#endif
+    return lv_style_remove_prop(style, prop);
 }
 
 /**
@@ -1511,6 +1644,7 @@ void lv_obj_set_hidden(lv_obj_t * obj, bool en)
     if(!obj->hidden) lv_obj_invalidate(obj); /*Invalidate when not hidden (hidden objects are ignored) */
 
     obj->hidden = en == false ? 0 : 1;
+    _lv_indev_hit_index_invalidate(obj);
 
     if(!obj->hidden) lv_obj_invalidate(obj); /*Invalidate when not hidden (hidden objects are ignored) */
 
@@ -1528,6 +1662,7 @@ void lv_obj_set_adv_hittest(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->adv_hittest = en == false ? 0 : 1;
+    _lv_indev_hit_index_invalidate(obj);
 }
 
 /**
@@ -1540,6 +1675,7 @@ void lv_obj_set_click(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->click = (en == true ? 1 : 0);
+    _lv_indev_hit_index_invalidate(obj);
 }
 
 /**
@@ -1740,6 +1876,13 @@ void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     obj->state = new_state;
 
+    /*Disabled objects can't be clicked*/
+    if((prev_state ^ new_state) & LV_STATE_DISABLED) _lv_indev_hit_index_invalidate(obj);
+
+#if LV_USE_STYLE_RES_TABLE
+    res_table_invalidate(obj, true);
+#endif
+
     if(cmp_res == STYLE_COMPARE_SAME) {
         return;
     }
@@ -2070,8 +2213,34 @@ void * lv_obj_allocate_ext_attr(lv_obj_t * obj, uint16_t ext_size)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+#if LV_USE_OBJ_POOL
+    lv_mem_pool_t * new_pool = ext_pool_get(ext_size);
+    lv_mem_pool_t * old_pool = ext_pool_find(obj);
+    if(new_pool != NULL && new_pool == old_pool) return obj->ext_attr;
+
+    void * new_ext;
+    if(new_pool == NULL && old_pool == NULL) {
+        new_ext = lv_mem_realloc(obj->ext_attr, ext_size);
+        if(new_ext == NULL) return NULL;
+    }
+    /*Move the ext. data to a pool or out of a pool*/
+    else {
+        if(new_pool) new_ext = _lv_mem_pool_alloc(new_pool);
+        else new_ext = lv_mem_alloc(ext_size);
+        if(new_ext == NULL) return NULL;
+
+        if(obj->ext_attr) {
+            uint32_t old_size = old_pool ? old_pool->blk_size : _lv_mem_get_size(obj->ext_attr);
+            _lv_memcpy(new_ext, obj->ext_attr, LV_MATH_MIN(old_size, ext_size));
+            ext_free(obj);
+        }
+    }
+
+    obj->ext_pool = new_pool ? new_pool - LV_GC_ROOT(_lv_obj_pool) : 0;
+#else
     void * new_ext = lv_mem_realloc(obj->ext_attr, ext_size);
     if(new_ext == NULL) return NULL;
+#endif
 
     obj->ext_attr = new_ext;
     return (void *)obj->ext_attr;
@@ -2583,119 +2752,25 @@ lv_style_list_t * lv_obj_get_style_list(const lv_obj_t * obj, uint8_t part)
  */
 lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_style_int_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_CLIP_CORNER:
-                    if(list->clip_corner_off) def = true;
-                    break;
-                case LV_STYLE_TEXT_LETTER_SPACE:
-                case LV_STYLE_TEXT_LINE_SPACE:
-                    if(list->text_space_zero) def = true;
-                    break;
-                case LV_STYLE_TRANSFORM_ANGLE:
-                case LV_STYLE_TRANSFORM_WIDTH:
-                case LV_STYLE_TRANSFORM_HEIGHT:
-                case LV_STYLE_TRANSFORM_ZOOM:
-                    if(list->transform_all_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_WIDTH:
-                    if(list->border_width_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_SIDE:
-                    if(list->border_side_full) def = true;
-                    break;
-                case LV_STYLE_BORDER_POST:
-                    if(list->border_post_off) def = true;
-                    break;
-                case LV_STYLE_OUTLINE_WIDTH:
-                    if(list->outline_width_zero) def = true;
-                    break;
-                case LV_STYLE_RADIUS:
-                    if(list->radius_zero) def = true;
-                    break;
-                case LV_STYLE_SHADOW_WIDTH:
-                    if(list->shadow_width_zero) def = true;
-                    break;
-                case LV_STYLE_PAD_TOP:
-                case LV_STYLE_PAD_BOTTOM:
-                case LV_STYLE_PAD_LEFT:
-                case LV_STYLE_PAD_RIGHT:
-                    if(list->pad_all_zero) def = true;
-                    break;
-                case LV_STYLE_MARGIN_TOP:
-                case LV_STYLE_MARGIN_BOTTOM:
-                case LV_STYLE_MARGIN_LEFT:
-                case LV_STYLE_MARGIN_RIGHT:
-                    if(list->margin_all_zero) def = true;
-                    break;
-                case LV_STYLE_BG_BLEND_MODE:
-                case LV_STYLE_BORDER_BLEND_MODE:
-                case LV_STYLE_IMAGE_BLEND_MODE:
-                case LV_STYLE_LINE_BLEND_MODE:
-                case LV_STYLE_OUTLINE_BLEND_MODE:
-                case LV_STYLE_PATTERN_BLEND_MODE:
-                case LV_STYLE_SHADOW_BLEND_MODE:
-                case LV_STYLE_TEXT_BLEND_MODE:
-                case LV_STYLE_VALUE_BLEND_MODE:
-                    if(list->blend_mode_all_normal) def = true;
-                    break;
-                case LV_STYLE_TEXT_DECOR:
-                    if(list->text_decor_none) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_int(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
+#if LV_USE_STYLE_RES_TABLE
+    lv_style_list_t * list = res_table_get_list(obj, part, prop);
+    if(list) {
+        style_res_table_t * t = list->res_table;
+        uint8_t idx = res_table_idx[prop & LV_STYLE_ID_MASK];
+        uint8_t bit = RES_TABLE_INT_BIT + idx;
+        if(t && (t->valid[bit >> 5] & ((uint32_t)1 << (bit & 0x1F)))) return t->int_v[idx];
+
+        lv_style_int_t value = get_style_int_core(obj, part, prop);
+        t = res_table_write_start(list);
+        if(t) {
+            t->int_v[idx] = value;
+            res_table_write_end(t, bit);
         }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BORDER_SIDE:
-            return LV_BORDER_SIDE_FULL;
-        case LV_STYLE_SIZE:
-            return LV_DPI / 20;
-        case LV_STYLE_SCALE_WIDTH:
-            return LV_DPI / 8;
-        case LV_STYLE_BG_GRAD_STOP:
-            return 255;
-        case LV_STYLE_TRANSFORM_ZOOM:
-            return LV_IMG_ZOOM_NONE;
+        return value;
     }
+#endif
 
-    return 0;
+    return get_style_int_core(obj, part, prop);
 }
 
 /**
@@ -2714,44 +2789,25 @@ lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_styl
  */
 lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_color_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_color(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
+#if LV_USE_STYLE_RES_TABLE
+    lv_style_list_t * list = res_table_get_list(obj, part, prop);
+    if(list) {
+        style_res_table_t * t = list->res_table;
+        uint8_t idx = res_table_idx[prop & LV_STYLE_ID_MASK];
+        uint8_t bit = RES_TABLE_COLOR_BIT + idx;
+        if(t && (t->valid[bit >> 5] & ((uint32_t)1 << (bit & 0x1F)))) return t->color_v[idx];
+
+        lv_color_t value = get_style_color_core(obj, part, prop);
+        t = res_table_write_start(list);
+        if(t) {
+            t->color_v[idx] = value;
+            res_table_write_end(t, bit);
         }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_COLOR:
-        case LV_STYLE_BG_GRAD_COLOR:
-            return LV_COLOR_WHITE;
+        return value;
     }
+#endif
 
-    return LV_COLOR_BLACK;
+    return get_style_color_core(obj, part, prop);
 }
 
 /**
@@ -2770,67 +2826,25 @@ lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_
  */
 lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_opa_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_OPA_SCALE:
-                    if(list->opa_scale_cover) def = true;
-                    break;
-                case LV_STYLE_BG_OPA:
-                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
-                    if(list->bg_opa_transp) def = true;
-                    break;
-                case LV_STYLE_IMAGE_RECOLOR_OPA:
-                    if(list->img_recolor_opa_transp) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_opa(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
+#if LV_USE_STYLE_RES_TABLE
+    lv_style_list_t * list = res_table_get_list(obj, part, prop);
+    if(list) {
+        style_res_table_t * t = list->res_table;
+        uint8_t idx = res_table_idx[prop & LV_STYLE_ID_MASK];
+        uint8_t bit = RES_TABLE_OPA_BIT + idx;
+        if(t && (t->valid[bit >> 5] & ((uint32_t)1 << (bit & 0x1F)))) return t->opa_v[idx];
+
+        lv_opa_t value = get_style_opa_core(obj, part, prop);
+        t = res_table_write_start(list);
+        if(t) {
+            t->opa_v[idx] = value;
+            res_table_write_end(t, bit);
         }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_OPA:
-        case LV_STYLE_IMAGE_RECOLOR_OPA:
-        case LV_STYLE_PATTERN_RECOLOR_OPA:
-            return LV_OPA_TRANSP;
+        return value;
     }
+#endif
 
-    return LV_OPA_COVER;
+    return get_style_opa_core(obj, part, prop);
 }
 
 /**
@@ -2849,68 +2863,25 @@ lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_prop
  */
 const void * _lv_obj_get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
+#if LV_USE_STYLE_RES_TABLE
+    lv_style_list_t * list = res_table_get_list(obj, part, prop);
+    if(list) {
+        style_res_table_t * t = list->res_table;
+        uint8_t idx = res_table_idx[prop & LV_STYLE_ID_MASK];
+        uint8_t bit = RES_TABLE_PTR_BIT + idx;
+        if(t && (t->valid[bit >> 5] & ((uint32_t)1 << (bit & 0x1F)))) return t->ptr_v[idx];
+
+        const void * value = get_style_ptr_core(obj, part, prop);
+        t = res_table_write_start(list);
+        if(t) {
+            t->ptr_v[idx] = value;
+            res_table_write_end(t, bit);
+        }
+        return value;
+    }
+#endif
 
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    const void * value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_VALUE_STR:
-                    if(list->value_txt_str) def = true;
-                    break;
-                case LV_STYLE_PATTERN_IMAGE:
-                    if(list->pattern_img_null) def = true;
-                    break;
-                case LV_STYLE_TEXT_FONT:
-                    if(list->text_font_normal) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_ptr(list, prop, &value_act);
-        if(res == LV_RES_OK)  return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_TEXT_FONT:
-        case LV_STYLE_VALUE_FONT:
-            return lv_theme_get_font_normal();
-#if LV_USE_ANIMATION
-        case LV_STYLE_TRANSITION_PATH:
-            return &lv_anim_path_def;
-#endif
-    }
-
-    return NULL;
+    return get_style_ptr_core(obj, part, prop);
 }
 
 /**
@@ -3808,6 +3779,7 @@ static void obj_del_core(lv_obj_t * obj)
     }
 
     lv_event_mark_deleted(obj);
+    _lv_indev_hit_index_invalidate(obj);
 
     /* Reset all input devices if the object to delete is used*/
     lv_indev_t * indev = lv_indev_get_next(NULL);
@@ -3833,19 +3805,100 @@ static void obj_del_core(lv_obj_t * obj)
 
     /*Remove the object from parent's children list*/
     lv_obj_t * par = lv_obj_get_parent(obj);
+    lv_ll_t * ll;
     if(par == NULL) { /*It is a screen*/
         lv_disp_t * d = lv_obj_get_disp(obj);
-        _lv_ll_remove(&d->scr_ll, obj);
+        ll = &d->scr_ll;
     }
     else {
-        _lv_ll_remove(&(par->child_ll), obj);
+        ll = &(par->child_ll);
     }
+    _lv_ll_remove(ll, obj);
 
     /*Delete the base objects*/
+#if LV_USE_OBJ_POOL
+    if(obj->ext_attr != NULL) ext_free(obj);
+#else
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
-    lv_mem_free(obj); /*Free the object itself*/
+#endif
+    _lv_ll_free_node(ll, obj); /*Free the object itself*/
+}
+
+#if LV_USE_OBJ_POOL
+/**
+ * Initialize the pool of the objects and the pools for the `ext_attr` of the common widgets
+ */
+static void obj_pool_init(void)
+{
+    lv_mem_pool_t * pools = LV_GC_ROOT(_lv_obj_pool);
+    _lv_memset_00(pools, sizeof(lv_obj_pool_arr_t));
+
+    _lv_ll_init_pool(&pools[OBJ_POOL_NODE], sizeof(lv_obj_t), LV_OBJ_POOL_SLAB_CNT);
+
+    /*The unused pools remain with 0 block count*/
+    uint32_t i = OBJ_POOL_EXT_FIRST;
+#if LV_USE_CONT
+    _lv_mem_pool_init(&pools[i], sizeof(lv_cont_ext_t), LV_OBJ_POOL_SLAB_CNT);
+    i++;
+#endif
+#if LV_USE_BTN
+    _lv_mem_pool_init(&pools[i], sizeof(lv_btn_ext_t), LV_OBJ_POOL_SLAB_CNT);
+    i++;
+#endif
+#if LV_USE_LABEL
+    _lv_mem_pool_init(&pools[i], sizeof(lv_label_ext_t), LV_OBJ_POOL_SLAB_CNT);
+    i++;
+#endif
+#if LV_USE_IMG
+    _lv_mem_pool_init(&pools[i], sizeof(lv_img_ext_t), LV_OBJ_POOL_SLAB_CNT);
+    i++;
+#endif
+    (void) i;   /*Unused if there are no such widgets*/
 }
 
+/**
+ * Get the `ext_attr` pool whose block size is the given size
+ * @param ext_size size of an `ext_attr`
+ * @return pointer to the pool or NULL if there is no pool with this size
+ */
+static lv_mem_pool_t * ext_pool_get(uint32_t ext_size)
+{
+    uint32_t i;
+    for(i = OBJ_POOL_EXT_FIRST; i < LV_OBJ_POOL_CNT; i++) {
+        lv_mem_pool_t * pool = &LV_GC_ROOT(_lv_obj_pool)[i];
+        if(pool->blk_cnt == 0) continue;
+
+        /*The blocks are aligned so don't use a pool for a slightly smaller size*/
+        if(pool->blk_size >= ext_size && pool->blk_size - ext_size < sizeof(void *)) return pool;
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the pool of an object's `ext_attr`
+ * @param obj pointer to an object
+ * @return pointer to the pool or NULL if `ext_attr` was allocated with `lv_mem_alloc` or it's NULL
+ */
+static lv_mem_pool_t * ext_pool_find(const lv_obj_t * obj)
+{
+    if(obj->ext_pool == 0) return NULL;
+
+    return &LV_GC_ROOT(_lv_obj_pool)[obj->ext_pool];
+}
+
+/**
+ * Free the `ext_attr` of an object allocated either from a pool or with `lv_mem_alloc`
+ * @param obj pointer to an object
+ */
+static void ext_free(lv_obj_t * obj)
+{
+    lv_mem_pool_t * pool = ext_pool_find(obj);
+    if(pool) _lv_mem_pool_free(pool, obj->ext_attr);
+    else lv_mem_free(obj->ext_attr);
+}
+#endif
+
 /**
  * Handle the drawing related tasks of the base objects.
  * @param obj pointer to an object
@@ -4140,6 +4193,11 @@ static void base_dir_refr_children(lv_obj_t * obj)
 static void obj_align_core(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, bool x_set, bool y_set,
                            lv_coord_t x_ofs, lv_coord_t y_ofs)
 {
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    /*Align to the refreshed sizes*/
+    lv_layout_flush();
+#endif
+
     lv_point_t new_pos;
     _lv_area_align(&base->coords, &obj->coords, align, &new_pos);
 
@@ -4160,6 +4218,11 @@ static void obj_align_core(lv_obj_t * obj, const lv_obj_t * base, lv_align_t ali
 static void obj_align_mid_core(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align,  bool x_set, bool y_set,
                                lv_coord_t x_ofs, lv_coord_t y_ofs)
 {
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    /*Align to the refreshed sizes*/
+    lv_layout_flush();
+#endif
+
     lv_coord_t new_x = lv_obj_get_x(obj);
     lv_coord_t new_y = lv_obj_get_y(obj);
 
@@ -4534,6 +4597,9 @@ static void trans_anim_ready_cb(lv_anim_t * a)
         lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
         lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
         lv_style_remove_prop(style_trans, tr->prop);
+#if LV_USE_STYLE_RES_TABLE
+        res_table_invalidate(tr->obj, true);
+#endif
     }
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
@@ -4637,6 +4703,15 @@ static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop)
 
     lv_style_list_t * list = lv_obj_get_style_list(obj, part);
 
+#if LV_USE_REFR_THREADS
+    /*The rendering threads can update the same list. One of them updates it, the others wait.*/
+    _lv_refr_draw_lock();
+    if(list->valid_cache) {
+        _lv_refr_draw_unlock();
+        return;
+    }
+#endif
+
     bool ignore_cache_ori = list->ignore_cache;
     list->ignore_cache = 1;
 
@@ -4711,6 +4786,10 @@ static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop)
 #endif
     list->ignore_cache = ignore_cache_ori;
     list->valid_cache = 1;
+
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_unlock();
+#endif
 }
 
 /**
@@ -4757,6 +4836,10 @@ static void update_style_cache_children(lv_obj_t * obj)
  */
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
+#if LV_USE_STYLE_RES_TABLE
+    res_table_invalidate(obj, prop == LV_STYLE_PROP_ALL || (prop & LV_STYLE_INHERIT_MASK));
+#endif
+
     if(style_prop_is_cacheble(prop) == false) return;
 
     for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
@@ -4779,6 +4862,409 @@ static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_proper
     }
 }
 
+/**
+ * Get a style property of a part of an object by checking its style lists and its parents
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get
+ * @return the value of the property or its default value
+ */
+static lv_style_int_t get_style_int_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_style_int_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_CLIP_CORNER:
+                    if(list->clip_corner_off) def = true;
+                    break;
+                case LV_STYLE_TEXT_LETTER_SPACE:
+                case LV_STYLE_TEXT_LINE_SPACE:
+                    if(list->text_space_zero) def = true;
+                    break;
+                case LV_STYLE_TRANSFORM_ANGLE:
+                case LV_STYLE_TRANSFORM_WIDTH:
+                case LV_STYLE_TRANSFORM_HEIGHT:
+                case LV_STYLE_TRANSFORM_ZOOM:
+                    if(list->transform_all_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_WIDTH:
+                    if(list->border_width_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_SIDE:
+                    if(list->border_side_full) def = true;
+                    break;
+                case LV_STYLE_BORDER_POST:
+                    if(list->border_post_off) def = true;
+                    break;
+                case LV_STYLE_OUTLINE_WIDTH:
+                    if(list->outline_width_zero) def = true;
+                    break;
+                case LV_STYLE_RADIUS:
+                    if(list->radius_zero) def = true;
+                    break;
+                case LV_STYLE_SHADOW_WIDTH:
+                    if(list->shadow_width_zero) def = true;
+                    break;
+                case LV_STYLE_PAD_TOP:
+                case LV_STYLE_PAD_BOTTOM:
+                case LV_STYLE_PAD_LEFT:
+                case LV_STYLE_PAD_RIGHT:
+                    if(list->pad_all_zero) def = true;
+                    break;
+                case LV_STYLE_MARGIN_TOP:
+                case LV_STYLE_MARGIN_BOTTOM:
+                case LV_STYLE_MARGIN_LEFT:
+                case LV_STYLE_MARGIN_RIGHT:
+                    if(list->margin_all_zero) def = true;
+                    break;
+                case LV_STYLE_BG_BLEND_MODE:
+                case LV_STYLE_BORDER_BLEND_MODE:
+                case LV_STYLE_IMAGE_BLEND_MODE:
+                case LV_STYLE_LINE_BLEND_MODE:
+                case LV_STYLE_OUTLINE_BLEND_MODE:
+                case LV_STYLE_PATTERN_BLEND_MODE:
+                case LV_STYLE_SHADOW_BLEND_MODE:
+                case LV_STYLE_TEXT_BLEND_MODE:
+                case LV_STYLE_VALUE_BLEND_MODE:
+                    if(list->blend_mode_all_normal) def = true;
+                    break;
+                case LV_STYLE_TEXT_DECOR:
+                    if(list->text_decor_none) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_int(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BORDER_SIDE:
+            return LV_BORDER_SIDE_FULL;
+        case LV_STYLE_SIZE:
+            return LV_DPI / 20;
+        case LV_STYLE_SCALE_WIDTH:
+            return LV_DPI / 8;
+        case LV_STYLE_BG_GRAD_STOP:
+            return 255;
+        case LV_STYLE_TRANSFORM_ZOOM:
+            return LV_IMG_ZOOM_NONE;
+    }
+
+    return 0;
+}
+
+/**
+ * Get a style property of a part of an object by checking its style lists and its parents
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get
+ * @return the value of the property or its default value
+ */
+static lv_color_t get_style_color_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_color_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_color(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+            return LV_COLOR_WHITE;
+    }
+
+    return LV_COLOR_BLACK;
+}
+
+/**
+ * Get a style property of a part of an object by checking its style lists and its parents
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get
+ * @return the value of the property or its default value
+ */
+static lv_opa_t get_style_opa_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_opa_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_OPA_SCALE:
+                    if(list->opa_scale_cover) def = true;
+                    break;
+                case LV_STYLE_BG_OPA:
+                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
+                    if(list->bg_opa_transp) def = true;
+                    break;
+                case LV_STYLE_IMAGE_RECOLOR_OPA:
+                    if(list->img_recolor_opa_transp) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_opa(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_OPA:
+        case LV_STYLE_IMAGE_RECOLOR_OPA:
+        case LV_STYLE_PATTERN_RECOLOR_OPA:
+            return LV_OPA_TRANSP;
+    }
+
+    return LV_OPA_COVER;
+}
+
+/**
+ * Get a style property of a part of an object by checking its style lists and its parents
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get
+ * @return the value of the property or its default value
+ */
+static const void * get_style_ptr_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    const void * value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_VALUE_STR:
+                    if(list->value_txt_str) def = true;
+                    break;
+                case LV_STYLE_PATTERN_IMAGE:
+                    if(list->pattern_img_null) def = true;
+                    break;
+                case LV_STYLE_TEXT_FONT:
+                    if(list->text_font_normal) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_ptr(list, prop, &value_act);
+        if(res == LV_RES_OK)  return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_VALUE_FONT:
+            return lv_theme_get_font_normal();
+#if LV_USE_ANIMATION
+        case LV_STYLE_TRANSITION_PATH:
+            return &lv_anim_path_def;
+#endif
+    }
+
+    return NULL;
+}
+
+#if LV_USE_STYLE_RES_TABLE
+
+/**
+ * Get the style list whose resolved property table can be used for a property
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get
+ * @return pointer to the style list or NULL if the table can't be used
+ */
+static lv_style_list_t * res_table_get_list(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    /*The state of the real parts is known only by the object*/
+    if(part >= _LV_OBJ_PART_REAL_LAST) return NULL;
+
+    uint8_t id = prop & LV_STYLE_ID_MASK;
+    if(id >= sizeof(res_table_idx) || res_table_idx[id] == RES_TABLE_NA) return NULL;
+
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+    if(list == NULL || list->ignore_cache || list->skip_trans) return NULL;
+
+    return list;
+}
+
+/**
+ * Prepare the resolved property table of a style list to store a value. Allocate it if required.
+ * With `LV_USE_REFR_THREADS` the table is locked until `res_table_write_end()`
+ * @param list pointer to a style list
+ * @return pointer to the table or NULL if out of memory
+ */
+static style_res_table_t * res_table_write_start(lv_style_list_t * list)
+{
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_lock();
+#endif
+
+    if(list->res_table == NULL) {
+        list->res_table = lv_mem_alloc(sizeof(style_res_table_t));
+        if(list->res_table) _lv_memset_00(list->res_table, sizeof(style_res_table_t));
+    }
+
+#if LV_USE_REFR_THREADS
+    if(list->res_table == NULL) _lv_refr_draw_unlock();
+#endif
+
+    return list->res_table;
+}
+
+/**
+ * Mark a value as valid in a resolved property table
+ * @param t pointer to a table returned by `res_table_write_start()`
+ * @param bit the bit of the property. See `RES_TABLE_..._BIT`
+ */
+static void res_table_write_end(style_res_table_t * t, uint8_t bit)
+{
+    t->valid[bit >> 5] |= (uint32_t)1 << (bit & 0x1F);
+
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_unlock();
+#endif
+}
+
+/**
+ * Invalidate the resolved property tables of an object's parts
+ * @param obj pointer to an object
+ * @param children true: invalidate the children's tables too (the inherited properties might have changed)
+ */
+static void res_table_invalidate(lv_obj_t * obj, bool children)
+{
+    uint8_t part;
+    for(part = 0; part < _LV_OBJ_PART_REAL_LAST; part++) {
+        lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+        if(list == NULL) break;
+        if(list->res_table) _lv_memset_00(list->res_table, sizeof(((style_res_table_t *)0)->valid));
+    }
+
+    if(children == false) return;
+
+    lv_obj_t * child = lv_obj_get_child(obj, NULL);
+    while(child) {
+        res_table_invalidate(child, true);
+        child = lv_obj_get_child(obj, child);
+    }
+}
+#endif
+
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot)
 {
     _lv_obj_disable_style_caching(obj, true);
@@ -230,6 +230,9 @@ typedef struct _lv_obj_t {
 
     lv_drag_dir_t drag_dir  : 3; /**<  Which directions the object can be dragged in */
     lv_bidi_dir_t base_dir  : 2; /**< Base direction of texts related to this object */
+#if LV_USE_OBJ_POOL
+    uint8_t ext_pool        : 3; /**< Index of the pool of `ext_attr` or 0 if it's allocated with `lv_mem_alloc`*/
+#endif
 
 #if LV_USE_GROUP != 0
     void * group_p;
@@ -15,6 +15,8 @@
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_thread.h"
+#include "../lv_misc/lv_prof.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_font/lv_font_fmt_txt.h"
 #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
@@ -23,6 +25,10 @@
     #include "../lv_widgets/lv_label.h"
 #endif
 
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    #include "../lv_widgets/lv_cont.h"
+#endif
+
 #if defined(LV_GC_INCLUDE)
     #include LV_GC_INCLUDE
 #endif /* LV_ENABLE_GC */
@@ -33,31 +39,112 @@
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+/*Max. number of opaque children of an object to consider as occluders*/
+#define OCCLUSION_COVER_MAX 8
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_REFR_THREADS
+enum {
+    REFR_WORKER_IDLE,   /*Waiting for a new band*/
+    REFR_WORKER_BUSY,   /*Rendering a band*/
+    REFR_WORKER_READY,  /*The band is rendered and waits for flushing*/
+    REFR_WORKER_EXIT,   /*The thread has to return*/
+};
+typedef uint8_t refr_worker_state_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_disp_t disp;     /*Copy of the display being refreshed with `driver.buffer` pointing to `vdb`*/
+    lv_disp_buf_t vdb;  /*The worker's own draw buffer. `vdb.area` is the band to render*/
+    lv_area_t area;     /*The invalidated area the band belongs to*/
+    volatile refr_worker_state_t state;
+    bool started;       /*The worker's thread is running*/
+} refr_worker_t;
+#endif
+
+#if LV_USE_OCCLUSION_CULLING
+typedef struct {
+    lv_area_t area;     /*The area covered by the child*/
+    uint32_t idx;       /*Index of the child from the top (0: the most top)*/
+} refr_cover_t;
+#endif
+
+#if LV_USE_FLUSH_THREAD
+typedef struct {
+    lv_disp_t * disp;
+    lv_area_t area;
+    void * buf;
+    bool last;          /*It's the last part of the refreshing*/
+} refr_flush_job_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static uint32_t lv_refr_get_merge_cost(const lv_area_t * a1_p, const lv_area_t * a2_p);
+static bool lv_refr_area_is_near(const lv_area_t * a1_p, const lv_area_t * a2_p);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+static void lv_refr_area_draw(const lv_area_t * area_p);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+#if LV_USE_OCCLUSION_CULLING
+    static uint32_t lv_refr_get_covers(lv_obj_t * obj, const lv_area_t * mask_p, refr_cover_t * covers,
+                                       uint32_t * cover_cnt);
+    static bool lv_refr_is_covered(const lv_area_t * area_p, const refr_cover_t * covers, uint32_t cover_cnt,
+                                   uint32_t idx);
+#endif
 static void lv_refr_vdb_flush(void);
+#if LV_USE_PROF
+    static const char * refr_get_obj_type_name(lv_obj_t * obj);
+#endif
+#if LV_USE_REFR_THREADS
+    static bool lv_refr_area_threads(const lv_area_t * area_p, lv_coord_t y2, lv_coord_t max_row);
+    static bool refr_workers_init(uint32_t buf_size);
+    static void refr_worker_flush(refr_worker_t * w);
+    static void * refr_worker_cb(void * p);
+#endif
+#if LV_USE_FLUSH_THREAD
+    static bool flush_queue_is_used(lv_disp_t * disp);
+    static void flush_queue_wait_free(lv_disp_t * disp);
+    static void flush_queue_wait_empty(lv_disp_t * disp);
+    static void flush_queue_push(lv_disp_t * disp, const lv_area_t * area, void * buf, bool last);
+    static void * flush_thread_cb(void * p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
-static lv_disp_t * disp_refr; /*Display being refreshed*/
+static LV_THREAD_LOCAL lv_disp_t * disp_refr; /*Display being refreshed*/
 #if LV_USE_PERF_MONITOR
     static uint32_t fps_sum_cnt;
     static uint32_t fps_sum_all;
 #endif
+#if LV_USE_REFR_THREADS
+    static refr_worker_t refr_workers[LV_REFR_THREAD_CNT];
+    static lv_mutex_t refr_mutex;   /*Protects the state of the workers*/
+    static lv_cond_t refr_cond;     /*Signaled when the state of a worker changes*/
+    static lv_mutex_t draw_mutex;   /*Serializes the drawing steps which are not thread safe*/
+    static bool refr_workers_started;
+    static bool refr_workers_failed;
+#endif
+#if LV_USE_FLUSH_THREAD
+    static refr_flush_job_t flush_queue[LV_DISP_BUF_RING_MAX];
+    static uint8_t flush_queue_head;
+    static uint8_t flush_queue_cnt;
+    static lv_mutex_t flush_mutex;  /*Protects the queue and the ring counters*/
+    static lv_cond_t flush_cond;    /*Signaled when a job is added or finished*/
+    static lv_thread_t flush_thread;
+    static bool flush_thread_started;
+    static bool flush_thread_failed;
+    static bool flush_thread_exit;
+#endif
 
 /**********************
  *      MACROS
@@ -72,7 +159,67 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
  */
 void _lv_refr_init(void)
 {
-    /*Nothing to do*/
+#if LV_USE_REFR_THREADS
+    /*The workers are started on the first refresh when the size of the draw buffer is known*/
+    if(_lv_mutex_init(&refr_mutex) != LV_RES_OK ||
+       _lv_mutex_init(&draw_mutex) != LV_RES_OK ||
+       _lv_cond_init(&refr_cond) != LV_RES_OK) {
+        LV_LOG_WARN("Can't initialize the rendering threads. Rendering on one thread.");
+        refr_workers_failed = true;
+    }
+#endif
+
+#if LV_USE_FLUSH_THREAD
+    /*The flush thread is started when it's used first*/
+    if(_lv_mutex_init(&flush_mutex) != LV_RES_OK || _lv_cond_init(&flush_cond) != LV_RES_OK) {
+        LV_LOG_WARN("Can't initialize the flush thread. Flushing from the refresh task.");
+        flush_thread_failed = true;
+    }
+#endif
+}
+
+/**
+ * Stop the rendering and flush threads and free their resources
+ */
+void _lv_refr_deinit(void)
+{
+#if LV_USE_REFR_THREADS
+    uint32_t i;
+    _lv_mutex_lock(&refr_mutex);
+    for(i = 0; i < LV_REFR_THREAD_CNT; i++) refr_workers[i].state = REFR_WORKER_EXIT;
+    _lv_cond_broadcast(&refr_cond);
+    _lv_mutex_unlock(&refr_mutex);
+
+    for(i = 0; i < LV_REFR_THREAD_CNT; i++) {
+        refr_worker_t * w = &refr_workers[i];
+        if(w->started) _lv_thread_join(&w->thread);
+        lv_mem_free(w->vdb.buf1);
+        _lv_memset_00(w, sizeof(refr_worker_t));
+    }
+
+    _lv_mutex_destroy(&refr_mutex);
+    _lv_mutex_destroy(&draw_mutex);
+    _lv_cond_destroy(&refr_cond);
+    refr_workers_started = false;
+    refr_workers_failed = false;
+#endif
+
+#if LV_USE_FLUSH_THREAD
+    if(flush_thread_started) {
+        /*The thread flushes the queued buffers before returning*/
+        _lv_mutex_lock(&flush_mutex);
+        flush_thread_exit = true;
+        _lv_cond_broadcast(&flush_cond);
+        _lv_mutex_unlock(&flush_mutex);
+        _lv_thread_join(&flush_thread);
+    }
+
+    _lv_mutex_destroy(&flush_mutex);
+    _lv_cond_destroy(&flush_cond);
+    flush_thread_started = false;
+    flush_thread_failed = false;
+    flush_thread_exit = false;
+#endif
 }
 
 /**
@@ -81,6 +228,7 @@ void _lv_refr_init(void)
  * can prevent the call of `lv_task_handler`. In this case if the the GUI is updated in the process
  * (e.g. progress bar) this function can be called when the screen should be updated.
  * @param disp pointer to display to refresh. NULL to refresh all displays.
+ * @note with `LV_USE_FLUSH_THREAD` it also waits until the rendered areas are flushed
  */
 void lv_refr_now(lv_disp_t * disp)
 {
@@ -90,12 +238,18 @@ void lv_refr_now(lv_disp_t * disp)
 
     if(disp) {
         _lv_disp_refr_task(disp->refr_task);
+#if LV_USE_FLUSH_THREAD
+        if(flush_queue_is_used(disp)) flush_queue_wait_empty(disp);
+#endif
     }
     else {
         lv_disp_t * d;
         d = lv_disp_get_next(NULL);
         while(d) {
             _lv_disp_refr_task(d->refr_task);
+#if LV_USE_FLUSH_THREAD
+            if(flush_queue_is_used(d)) flush_queue_wait_empty(d);
+#endif
             d = lv_disp_get_next(d);
         }
     }
@@ -133,21 +287,60 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(suc != false) {
         if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
 
+        disp->inv_stat.inv_cnt++;
+
         /*Save only if this area is not in one of the saved areas*/
         uint16_t i;
         for(i = 0; i < disp->inv_p; i++) {
-            if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
+            if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) {
+                disp->inv_stat.inv_skip_cnt++;
+                return;
+            }
         }
 
+        disp->inv_stat.px_inv += lv_area_get_size(&com_area);
+
         /*Save the area*/
         if(disp->inv_p < LV_INV_BUF_SIZE) {
             lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+            disp->inv_p++;
         }
-        else {   /*If no place for the area add the screen*/
-            disp->inv_p = 0;
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+        /* If there is no place for the area do the cheapest merge:
+         * join the new area into a saved area or join two saved areas and save the new area in the free place.
+         * The cost is the number of pixels which will be redrawn but weren't invalidated.*/
+        else {
+            uint16_t j;
+            uint16_t best_i = 0;
+            uint16_t best_j = 0;
+            uint32_t best_cost = UINT32_MAX;
+            for(i = 0; i < disp->inv_p; i++) {
+                uint32_t cost = lv_refr_get_merge_cost(&disp->inv_areas[i], &com_area);
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    best_i = i;
+                    best_j = i;
+                }
+
+                for(j = i + 1; j < disp->inv_p && best_cost > 0; j++) {
+                    cost = lv_refr_get_merge_cost(&disp->inv_areas[i], &disp->inv_areas[j]);
+                    if(cost < best_cost) {
+                        best_cost = cost;
+                        best_i = i;
+                        best_j = j;
+                    }
+                }
+            }
+
+            if(best_i == best_j) {
+                _lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], &com_area);
+            }
+            else {
+                _lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], &disp->inv_areas[best_j]);
+                lv_area_copy(&disp->inv_areas[best_j], &com_area);
+            }
+            disp->inv_stat.merge_cnt++;
         }
-        disp->inv_p++;
+
         lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
     }
 }
@@ -198,7 +391,23 @@ void _lv_disp_refr_task(lv_task_t * task)
         return;
     }
 
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    /*Refresh the changed layouts first because they invalidate the moved objects*/
+    lv_layout_flush();
+#endif
+
+#if LV_USE_PROF
+    /*Profile only the refreshes which draw something*/
+    bool prof_frame = disp_refr->inv_p != 0 ? true : false;
+    if(prof_frame) {
+        _lv_prof_start();   /*The frame*/
+        _lv_prof_start();   /*Joining the areas*/
+    }
+    lv_refr_join_area();
+    if(prof_frame) _lv_prof_end(LV_PROF_STAGE_INV_JOIN, NULL);
+#else
     lv_refr_join_area();
+#endif
 
     lv_refr_areas();
 
@@ -274,6 +483,10 @@ void _lv_disp_refr_task(lv_task_t * task)
         }
     }
 
+#if LV_USE_PROF
+    if(prof_frame) _lv_prof_end(LV_PROF_STAGE_REFR, NULL);
+#endif
+
     _lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
 
@@ -325,6 +538,86 @@ void _lv_disp_refr_task(lv_task_t * task)
     LV_LOG_TRACE("lv_refr_task: ready");
 }
 
+#if LV_USE_REFR_THREADS
+/**
+ * Lock the drawing steps which are not thread safe (e.g. image decoding and caching).
+ * Can be called recursively from the same thread.
+ */
+void _lv_refr_draw_lock(void)
+{
+    _lv_mutex_lock(&draw_mutex);
+}
+
+/**
+ * Unlock the drawing steps locked by `_lv_refr_draw_lock()`
+ */
+void _lv_refr_draw_unlock(void)
+{
+    _lv_mutex_unlock(&draw_mutex);
+}
+#endif
+
+/**
+ * Get the statistics of the invalidated and redrawn areas of a display
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param stat store the statistics here
+ */
+void lv_refr_get_inv_stat(lv_disp_t * disp, lv_disp_inv_stat_t * stat)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        _lv_memset_00(stat, sizeof(lv_disp_inv_stat_t));
+        return;
+    }
+
+    _lv_memcpy(stat, &disp->inv_stat, sizeof(lv_disp_inv_stat_t));
+}
+
+/**
+ * Reset the statistics of the invalidated and redrawn areas of a display
+ * @param disp pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_inv_stat(lv_disp_t * disp)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    _lv_memset_00(&disp->inv_stat, sizeof(lv_disp_inv_stat_t));
+}
+
+#if LV_USE_FLUSH_THREAD
+/**
+ * Get the statistics of the flush thread of a display
+ * @param disp pointer to a display
+ * @param stat store the statistics here
+ */
+void lv_refr_get_flush_stat(lv_disp_t * disp, lv_refr_flush_stat_t * stat)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    if(flush_thread_failed == false) _lv_mutex_lock(&flush_mutex);
+    stat->flush_cnt = vdb->flush_cnt;
+    stat->stall_cnt = vdb->stall_cnt;
+    stat->stall_time = vdb->stall_time;
+    if(flush_thread_failed == false) _lv_mutex_unlock(&flush_mutex);
+}
+
+/**
+ * Reset the statistics of the flush thread of a display
+ * @param disp pointer to a display
+ */
+void lv_refr_reset_flush_stat(lv_disp_t * disp)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    if(flush_thread_failed == false) _lv_mutex_lock(&flush_mutex);
+    vdb->flush_cnt = 0;
+    vdb->stall_cnt = 0;
+    vdb->stall_time = 0;
+    if(flush_thread_failed == false) _lv_mutex_unlock(&flush_mutex);
+}
+#endif
+
 #if LV_USE_PERF_MONITOR
 uint32_t lv_refr_get_fps_avg(void)
 {
@@ -344,32 +637,77 @@ static void lv_refr_join_area(void)
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+    bool joined;
+
+    /*A grown area might be joinable with the already checked areas too so repeat until there is no change*/
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
+                /*Check if the areas are on each other or next to each other*/
+                if(lv_refr_area_is_near(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
+                    continue;
+                }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+                _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+                /* Join two area if redrawing the joined area is not more pixels than redrawing both areas.
+                 * (The overlapping parts would be redrawn twice)*/
+                if(lv_area_get_size(&joined_area) <= (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
+                                                      lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    disp_refr->inv_stat.join_cnt++;
+                    joined = true;
+                }
             }
         }
+    } while(joined);
+}
+
+/**
+ * Get the cost of merging two areas into one: the number of pixels in the joined area
+ * which are not in any of the areas.
+ * @param a1_p pointer to an area
+ * @param a2_p pointer to an other area
+ * @return the number of extra pixels to redraw
+ */
+static uint32_t lv_refr_get_merge_cost(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    lv_area_t joined_area;
+    _lv_area_join(&joined_area, a1_p, a2_p);
+
+    uint32_t common_size = 0;
+    lv_area_t common_area;
+    if(_lv_area_intersect(&common_area, a1_p, a2_p)) common_size = lv_area_get_size(&common_area);
+
+    return lv_area_get_size(&joined_area) + common_size - lv_area_get_size(a1_p) - lv_area_get_size(a2_p);
+}
+
+/**
+ * Check if two areas are on each other or touch each other
+ * @param a1_p pointer to an area
+ * @param a2_p pointer to an other area
+ * @return true: the areas are on or next to each other
+ */
+static bool lv_refr_area_is_near(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    if((a1_p->x1 <= a2_p->x2 + 1) && (a1_p->x2 + 1 >= a2_p->x1) &&
+       (a1_p->y1 <= a2_p->y2 + 1) && (a1_p->y2 + 1 >= a2_p->y1)) {
+        return true;
+    }
+    else {
+        return false;
     }
 }
 
@@ -404,6 +742,8 @@ static void lv_refr_areas(void)
             lv_refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+            disp_refr->inv_stat.refr_cnt++;
+            disp_refr->inv_stat.px_refr += lv_area_get_size(&disp_refr->inv_areas[i]);
         }
     }
 }
@@ -467,6 +807,11 @@ static void lv_refr_area(const lv_area_t * area_p)
             }
         }
 
+#if LV_USE_REFR_THREADS
+        /*Render the bands parallel if possible*/
+        if(lv_refr_area_threads(area_p, y2, max_row)) return;
+#endif
+
         /*Always use the full row*/
         lv_coord_t row;
         lv_coord_t row_last = 0;
@@ -504,14 +849,40 @@ static void lv_refr_area_part(const lv_area_t * area_p)
 {
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
+    bool queued = false;
+#if LV_USE_FLUSH_THREAD
+    queued = flush_queue_is_used(disp_refr);
+    /*Wait until the next buffer of the ring is flushed*/
+    if(queued) flush_queue_wait_free(disp_refr);
+#endif
+
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
-    if(lv_disp_is_double_buf(disp_refr) == false) {
+    if(queued == false && lv_disp_is_double_buf(disp_refr) == false) {
         while(vdb->flushing) {
             if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
         }
     }
 
+    lv_refr_area_draw(area_p);
+
+    /* In true double buffered mode flush only once when all areas were rendered.
+     * In normal mode flush after every area */
+    if(lv_disp_is_true_double_buf(disp_refr) == false) {
+        lv_refr_vdb_flush();
+    }
+}
+
+/**
+ * Draw the objects of an area to the actual Virtual Display Buffer
+ * @param area_p pointer to an area to refresh
+ */
+static void lv_refr_area_draw(const lv_area_t * area_p)
+{
+    LV_PROF_START();
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -521,10 +892,12 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     _lv_area_intersect(&start_mask, area_p, &vdb->area);
 
     /*Get the most top object which is not covered by others*/
+    LV_PROF_START();
     top_act_scr = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
         top_prev_scr = lv_refr_get_top_obj(&start_mask, disp_refr->prev_scr);
     }
+    LV_PROF_END(LV_PROF_STAGE_TOP_OBJ, NULL);
 
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
@@ -575,11 +948,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
     lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
 
-    /* In true double buffered mode flush only once when all areas were rendered.
-     * In normal mode flush after every area */
-    if(lv_disp_is_true_double_buf(disp_refr) == false) {
-        lv_refr_vdb_flush();
-    }
+    LV_PROF_END(LV_PROF_STAGE_AREA, NULL);
 }
 
 /**
@@ -694,6 +1063,11 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 
     /*Draw the parent and its children only if they ore on 'mask_parent'*/
     if(union_ok != false) {
+#if LV_USE_PROF
+        /*Get the type before starting the measurement*/
+        const char * prof_name = lv_prof_is_enabled() ? refr_get_obj_type_name(obj) : NULL;
+#endif
+        LV_PROF_START();
 
         /* Redraw the object */
         if(obj->design_cb) obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
@@ -722,7 +1096,16 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
             lv_area_t mask_child; /*Mask from obj and its child*/
             lv_obj_t * child_p;
             lv_area_t child_area;
+#if LV_USE_OCCLUSION_CULLING
+            /*Find the opaque children to skip the children below them*/
+            refr_cover_t covers[OCCLUSION_COVER_MAX];
+            uint32_t cover_cnt = 0;
+            uint32_t child_idx = lv_refr_get_covers(obj, &obj_mask, covers, &cover_cnt);
+#endif
             _LV_LL_READ_BACK(obj->child_ll, child_p) {
+#if LV_USE_OCCLUSION_CULLING
+                child_idx--;
+#endif
                 lv_obj_get_coords(child_p, &child_area);
                 ext_size = child_p->ext_draw_pad;
                 child_area.x1 -= ext_size;
@@ -735,6 +1118,14 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 
                 /*If the parent and the child has common area then refresh the child */
                 if(union_ok) {
+#if LV_USE_OCCLUSION_CULLING
+                    /*Skip the child if a child above it covers it*/
+                    if(child_p->hidden == 0 && lv_refr_is_covered(&mask_child, covers, cover_cnt, child_idx)) {
+                        disp_refr->inv_stat.cull_cnt++;
+                        disp_refr->inv_stat.px_cull += lv_area_get_size(&mask_child);
+                        continue;
+                    }
+#endif
                     /*Refresh the next children*/
                     lv_refr_obj(child_p, &mask_child);
                 }
@@ -743,9 +1134,72 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 
         /* If all the children are redrawn make 'post draw' design */
         if(obj->design_cb) obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+
+        LV_PROF_END(LV_PROF_STAGE_DESIGN, prof_name);
     }
 }
 
+#if LV_USE_OCCLUSION_CULLING
+/**
+ * Collect the children of an object which fully cover their area with opaque content.
+ * @param obj pointer to an object whose children should be checked
+ * @param mask_p the children will be drawn only here
+ * @param covers store the covered areas here. Its size should be `OCCLUSION_COVER_MAX`.
+ * @param cover_cnt store the number of elements in `covers` here
+ * @return the number of children
+ */
+static uint32_t lv_refr_get_covers(lv_obj_t * obj, const lv_area_t * mask_p, refr_cover_t * covers,
+                                   uint32_t * cover_cnt)
+{
+    uint32_t idx = 0;
+    lv_obj_t * child_p;
+    lv_area_t cover_area;
+
+    /*Go from the most top child to the bottom*/
+    _LV_LL_READ(obj->child_ll, child_p) {
+        if(*cover_cnt < OCCLUSION_COVER_MAX && child_p->hidden == 0 && child_p->design_cb &&
+           _lv_area_intersect(&cover_area, mask_p, &child_p->coords)) {
+            lv_design_res_t design_res = child_p->design_cb(child_p, &cover_area, LV_DESIGN_COVER_CHK);
+#if LV_USE_OPA_SCALE
+            if(design_res == LV_DESIGN_RES_COVER &&
+               lv_obj_get_style_opa_scale(child_p, LV_OBJ_PART_MAIN) != LV_OPA_COVER) {
+                design_res = LV_DESIGN_RES_NOT_COVER;
+            }
+#endif
+            if(design_res == LV_DESIGN_RES_COVER) {
+                lv_area_copy(&covers[*cover_cnt].area, &cover_area);
+                covers[*cover_cnt].idx = idx;
+                (*cover_cnt)++;
+            }
+        }
+        idx++;
+    }
+
+    return idx;
+}
+
+/**
+ * Check if an area of a child is covered by a child above it
+ * @param area_p the area of the child to draw
+ * @param covers the covered areas from `lv_refr_get_covers`
+ * @param cover_cnt number of elements in `covers`
+ * @param idx index of the child from the top
+ * @return true: the child shouldn't be drawn
+ */
+static bool lv_refr_is_covered(const lv_area_t * area_p, const refr_cover_t * covers, uint32_t cover_cnt,
+                               uint32_t idx)
+{
+    uint32_t i;
+    for(i = 0; i < cover_cnt; i++) {
+        /*The covers are ordered from top to bottom*/
+        if(covers[i].idx >= idx) break;
+        if(_lv_area_is_in(area_p, &covers[i].area, 0)) return true;
+    }
+
+    return false;
+}
+#endif
+
 /**
  * Flush the content of the VDB
  */
@@ -753,6 +1207,21 @@ static void lv_refr_vdb_flush(void)
 {
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
+#if LV_USE_FLUSH_THREAD
+    if(flush_queue_is_used(disp_refr)) {
+        if(disp_refr->driver.gpu_wait_cb) disp_refr->driver.gpu_wait_cb(&disp_refr->driver);
+
+        bool last = disp_refr->driver.buffer->last_area && disp_refr->driver.buffer->last_part ? true : false;
+        flush_queue_push(disp_refr, &vdb->area, vdb->buf_act, last);
+
+        /*Continue with the next buffer of the ring*/
+        vdb->ring_act++;
+        if(vdb->ring_act >= vdb->ring_cnt) vdb->ring_act = 0;
+        vdb->buf_act = vdb->ring[vdb->ring_act];
+        return;
+    }
+#endif
+
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
     if(lv_disp_is_double_buf(disp_refr)) {
@@ -770,7 +1239,9 @@ static void lv_refr_vdb_flush(void)
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     if(disp->driver.gpu_wait_cb) disp->driver.gpu_wait_cb(&disp->driver);
 
+    LV_PROF_START();
     if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, vdb->buf_act);
+    LV_PROF_END(LV_PROF_STAGE_FLUSH, NULL);
 
     if(vdb->buf1 && vdb->buf2) {
         if(vdb->buf_act == vdb->buf1)
@@ -779,3 +1250,358 @@ static void lv_refr_vdb_flush(void)
             vdb->buf_act = vdb->buf1;
     }
 }
+
+#if LV_USE_PROF
+/**
+ * Get the type of an object for the profiler
+ * @param obj pointer to an object
+ * @return the type's name, e.g. "lv_btn"
+ */
+static const char * refr_get_obj_type_name(lv_obj_t * obj)
+{
+    lv_obj_type_t type;
+    lv_obj_get_type(obj, &type);
+    return type.type[0] ? type.type[0] : "lv_obj";
+}
+#endif
+
+#if LV_USE_REFR_THREADS
+
+/**
+ * Render the bands of an area on the worker threads and flush them in order.
+ * @param area_p pointer to an area to refresh
+ * @param y2 the last row to refresh
+ * @param max_row max. height of a band
+ * @return true: the area is refreshed; false: the workers can't be used, refresh the area on this thread
+ */
+static bool lv_refr_area_threads(const lv_area_t * area_p, lv_coord_t y2, lv_coord_t max_row)
+{
+    /*`set_px_cb` would write the bands to the workers' buffers with the display buffer's layout*/
+    if(disp_refr->driver.set_px_cb) return false;
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    if(refr_workers_init(vdb->size) == false) return false;
+
+    /* The bands are given to the workers in round robin so the oldest band is always
+     * on the worker `flushed % LV_REFR_THREAD_CNT`*/
+    uint32_t started = 0;
+    uint32_t flushed = 0;
+    lv_coord_t row = area_p->y1;
+    while(row <= y2 || flushed < started) {
+        /*Start a new band if there is a free worker*/
+        if(row <= y2 && started - flushed < LV_REFR_THREAD_CNT) {
+            refr_worker_t * w = &refr_workers[started % LV_REFR_THREAD_CNT];
+
+            _lv_memcpy(&w->disp, disp_refr, sizeof(lv_disp_t));
+            w->disp.driver.buffer = &w->vdb;
+            w->disp.inv_stat.cull_cnt = 0;
+            w->disp.inv_stat.px_cull = 0;
+            lv_area_copy(&w->area, area_p);
+            w->vdb.area.x1 = area_p->x1;
+            w->vdb.area.x2 = area_p->x2;
+            w->vdb.area.y1 = row;
+            w->vdb.area.y2 = row + max_row - 1;
+            if(w->vdb.area.y2 > y2) w->vdb.area.y2 = y2;
+
+            _lv_mutex_lock(&refr_mutex);
+            w->state = REFR_WORKER_BUSY;
+            _lv_cond_broadcast(&refr_cond);
+            _lv_mutex_unlock(&refr_mutex);
+
+            row += max_row;
+            started++;
+            continue;
+        }
+
+        /*Flush the oldest band when it's ready*/
+        refr_worker_t * w = &refr_workers[flushed % LV_REFR_THREAD_CNT];
+        _lv_mutex_lock(&refr_mutex);
+        while(w->state != REFR_WORKER_READY) {
+            _lv_cond_wait(&refr_cond, &refr_mutex);
+        }
+        _lv_mutex_unlock(&refr_mutex);
+
+        /*Collect the statistics of the worker*/
+        disp_refr->inv_stat.cull_cnt += w->disp.inv_stat.cull_cnt;
+        disp_refr->inv_stat.px_cull += w->disp.inv_stat.px_cull;
+
+        if(w->vdb.area.y2 == y2) disp_refr->driver.buffer->last_part = 1;
+        refr_worker_flush(w);
+
+        _lv_mutex_lock(&refr_mutex);
+        w->state = REFR_WORKER_IDLE;
+        _lv_mutex_unlock(&refr_mutex);
+        flushed++;
+    }
+
+    return true;
+}
+
+/**
+ * Start the workers and (re)allocate their draw buffers if required
+ * @param buf_size size of the display's draw buffer in pixels
+ * @return true: the workers are ready to use
+ */
+static bool refr_workers_init(uint32_t buf_size)
+{
+    if(refr_workers_failed) return false;
+
+    uint32_t i;
+    for(i = 0; i < LV_REFR_THREAD_CNT; i++) {
+        refr_worker_t * w = &refr_workers[i];
+        if(w->vdb.size == buf_size) continue;
+
+        void * buf = lv_mem_realloc(w->vdb.buf1, buf_size * sizeof(lv_color_t));
+        if(buf == NULL) {
+            LV_LOG_WARN("Not enough memory for the rendering threads' buffers. Rendering on one thread.");
+            return false;
+        }
+        lv_disp_buf_init(&w->vdb, buf, NULL, buf_size);
+    }
+
+    if(refr_workers_started) return true;
+
+    for(i = 0; i < LV_REFR_THREAD_CNT; i++) {
+        if(refr_workers[i].started) continue;
+
+        refr_workers[i].state = REFR_WORKER_IDLE;
+        if(_lv_thread_create(&refr_workers[i].thread, refr_worker_cb, &refr_workers[i]) != LV_RES_OK) {
+            /*The already started workers stay idle*/
+            LV_LOG_WARN("Can't start the rendering threads. Rendering on one thread.");
+            refr_workers_failed = true;
+            return false;
+        }
+        refr_workers[i].started = true;
+    }
+
+    refr_workers_started = true;
+    return true;
+}
+
+/**
+ * Flush the band rendered by a worker and wait until it's flushed to make its buffer reusable
+ * @param w pointer to a worker whose band is ready
+ */
+static void refr_worker_flush(refr_worker_t * w)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+
+#if LV_USE_FLUSH_THREAD
+    if(flush_queue_is_used(disp_refr)) {
+        /*Flush on the flush thread and wait for it because the worker's buffer will be reused*/
+        bool last = vdb->last_area && vdb->last_part ? true : false;
+        flush_queue_push(disp_refr, &w->vdb.area, w->vdb.buf_act, last);
+        flush_queue_wait_empty(disp_refr);
+        return;
+    }
+#endif
+
+    /*The display's buffer is not used so wait for the previous flush in single buffered mode too*/
+    while(vdb->flushing) {
+        if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+    }
+
+    void * buf_act = vdb->buf_act;
+    lv_area_copy(&vdb->area, &w->vdb.area);
+    vdb->buf_act = w->vdb.buf_act;
+    lv_refr_vdb_flush();
+
+    while(vdb->flushing) {
+        if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+    }
+
+    vdb->buf_act = buf_act;
+}
+
+/**
+ * The rendering threads' function: render the given bands into the worker's own buffer
+ * @param p pointer to the worker (`refr_worker_t *`)
+ * @return NULL when `_lv_refr_deinit()` stops the worker
+ */
+static void * refr_worker_cb(void * p)
+{
+    refr_worker_t * w = p;
+
+#if LV_USE_PROF
+    _lv_prof_set_thread_id((uint8_t)(w - refr_workers) + 1);
+#endif
+
+    while(1) {
+        _lv_mutex_lock(&refr_mutex);
+        while(w->state != REFR_WORKER_BUSY && w->state != REFR_WORKER_EXIT) {
+            _lv_cond_wait(&refr_cond, &refr_mutex);
+        }
+        _lv_mutex_unlock(&refr_mutex);
+
+        if(w->state == REFR_WORKER_EXIT) break;
+
+        disp_refr = &w->disp;
+        lv_refr_area_draw(&w->area);
+
+        /*Free the temporal buffers of this thread like the refresh task does*/
+        _lv_mem_buf_free_all();
+        _lv_font_clean_up_fmt_txt();
+
+        _lv_mutex_lock(&refr_mutex);
+        w->state = REFR_WORKER_READY;
+        _lv_cond_broadcast(&refr_cond);
+        _lv_mutex_unlock(&refr_mutex);
+    }
+
+    return NULL;
+}
+
+#endif /*LV_USE_REFR_THREADS*/
+
+#if LV_USE_FLUSH_THREAD
+
+/**
+ * Tell whether a display's buffers are flushed on the flush thread. Start the thread if required.
+ * @param disp pointer to a display
+ * @return true: use the flush queue; false: flush from the refresh task
+ */
+static bool flush_queue_is_used(lv_disp_t * disp)
+{
+    if(flush_thread_failed) return false;
+    if(lv_disp_get_buf(disp)->ring_cnt == 0) return false;
+
+    /*With true double buffering the buffers are synchronized after flushing in the refresh task*/
+    if(lv_disp_is_true_double_buf(disp)) return false;
+
+    if(flush_thread_started == false) {
+        if(_lv_thread_create(&flush_thread, flush_thread_cb, NULL) != LV_RES_OK) {
+            LV_LOG_WARN("Can't start the flush thread. Flushing from the refresh task.");
+            flush_thread_failed = true;
+            return false;
+        }
+        flush_thread_started = true;
+    }
+
+    return true;
+}
+
+/**
+ * Wait until `buf_act` of a display is not queued for flushing anymore
+ * @param disp pointer to a display
+ */
+static void flush_queue_wait_free(lv_disp_t * disp)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    _lv_mutex_lock(&flush_mutex);
+    /*The buffers are flushed in order so `buf_act` is free if not all the buffers are queued*/
+    if(vdb->ring_queued >= vdb->ring_cnt) {
+        uint32_t t = lv_tick_get();
+        while(vdb->ring_queued >= vdb->ring_cnt) {
+            _lv_cond_wait(&flush_cond, &flush_mutex);
+        }
+        vdb->stall_cnt++;
+        vdb->stall_time += lv_tick_elaps(t);
+    }
+    _lv_mutex_unlock(&flush_mutex);
+}
+
+/**
+ * Wait until all the buffers of a display are flushed
+ * @param disp pointer to a display
+ */
+static void flush_queue_wait_empty(lv_disp_t * disp)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    _lv_mutex_lock(&flush_mutex);
+    while(vdb->ring_queued > 0) {
+        _lv_cond_wait(&flush_cond, &flush_mutex);
+    }
+    _lv_mutex_unlock(&flush_mutex);
+}
+
+/**
+ * Add a rendered buffer to the flush queue
+ * @param disp pointer to the display to flush
+ * @param area the area of the display to flush
+ * @param buf the rendered buffer
+ * @param last true: it's the last part of the refreshing
+ */
+static void flush_queue_push(lv_disp_t * disp, const lv_area_t * area, void * buf, bool last)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    _lv_mutex_lock(&flush_mutex);
+
+    /*The queue is shared by the displays so it can be full even if the display has free buffers*/
+    if(flush_queue_cnt >= LV_DISP_BUF_RING_MAX) {
+        uint32_t t = lv_tick_get();
+        while(flush_queue_cnt >= LV_DISP_BUF_RING_MAX) {
+            _lv_cond_wait(&flush_cond, &flush_mutex);
+        }
+        vdb->stall_cnt++;
+        vdb->stall_time += lv_tick_elaps(t);
+    }
+
+    refr_flush_job_t * job = &flush_queue[(flush_queue_head + flush_queue_cnt) % LV_DISP_BUF_RING_MAX];
+    job->disp = disp;
+    lv_area_copy(&job->area, area);
+    job->buf = buf;
+    job->last = last;
+    flush_queue_cnt++;
+    vdb->ring_queued++;
+
+    _lv_cond_broadcast(&flush_cond);
+    _lv_mutex_unlock(&flush_mutex);
+}
+
+/**
+ * The flush thread's function: call `flush_cb` with the queued buffers in order
+ * @param p unused
+ * @return NULL when `_lv_refr_deinit()` stops the thread
+ */
+static void * flush_thread_cb(void * p)
+{
+    LV_UNUSED(p);
+
+#if LV_USE_PROF
+    /*Use the last ID to not collide with the rendering threads*/
+    _lv_prof_set_thread_id(UINT8_MAX);
+#endif
+
+    while(1) {
+        _lv_mutex_lock(&flush_mutex);
+        while(flush_queue_cnt == 0 && flush_thread_exit == false) {
+            _lv_cond_wait(&flush_cond, &flush_mutex);
+        }
+        if(flush_queue_cnt == 0) {
+            _lv_mutex_unlock(&flush_mutex);
+            break;
+        }
+        refr_flush_job_t job = flush_queue[flush_queue_head];
+        _lv_mutex_unlock(&flush_mutex);
+
+        lv_disp_t * disp = job.disp;
+        lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+        vdb->buf_flushing = job.buf;
+        vdb->flushing_last = job.last ? 1 : 0;
+        vdb->flushing = 1;
+
+        LV_PROF_START();
+        if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &job.area, job.buf);
+
+        while(vdb->flushing) {
+            if(disp->driver.wait_cb) disp->driver.wait_cb(&disp->driver);
+        }
+        LV_PROF_END(LV_PROF_STAGE_FLUSH, NULL);
+        vdb->buf_flushing = NULL;
+
+        _lv_mutex_lock(&flush_mutex);
+        flush_queue_head = (flush_queue_head + 1) % LV_DISP_BUF_RING_MAX;
+        flush_queue_cnt--;
+        vdb->ring_queued--;
+        vdb->flush_cnt++;
+        _lv_cond_broadcast(&flush_cond);
+        _lv_mutex_unlock(&flush_mutex);
+    }
+
+    return NULL;
+}
+
+#endif /*LV_USE_FLUSH_THREAD*/
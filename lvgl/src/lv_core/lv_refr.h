@@ -26,6 +26,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_FLUSH_THREAD
+/**
+ * Statistics of the flush thread of a display
+ */
+typedef struct {
+    uint32_t flush_cnt;     /**< Number of buffers flushed on the flush thread*/
+    uint32_t stall_cnt;     /**< Number of times the renderer waited for a free buffer*/
+    uint32_t stall_time;    /**< Time [ms] the renderer waited for a free buffer*/
+} lv_refr_flush_stat_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -47,12 +58,18 @@ extern "C" {
  */
 void _lv_refr_init(void);
 
+/**
+ * Stop the rendering and flush threads and free their resources
+ */
+void _lv_refr_deinit(void);
+
 /**
  * Redraw the invalidated areas now.
  * Normally the redrawing is periodically executed in `lv_task_handler` but a long blocking process
  * can prevent the call of `lv_task_handler`. In this case if the the GUI is updated in the process
  * (e.g. progress bar) this function can be called when the screen should be updated.
  * @param disp pointer to display to refresh. NULL to refresh all displays.
+ * @note with `LV_USE_FLUSH_THREAD` it also waits until the rendered areas are flushed
  */
 void lv_refr_now(lv_disp_t * disp);
 
@@ -78,6 +95,47 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+#if LV_USE_REFR_THREADS
+/**
+ * Lock the drawing steps which are not thread safe (e.g. image decoding and caching).
+ * Can be called recursively from the same thread.
+ */
+void _lv_refr_draw_lock(void);
+
+/**
+ * Unlock the drawing steps locked by `_lv_refr_draw_lock()`
+ */
+void _lv_refr_draw_unlock(void);
+#endif
+
+/**
+ * Get the statistics of the invalidated and redrawn areas of a display
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param stat store the statistics here
+ */
+void lv_refr_get_inv_stat(lv_disp_t * disp, lv_disp_inv_stat_t * stat);
+
+/**
+ * Reset the statistics of the invalidated and redrawn areas of a display
+ * @param disp pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_inv_stat(lv_disp_t * disp);
+
+#if LV_USE_FLUSH_THREAD
+/**
+ * Get the statistics of the flush thread of a display
+ * @param disp pointer to a display
+ * @param stat store the statistics here
+ */
+void lv_refr_get_flush_stat(lv_disp_t * disp, lv_refr_flush_stat_t * stat);
+
+/**
+ * Reset the statistics of the flush thread of a display
+ * @param disp pointer to a display
+ */
+void lv_refr_reset_flush_stat(lv_disp_t * disp);
+#endif
+
 #if LV_USE_PERF_MONITOR
 /**
  * Get the average FPS since start up
@@ -42,6 +42,7 @@ static inline uint8_t get_style_prop_id(const lv_style_t * style, size_t idx);
 static inline uint8_t get_style_prop_attr(const lv_style_t * style, size_t idx);
 static inline size_t get_prop_size(uint8_t prop_id);
 static inline size_t get_next_prop_index(uint8_t prop_id, size_t id);
+static inline void res_table_free(lv_style_list_t * list);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -203,6 +204,8 @@ void _lv_style_list_add_style(lv_style_list_t * list, lv_style_t * style)
     /*Remove the style first if already exists*/
     _lv_style_list_remove_style(list, style);
 
+    res_table_free(list);
+
     lv_style_t ** new_classes;
     if(list->style_cnt == 0) new_classes = lv_mem_alloc(sizeof(lv_style_t *));
     else new_classes = lv_mem_realloc(list->style_list, sizeof(lv_style_t *) * (list->style_cnt + 1));
@@ -249,6 +252,8 @@ void _lv_style_list_remove_style(lv_style_list_t * list, lv_style_t * style)
     }
     if(found == false) return;
 
+    res_table_free(list);
+
     if(list->style_cnt == 1) {
         lv_mem_free(list->style_list);
         list->style_list = NULL;
@@ -305,6 +310,7 @@ void _lv_style_list_reset(lv_style_list_t * list)
     }
 
     if(list->style_cnt > 0) lv_mem_free(list->style_list);
+    res_table_free(list);
     list->style_list = NULL;
     list->style_cnt = 0;
     list->has_local = 0;
@@ -1197,3 +1203,17 @@ static inline size_t get_next_prop_index(uint8_t prop_id, size_t idx)
 {
     return idx + get_prop_size(prop_id);
 }
+
+/**
+ * Free the resolved property table of a style list because its styles have changed
+ * @param list pointer to a style list
+ */
+static inline void res_table_free(lv_style_list_t * list)
+{
+#if LV_USE_STYLE_RES_TABLE
+    lv_mem_free(list->res_table);
+    list->res_table = NULL;
+#else
+    LV_UNUSED(list);
+#endif
+}
@@ -221,6 +221,9 @@ typedef struct {
     lv_style_t ** style_list;
 #if LV_USE_ASSERT_STYLE
     uint32_t sentinel;
+#endif
+#if LV_USE_STYLE_RES_TABLE
+    void * res_table;       /*The resolved values of the properties in the current state. Managed by `lv_obj`*/
 #endif
     uint32_t style_cnt     : 6;
     uint32_t has_local     : 1;
@@ -10,6 +10,7 @@
 #include "lv_draw_rect.h"
 #include "lv_draw_mask.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -75,6 +76,8 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
     if(dsc->width == 0) return;
     if(start_angle == end_angle) return;
 
+    LV_PROF_START();
+
     lv_style_int_t width = dsc->width;
     if(width > radius) width = radius;
 
@@ -96,6 +99,7 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
     /*Draw a full ring*/
     if(start_angle + 360 == end_angle || start_angle == end_angle + 360) {
         lv_draw_rect(&area, clip_area, &cir_dsc);
+        LV_PROF_END(LV_PROF_STAGE_DRAW_ARC, NULL);
         return;
     }
 
@@ -166,6 +170,8 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
             lv_draw_rect(&round_area, clip_area, &cir_dsc);
         }
     }
+
+    LV_PROF_END(LV_PROF_STAGE_DRAW_ARC, NULL);
 }
 
 /**********************
@@ -11,6 +11,7 @@
 #include "../lv_misc/lv_math.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_prof.h"
 
 #if LV_USE_GPU_NXP_PXP
     #include "../lv_gpu/lv_gpu_nxp_pxp.h"
@@ -20,6 +21,8 @@
     #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
 #endif
 
+#include "../lv_gpu/lv_gpu_simd.h"
+
 /*********************
  *      DEFINES
  *********************/
@@ -153,6 +156,8 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
     is_common = _lv_area_intersect(&draw_area, clip_area, fill_area);
     if(!is_common) return;
 
+    LV_PROF_START();
+
     /* Now `draw_area` has absolute coordinates.
      * Make it relative to `disp_area` to simplify draw to `disp_buf`*/
     draw_area.x1 -= disp_area->x1;
@@ -183,6 +188,8 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
         fill_blended(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res, mode);
     }
 #endif
+
+    LV_PROF_END(LV_PROF_STAGE_BLEND_FILL, NULL);
 }
 
 /**
@@ -214,6 +221,8 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
     is_common = _lv_area_intersect(&draw_area, clip_area, map_area);
     if(!is_common) return;
 
+    LV_PROF_START();
+
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
     const lv_area_t * disp_area = &vdb->area;
@@ -250,6 +259,8 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
         map_blended(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res, mode);
     }
 #endif
+
+    LV_PROF_END(LV_PROF_STAGE_BLEND_MAP, NULL);
 }
 
 
@@ -360,6 +371,10 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
             }
 #endif
             /*Software rendering*/
+#if LV_GPU_SIMD_ENABLED
+            lv_gpu_simd_fill(disp_buf_first, disp_w, color, draw_area_w, draw_area_h);
+            return;
+#endif
             for(y = 0; y < draw_area_h; y++) {
                 lv_color_fill(disp_buf_first, color, draw_area_w);
                 disp_buf_first += disp_w;
@@ -411,6 +426,16 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 return;
             }
 #endif
+
+#if LV_GPU_SIMD_ENABLED
+#if LV_COLOR_SCREEN_TRANSP
+            if(disp->driver.screen_transp == 0)
+#endif
+            {
+                lv_gpu_simd_fill_opa(disp_buf_first, disp_w, color, opa, draw_area_w, draw_area_h);
+                return;
+            }
+#endif
             lv_color_t last_dest_color = LV_COLOR_BLACK;
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -450,6 +475,16 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
         }
 #endif
 
+#if LV_GPU_SIMD_ENABLED
+#if LV_COLOR_SCREEN_TRANSP
+        if(disp->driver.screen_transp == 0)
+#endif
+        {
+            lv_gpu_simd_fill_mask(disp_buf_first, disp_w, color, mask, opa, draw_area_w, draw_area_h);
+            return;
+        }
+#endif
+
 
         /*Buffer the result color to avoid recalculating the same color*/
         lv_color_t last_dest_color;
@@ -851,6 +886,15 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
 #endif
 
             /*Software rendering*/
+#if LV_GPU_SIMD_ENABLED
+#if LV_COLOR_SCREEN_TRANSP
+            if(disp->driver.screen_transp == 0)
+#endif
+            {
+                lv_gpu_simd_blend(disp_buf_first, disp_w, map_buf_first, map_w, opa, draw_area_w, draw_area_h);
+                return;
+            }
+#endif
 
             for(y = 0; y < draw_area_h; y++) {
                 for(x = 0; x < draw_area_w; x++) {
@@ -872,6 +916,16 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     }
     /*Masked*/
     else {
+#if LV_GPU_SIMD_ENABLED
+#if LV_COLOR_SCREEN_TRANSP
+        if(disp->driver.screen_transp == 0)
+#endif
+        {
+            lv_gpu_simd_blend_mask(disp_buf_first, disp_w, map_buf_first, map_w, mask, opa, draw_area_w, draw_area_h);
+            return;
+        }
+#endif
+
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             /*Go to the first pixel of the row */
@@ -12,12 +12,14 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_bidi.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_prof.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define LABEL_RECOLOR_PAR_LENGTH 6
 #define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
+#define LINES_FLAG_MASK (LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT) /*Flags affecting the line breaks*/
 
 /**********************
  *      TYPEDEFS
@@ -129,9 +131,22 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, mask);
     if(!clip_ok) return;
 
+    LV_PROF_START();
 
-    if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0) {
-        /*Normally use the label's width as width*/
+    int32_t line_height_font = lv_font_get_line_height(font);
+    int32_t line_height = line_height_font + dsc->line_space;
+
+    /*Use the stored line breaks if they belong to this text*/
+    const lv_draw_label_lines_t * lines = dsc->lines;
+    if(lines) {
+        if(line_height <= 0 || lines->line_cnt == 0 ||
+           !_lv_draw_label_lines_match(lines, txt, font, dsc->letter_space, lv_area_get_width(coords), dsc->flag)) {
+            lines = NULL;
+        }
+    }
+
+    if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0 || lines) {
+        /*Normally use the label's width as width. With EXPAND the lines are known if `lines` is set.*/
         w = lv_area_get_width(coords);
     }
     else {
@@ -142,9 +157,6 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         w = p.x;
     }
 
-    int32_t line_height_font = lv_font_get_line_height(font);
-    int32_t line_height = line_height_font + dsc->line_space;
-
     /*Init variables for the first line*/
     int32_t line_width = 0;
     lv_point_t pos;
@@ -159,6 +171,25 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
+    uint32_t line_end;
+    uint32_t line_id = 0;
+
+    /*Jump to the first visible line*/
+    if(lines) {
+        if(pos.y + line_height_font < mask->y1) {
+            line_id = (mask->y1 - pos.y - line_height_font + line_height - 1) / line_height;
+            if(line_id >= lines->line_cnt) {
+                LV_PROF_END(LV_PROF_STAGE_DRAW_LABEL, NULL);
+                return;
+            }
+            pos.y += line_id * line_height;
+        }
+        line_start = lines->line_start[line_id];
+        line_end = lines->line_start[line_id + 1];
+
+        /*The hint is not required*/
+        hint = NULL;
+    }
 
     /*Check the hint to use the cached info*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
@@ -175,10 +206,11 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    if(lines == NULL) line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w,
+                                                                         dsc->flag);
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < mask->y1) {
+    while(lines == NULL && pos.y + line_height_font < mask->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
@@ -191,19 +223,24 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
             hint->coord_y    = coords->y1;
         }
 
-        if(txt[line_start] == '\0') return;
+        if(txt[line_start] == '\0') {
+            LV_PROF_END(LV_PROF_STAGE_DRAW_LABEL, NULL);
+            return;
+        }
     }
 
     /*Align to middle*/
     if(dsc->flag & LV_TXT_FLAG_CENTER) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->line_w[line_id];
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->line_w[line_id];
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -358,33 +395,156 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        if(lines) {
+            line_id++;
+            if(line_id >= lines->line_cnt) break;
+            line_end = lines->line_start[line_id + 1];
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(dsc->flag & LV_TXT_FLAG_CENTER) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->line_w[line_id];
+            else line_width =
+                    _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->line_w[line_id];
+            else line_width =
+                    _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
         /*Go the next line position*/
         pos.y += line_height;
 
-        if(pos.y > mask->y2) return;
+        if(pos.y > mask->y2) break;
     }
 
+    LV_PROF_END(LV_PROF_STAGE_DRAW_LABEL, NULL);
+
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+/**
+ * Calculate and store the line breaks of a text
+ * @param lines pointer to a zero initialized or earlier built line table. Its arrays are reallocated if required.
+ * @param txt `\0` terminated text. It mustn't be changed while the table is used.
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the area of the text
+ * @param flag flags of the text, e.g. `LV_TXT_FLAG_RECOLOR`
+ * @return true: the lines are stored; false: out of memory and `lines` is invalid
+ */
+bool _lv_draw_label_lines_build(lv_draw_label_lines_t * lines, const char * txt, const lv_font_t * font,
+                                lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+    lines->txt = NULL;  /*Invalid until ready*/
+
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    while(1) {
+        /*Keep room for the end of the text too*/
+        if(line_cnt + 1 >= lines->line_cap) {
+            uint32_t new_cap = lines->line_cap ? lines->line_cap * 2 : 4;
+            uint32_t * new_start = lv_mem_realloc(lines->line_start, new_cap * sizeof(uint32_t));
+            if(new_start == NULL) {
+                _lv_draw_label_lines_free(lines);
+                return false;
+            }
+            lines->line_start = new_start;
+
+            lv_coord_t * new_w = lv_mem_realloc(lines->line_w, new_cap * sizeof(lv_coord_t));
+            if(new_w == NULL) {
+                _lv_draw_label_lines_free(lines);
+                return false;
+            }
+            lines->line_w = new_w;
+            lines->line_cap = new_cap;
+        }
+
+        lines->line_start[line_cnt] = line_start;
+        if(txt[line_start] == '\0') break;
+
+        uint32_t len = _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+        if(len == 0) break; /*Shouldn't happen but don't loop forever*/
+        lines->line_w[line_cnt] = _lv_txt_get_width(&txt[line_start], len, font, letter_space, flag);
+        line_start += len;
+        line_cnt++;
+    }
+
+    lines->line_start[line_cnt] = line_start;
+    lines->line_cnt = line_cnt;
+    lines->font = font;
+    lines->letter_space = letter_space;
+    lines->max_w = max_w;
+    lines->flag = flag & LINES_FLAG_MASK;
+    lines->txt = txt;
+
+    return true;
+}
+
+/**
+ * Tell whether a line table can be used with the given parameters
+ * @param lines pointer to a line table
+ * @param txt the text to draw or measure
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the area of the text
+ * @param flag flags of the text
+ * @return true: the line breaks are the same as in `lines`
+ */
+bool _lv_draw_label_lines_match(const lv_draw_label_lines_t * lines, const char * txt, const lv_font_t * font,
+                                lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+    if(lines->txt == NULL || lines->txt != txt) return false;
+    if(lines->font != font || lines->letter_space != letter_space) return false;
+    if(lines->flag != (flag & LINES_FLAG_MASK)) return false;
+
+    /*The width doesn't matter if only the new line characters break the lines*/
+    if((flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) == 0 && lines->max_w != max_w) return false;
+
+    return true;
+}
+
+/**
+ * Find the line of a byte in a line table
+ * @param lines pointer to a valid, not empty line table
+ * @param byte_id byte index in the text
+ * @return index of the line containing `byte_id`. The last line if `byte_id` is after the text.
+ */
+uint32_t _lv_draw_label_lines_find(const lv_draw_label_lines_t * lines, uint32_t byte_id)
+{
+    /*Binary search for the last line starting before `byte_id`*/
+    uint32_t first = 0;
+    uint32_t last = lines->line_cnt - 1;
+    while(first < last) {
+        uint32_t mid = (first + last + 1) / 2;
+        if(lines->line_start[mid] <= byte_id) first = mid;
+        else last = mid - 1;
+    }
+
+    return first;
+}
+
+/**
+ * Free the arrays of a line table and invalidate it
+ * @param lines pointer to a line table
+ */
+void _lv_draw_label_lines_free(lv_draw_label_lines_t * lines)
+{
+    if(lines->line_start) lv_mem_free(lines->line_start);
+    if(lines->line_w) lv_mem_free(lines->line_w);
+    _lv_memset_00(lines, sizeof(lv_draw_label_lines_t));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -490,9 +650,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    static LV_THREAD_LOCAL lv_opa_t opa_table[256];
+    static LV_THREAD_LOCAL lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static LV_THREAD_LOCAL uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
         if(prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
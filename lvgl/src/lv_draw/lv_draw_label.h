@@ -26,6 +26,21 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** Line breaks of a text calculated in advance (e.g. by a label when its text changes)
+ * to avoid measuring the whole text on every redraw.
+ * It's used only if the text, font, letter space, width and flags are the same as on building.*/
+typedef struct {
+    const char * txt;           /**< The text whose lines are stored. NULL if invalid.*/
+    const lv_font_t * font;
+    uint32_t * line_start;      /**< Byte index of the lines' start. `line_start[line_cnt]` is the length of the text*/
+    lv_coord_t * line_w;        /**< Width of the lines*/
+    uint32_t line_cnt;
+    uint32_t line_cap;          /**< Number of lines `line_start` and `line_w` are allocated for*/
+    lv_coord_t max_w;
+    lv_style_int_t letter_space;
+    lv_txt_flag_t flag;         /**< Only the flags affecting the line breaks*/
+} lv_draw_label_lines_t;
+
 typedef struct {
     lv_color_t color;
     lv_color_t sel_color;
@@ -42,6 +57,7 @@ typedef struct {
     lv_txt_flag_t flag;
     lv_text_decor_t decor;
     lv_blend_mode_t blend_mode;
+    const lv_draw_label_lines_t * lines; /**< Line breaks of the text or NULL to calculate them while drawing*/
 } lv_draw_label_dsc_t;
 
 /** Store some info to speed up drawing of very large texts
@@ -82,6 +98,46 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
                                          const lv_draw_label_dsc_t * dsc,
                                          const char * txt, lv_draw_label_hint_t * hint);
 
+/**
+ * Calculate and store the line breaks of a text
+ * @param lines pointer to a zero initialized or earlier built line table. Its arrays are reallocated if required.
+ * @param txt `\0` terminated text. It mustn't be changed while the table is used.
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the area of the text
+ * @param flag flags of the text, e.g. `LV_TXT_FLAG_RECOLOR`
+ * @return true: the lines are stored; false: out of memory and `lines` is invalid
+ */
+bool _lv_draw_label_lines_build(lv_draw_label_lines_t * lines, const char * txt, const lv_font_t * font,
+                                lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag);
+
+/**
+ * Tell whether a line table can be used with the given parameters
+ * @param lines pointer to a line table
+ * @param txt the text to draw or measure
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the area of the text
+ * @param flag flags of the text
+ * @return true: the line breaks are the same as in `lines`
+ */
+bool _lv_draw_label_lines_match(const lv_draw_label_lines_t * lines, const char * txt, const lv_font_t * font,
+                                lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag);
+
+/**
+ * Find the line of a byte in a line table
+ * @param lines pointer to a valid, not empty line table
+ * @param byte_id byte index in the text
+ * @return index of the line containing `byte_id`. The last line if `byte_id` is after the text.
+ */
+uint32_t _lv_draw_label_lines_find(const lv_draw_label_lines_t * lines, uint32_t byte_id);
+
+/**
+ * Free the arrays of a line table and invalidate it
+ * @param lines pointer to a line table
+ */
+void _lv_draw_label_lines_free(lv_draw_label_lines_t * lines);
+
 //! @endcond
 /***********************
  * GLOBAL VARIABLES
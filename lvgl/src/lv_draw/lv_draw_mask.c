@@ -11,6 +11,7 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_prof.h"
 
 #if defined(LV_GC_INCLUDE)
     #include LV_GC_INCLUDE
@@ -105,20 +106,29 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
                                                             lv_coord_t len)
 {
     bool changed = false;
+    bool transp = false;
     lv_draw_mask_common_dsc_t * dsc;
 
     _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
 
+    LV_PROF_START();
+
     while(m->param) {
         dsc = m->param;
         lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
         res = dsc->cb(mask_buf, abs_x, abs_y, len, (void *)m->param);
-        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+        if(res == LV_DRAW_MASK_RES_TRANSP) {
+            transp = true;
+            break;
+        }
         else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
 
         m++;
     }
 
+    LV_PROF_END(LV_PROF_STAGE_MASK, NULL);
+
+    if(transp) return LV_DRAW_MASK_RES_TRANSP;
     return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
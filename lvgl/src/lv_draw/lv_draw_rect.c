@@ -13,6 +13,12 @@
 #include "../lv_misc/lv_txt_ap.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_prof.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+    #include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -24,6 +30,29 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/*The parameters which determine the content of a shadow's corner*/
+typedef struct {
+    lv_coord_t size;        /*`shadow_width + radius`*/
+    lv_coord_t sw;
+    lv_coord_t spread;
+    lv_coord_t r;
+    lv_coord_t w;           /*Size of the shadow's rectangle. Larger sizes don't change the corner.*/
+    lv_coord_t h;
+} shadow_cache_key_t;
+
+typedef struct {
+    shadow_cache_key_t key;
+    lv_opa_t * buf;         /*NULL if the entry is unused*/
+    uint32_t last_use;
+} shadow_cache_entry_t;
+
+typedef struct {
+    shadow_cache_entry_t entries[LV_SHADOW_CACHE_CNT];
+    uint32_t use_cnt;
+    lv_draw_shadow_cache_stat_t stat;
+} shadow_cache_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -44,6 +73,13 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coord
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
 #endif
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    static shadow_cache_t * shadow_cache_get_act(void);
+    static const lv_opa_t * shadow_cache_find(const shadow_cache_key_t * key);
+    static void shadow_cache_add(const shadow_cache_key_t * key, const lv_opa_t * sh_buf);
+    static void shadow_cache_evict(shadow_cache_t * cache, shadow_cache_entry_t * e);
+#endif
+
 #if LV_USE_PATTERN
     static void draw_pattern(const lv_area_t * coords, const lv_area_t * clip, const lv_draw_rect_dsc_t * dsc);
 #endif
@@ -58,12 +94,6 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
-#endif
-
 /**********************
  *      MACROS
  **********************/
@@ -103,6 +133,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_rect_dsc_init(lv_draw_rect_dsc_t * dsc)
 void lv_draw_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_draw_rect_dsc_t * dsc)
 {
     if(lv_area_get_height(coords) < 1 || lv_area_get_width(coords) < 1) return;
+
+    LV_PROF_START();
+
 #if LV_USE_SHADOW
     draw_shadow(coords, clip, dsc);
 #endif
@@ -122,6 +155,8 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_dra
     draw_outline(coords, clip, dsc);
 #endif
 
+    LV_PROF_END(LV_PROF_STAGE_DRAW_RECT, NULL);
+
     LV_ASSERT_MEM_INTEGRITY();
 }
 
@@ -160,6 +195,52 @@ void lv_draw_px(const lv_point_t * point, const lv_area_t * clip_area, const lv_
     //    }
 }
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/**
+ * Free the cached shadows of the calling thread
+ */
+void lv_draw_shadow_cache_clear(void)
+{
+    shadow_cache_t * cache = LV_GC_ROOT(_lv_draw_shadow_cache);
+    if(cache == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < LV_SHADOW_CACHE_CNT; i++) {
+        if(cache->entries[i].buf) {
+            lv_mem_free(cache->entries[i].buf);
+            cache->entries[i].buf = NULL;
+        }
+    }
+
+    cache->stat.size = 0;
+    cache->stat.shadow_cnt = 0;
+}
+
+/**
+ * Get the statistics of the shadow cache of the calling thread
+ * @param stat store the statistics here
+ */
+void lv_draw_shadow_cache_get_stat(lv_draw_shadow_cache_stat_t * stat)
+{
+    shadow_cache_t * cache = LV_GC_ROOT(_lv_draw_shadow_cache);
+    if(cache) *stat = cache->stat;
+    else _lv_memset_00(stat, sizeof(lv_draw_shadow_cache_stat_t));
+}
+
+/**
+ * Reset the hit, miss and eviction counters of the shadow cache of the calling thread
+ */
+void lv_draw_shadow_cache_reset_stat(void)
+{
+    shadow_cache_t * cache = LV_GC_ROOT(_lv_draw_shadow_cache);
+    if(cache == NULL) return;
+
+    cache->stat.hit_cnt = 0;
+    cache->stat.miss_cnt = 0;
+    cache->stat.evict_cnt = 0;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -595,22 +676,25 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
+    shadow_cache_key_t key;
+    key.size = corner_size;
+    key.sw = sw;
+    key.spread = dsc->shadow_spread;
+    key.r = r_sh;
+    key.w = LV_MATH_MIN(lv_area_get_width(&sh_rect_area), 2 * corner_size);
+    key.h = LV_MATH_MIN(lv_area_get_height(&sh_rect_area), 2 * corner_size);
+
+    const lv_opa_t * cached = shadow_cache_find(&key);
+    if(cached) {
+        /*Copy the corner because it's mirrored in place below*/
         sh_buf = _lv_mem_buf_get(corner_size * corner_size);
-        _lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        _lv_memcpy(sh_buf, cached, corner_size * corner_size);
     }
     else {
         /*A larger buffer is required for calculation */
         sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if(corner_size * corner_size < sizeof(sh_cache)) {
-            _lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        shadow_cache_add(&key, sh_buf);
     }
 #else
     sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1152,6 +1236,127 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
 
 #endif
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+
+/**
+ * Get the shadow cache of the calling thread. Create it if required.
+ * @return pointer to the shadow cache or NULL if out of memory
+ */
+static shadow_cache_t * shadow_cache_get_act(void)
+{
+    shadow_cache_t * cache = LV_GC_ROOT(_lv_draw_shadow_cache);
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(shadow_cache_t));
+        LV_ASSERT_MEM(cache);
+        if(cache == NULL) return NULL;
+
+        _lv_memset_00(cache, sizeof(shadow_cache_t));
+        LV_GC_ROOT(_lv_draw_shadow_cache) = cache;
+    }
+
+    return cache;
+}
+
+/**
+ * Search a shadow's corner in the shadow cache of the calling thread
+ * @param key the parameters of the shadow
+ * @return the cached corner (`key->size * key->size` opacity values) or NULL if not found
+ */
+static const lv_opa_t * shadow_cache_find(const shadow_cache_key_t * key)
+{
+    if(key->size > LV_SHADOW_CACHE_SIZE) return NULL;
+
+    shadow_cache_t * cache = shadow_cache_get_act();
+    if(cache == NULL) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < LV_SHADOW_CACHE_CNT; i++) {
+        shadow_cache_entry_t * e = &cache->entries[i];
+        if(e->buf == NULL) continue;
+
+        if(e->key.size == key->size && e->key.sw == key->sw && e->key.spread == key->spread &&
+           e->key.r == key->r && e->key.w == key->w && e->key.h == key->h) {
+            cache->use_cnt++;
+            e->last_use = cache->use_cnt;
+            cache->stat.hit_cnt++;
+            return e->buf;
+        }
+    }
+
+    cache->stat.miss_cnt++;
+    return NULL;
+}
+
+/**
+ * Add a calculated corner to the shadow cache of the calling thread.
+ * The least recently used corners are evicted if there is no free entry or the memory limit is reached.
+ * @param key the parameters of the shadow
+ * @param sh_buf the corner calculated by `shadow_draw_corner_buf`
+ */
+static void shadow_cache_add(const shadow_cache_key_t * key, const lv_opa_t * sh_buf)
+{
+    if(key->size > LV_SHADOW_CACHE_SIZE) return;
+
+    uint32_t size = key->size * key->size;
+#if LV_SHADOW_CACHE_MAX_BYTES
+    if(size > LV_SHADOW_CACHE_MAX_BYTES) return;
+#endif
+
+    shadow_cache_t * cache = shadow_cache_get_act();
+    if(cache == NULL) return;
+
+    lv_opa_t * buf = NULL;
+    while(buf == NULL) {
+        bool fits = cache->stat.shadow_cnt < LV_SHADOW_CACHE_CNT;
+#if LV_SHADOW_CACHE_MAX_BYTES
+        if(cache->stat.size + size > LV_SHADOW_CACHE_MAX_BYTES) fits = false;
+#endif
+        if(fits) buf = lv_mem_alloc(size);
+        if(buf) break;
+
+        /*Make room by evicting the least recently used corner*/
+        shadow_cache_entry_t * lru = NULL;
+        uint32_t i;
+        for(i = 0; i < LV_SHADOW_CACHE_CNT; i++) {
+            shadow_cache_entry_t * e = &cache->entries[i];
+            if(e->buf && (lru == NULL || e->last_use < lru->last_use)) lru = e;
+        }
+        if(lru == NULL) return;
+        shadow_cache_evict(cache, lru);
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_SHADOW_CACHE_CNT; i++) {
+        shadow_cache_entry_t * e = &cache->entries[i];
+        if(e->buf == NULL) {
+            _lv_memcpy(buf, sh_buf, size);
+            e->buf = buf;
+            e->key = *key;
+            cache->use_cnt++;
+            e->last_use = cache->use_cnt;
+            cache->stat.size += size;
+            cache->stat.shadow_cnt++;
+            return;
+        }
+    }
+}
+
+/**
+ * Remove a corner from the shadow cache
+ * @param cache pointer to a shadow cache
+ * @param e the entry to free
+ */
+static void shadow_cache_evict(shadow_cache_t * cache, shadow_cache_entry_t * e)
+{
+    lv_mem_free(e->buf);
+    e->buf = NULL;
+    cache->stat.size -= e->key.size * e->key.size;
+    cache->stat.shadow_cnt--;
+    cache->stat.evict_cnt++;
+}
+
+#endif
+
 #if LV_USE_OUTLINE
 static void draw_outline(const lv_area_t * coords, const lv_area_t * clip, const lv_draw_rect_dsc_t * dsc)
 {
@@ -81,6 +81,17 @@ typedef struct {
     lv_blend_mode_t value_blend_mode;
 } lv_draw_rect_dsc_t;
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/** Statistics of the shadow cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< The shadow's corner was found in the cache*/
+    uint32_t miss_cnt;      /**< The shadow's corner was calculated*/
+    uint32_t evict_cnt;     /**< A corner was removed to make room for an other*/
+    uint32_t size;          /**< Size of the cached corners in bytes*/
+    uint16_t shadow_cnt;    /**< Number of cached corners*/
+} lv_draw_shadow_cache_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -105,6 +116,24 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_dra
  */
 void lv_draw_px(const lv_point_t * point, const lv_area_t * clip_area, const lv_style_t * style);
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/**
+ * Free the cached shadows of the calling thread
+ */
+void lv_draw_shadow_cache_clear(void);
+
+/**
+ * Get the statistics of the shadow cache of the calling thread
+ * @param stat store the statistics here
+ */
+void lv_draw_shadow_cache_get_stat(lv_draw_shadow_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and eviction counters of the shadow cache of the calling thread
+ */
+void lv_draw_shadow_cache_reset_stat(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
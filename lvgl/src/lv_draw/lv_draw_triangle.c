@@ -9,6 +9,7 @@
 #include "lv_draw_triangle.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -98,6 +99,9 @@ void lv_draw_polygon(const lv_point_t points[], uint16_t point_cnt, const lv_are
         _lv_mem_buf_release(p);
         return;
     }
+
+    LV_PROF_START();
+
     /*Find the lowest point*/
     lv_coord_t y_min = p[0].y;
     int16_t y_min_i = 0;
@@ -195,6 +199,7 @@ void lv_draw_polygon(const lv_point_t points[], uint16_t point_cnt, const lv_are
     _lv_mem_buf_release(mp);
     _lv_mem_buf_release(p);
 
+    LV_PROF_END(LV_PROF_STAGE_DRAW_POLYGON, NULL);
 }
 
 /**********************
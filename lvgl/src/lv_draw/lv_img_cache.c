@@ -19,15 +19,10 @@
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value in every open*/
-#define LV_IMG_CACHE_AGING 1
+#define IMG_CACHE_NONE  0xFFFF
 
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
-
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values */
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
+/*Look for the cheapest image to close among this many least recently used images*/
+#define IMG_CACHE_EVICT_CANDIDATES  4
 
 #if LV_IMG_CACHE_DEF_SIZE < 1
     #error "LV_IMG_CACHE_DEF_SIZE must be >= 1. See lv_conf.h"
@@ -40,15 +35,30 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static uint32_t src_hash(const void * src, lv_color_t color);
+static bool src_match(const lv_img_cache_entry_t * e, const void * src);
+static lv_img_cache_entry_t * find_victim(const lv_img_cache_entry_t * keep, bool used_only);
+static void entry_evict(lv_img_cache_entry_t * e);
+static uint32_t entry_get_size(const lv_img_cache_entry_t * e, const void * src);
+static void lru_unlink(uint16_t i);
+static void lru_ins_head(uint16_t i);
+static void lru_ins_tail(uint16_t i);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint16_t entry_cnt;
+static uint16_t * hash_buckets;     /*First entry of the buckets. Stored after the entries.*/
+static uint16_t bucket_mask;        /*Number of buckets - 1*/
+static uint16_t lru_head;           /*The most recently used entry. The empty entries are at the end*/
+static uint16_t lru_tail;
+static uint32_t max_bytes = LV_IMG_CACHE_DEF_MAX_BYTES;
+static lv_img_cache_stat_t stat;
 
 /**********************
  *      MACROS
  **********************/
+#define CACHE_ENTRY(i) (&LV_GC_ROOT(_lv_img_cache_array)[i])
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -69,81 +79,74 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
         return NULL;
     }
 
-    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
+    /*Is the image cached?*/
+    uint32_t hash = src_hash(src, color);
+    uint16_t * bucket = &hash_buckets[hash & bucket_mask];
     uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
+    for(i = *bucket; i != IMG_CACHE_NONE; i = CACHE_ENTRY(i)->hash_next) {
+        lv_img_cache_entry_t * e = CACHE_ENTRY(i);
+        if(e->hash != hash || !src_match(e, src)) continue;
+        if(e->dec_dsc.src_type == LV_IMG_SRC_VARIABLE && e->dec_dsc.color.full != color.full) continue;
+
+        if(lru_head != i) {
+            lru_unlink(i);
+            lru_ins_head(i);
         }
+        stat.hit_cnt++;
+        LV_LOG_TRACE("image draw: image found in the cache");
+        return e;
     }
 
-    /*Is the image cached?*/
-    lv_img_cache_entry_t * cached_src = NULL;
-    for(i = 0; i < entry_cnt; i++) {
-        bool match = false;
-        lv_img_src_t src_type = lv_img_src_get_type(cache[i].dec_dsc.src);
-        if(src_type == LV_IMG_SRC_VARIABLE) {
-            if(cache[i].dec_dsc.src == src && cache[i].dec_dsc.color.full == color.full) match = true;
-        }
-        else if(src_type == LV_IMG_SRC_FILE) {
-            if(strcmp(cache[i].dec_dsc.src, src) == 0) match = true;
-        }
+    /*The image is not cached then cache it now*/
+    stat.miss_cnt++;
+    lv_img_cache_entry_t * cached_src = find_victim(NULL, false);
 
-        if(match) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image draw: image found in the cache");
-            break;
-        }
+    /*Close the decoder to reuse if it was opened (has a valid source)*/
+    if(cached_src->dec_dsc.src) {
+        entry_evict(cached_src);
+        stat.evict_cnt++;
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    }
+    else {
+        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src == NULL) {
-        /*Find an entry to reuse. Select the entry with the least life*/
-        cached_src = &cache[0];
-        for(i = 1; i < entry_cnt; i++) {
-            if(cache[i].life < cached_src->life) {
-                cached_src = &cache[i];
-            }
-        }
+    /*Open the image and measure the time to open*/
+    uint32_t t_start;
+    t_start                          = lv_tick_get();
+    cached_src->dec_dsc.time_to_open = 0;
+    lv_res_t open_res                = lv_img_decoder_open(&cached_src->dec_dsc, src, color);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        lv_img_decoder_close(&cached_src->dec_dsc);
+        _lv_memset_00(&cached_src->dec_dsc, sizeof(lv_img_decoder_dsc_t));
+        return NULL;
+    }
 
-        /*Close the decoder to reuse if it was opened (has a valid source)*/
-        if(cached_src->dec_dsc.src) {
-            lv_img_decoder_close(&cached_src->dec_dsc);
-            LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-        }
-        else {
-            LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-        }
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(cached_src->dec_dsc.time_to_open == 0) {
+        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    }
 
-        /*Open the image and measure the time to open*/
-        uint32_t t_start;
-        t_start                          = lv_tick_get();
-        cached_src->dec_dsc.time_to_open = 0;
-        lv_res_t open_res                = lv_img_decoder_open(&cached_src->dec_dsc, src, color);
-        if(open_res == LV_RES_INV) {
-            LV_LOG_WARN("Image draw cannot open the image resource");
-            lv_img_decoder_close(&cached_src->dec_dsc);
-            _lv_memset_00(&cached_src->dec_dsc, sizeof(lv_img_decoder_dsc_t));
-            _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
-            cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
-            return NULL;
-        }
+    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
-        cached_src->life = 0;
+    i = (uint16_t)(cached_src - LV_GC_ROOT(_lv_img_cache_array));
+    cached_src->hash = hash;
+    cached_src->hash_next = *bucket;
+    *bucket = i;
+    lru_unlink(i);
+    lru_ins_head(i);
 
-        /*If `time_to_open` was not set in the open function set it here*/
-        if(cached_src->dec_dsc.time_to_open == 0) {
-            cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
-        }
+    cached_src->size = entry_get_size(cached_src, src);
+    stat.size += cached_src->size;
+    stat.entry_cnt++;
 
-        if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
+    /*Close other images if the new image made the cache too large*/
+    while(max_bytes && stat.size > max_bytes) {
+        lv_img_cache_entry_t * e = find_victim(cached_src, true);
+        if(e == NULL) break;
+        entry_evict(e);
+        stat.evict_cnt++;
     }
 
     return cached_src;
@@ -163,23 +166,72 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    /*Use about 2 buckets for every entry*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < (uint32_t)new_entry_cnt * 2 && bucket_cnt < 0x8000) bucket_cnt <<= 1;
+
+    /*Reallocate the cache. The hash buckets are stored after the entries*/
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * bucket_cnt);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
         return;
     }
     entry_cnt = new_entry_cnt;
+    hash_buckets = (uint16_t *)&LV_GC_ROOT(_lv_img_cache_array)[entry_cnt];
+    bucket_mask = (uint16_t)(bucket_cnt - 1);
 
     /*Clean the cache*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        _lv_memset_00(&LV_GC_ROOT(_lv_img_cache_array)[i].dec_dsc, sizeof(lv_img_decoder_dsc_t));
-        _lv_memset_00(&LV_GC_ROOT(_lv_img_cache_array)[i], sizeof(lv_img_cache_entry_t));
+    _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), sizeof(lv_img_cache_entry_t) * entry_cnt);
+    uint32_t i;
+    for(i = 0; i < bucket_cnt; i++) hash_buckets[i] = IMG_CACHE_NONE;
+
+    lru_head = IMG_CACHE_NONE;
+    lru_tail = IMG_CACHE_NONE;
+    for(i = 0; i < entry_cnt; i++) lru_ins_tail((uint16_t)i);
+
+    stat.size = 0;
+    stat.entry_cnt = 0;
+}
+
+/**
+ * Limit the memory used by the decoded images in the cache.
+ * The least recently used images are closed if the limit is exceeded.
+ * The last opened image is kept even if it's larger than the limit.
+ * @param new_max_bytes the maximal memory used by the cached images in bytes. 0: no limit
+ */
+void lv_img_cache_set_max_bytes(uint32_t new_max_bytes)
+{
+    max_bytes = new_max_bytes;
+
+    while(max_bytes && stat.size > max_bytes) {
+        lv_img_cache_entry_t * e = find_victim(NULL, true);
+        if(e == NULL) break;
+        entry_evict(e);
+        stat.evict_cnt++;
     }
 }
 
+/**
+ * Get the statistics of the image cache
+ * @param stat_out store the statistics here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat_out)
+{
+    *stat_out = stat;
+}
+
+/**
+ * Reset the hit, miss and eviction counters of the image cache
+ */
+void lv_img_cache_reset_stat(void)
+{
+    stat.hit_cnt = 0;
+    stat.miss_cnt = 0;
+    stat.evict_cnt = 0;
+}
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -187,18 +239,14 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
  */
 void lv_img_cache_invalidate_src(const void * src)
 {
-
-    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].dec_dsc.src == src || src == NULL) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+        lv_img_cache_entry_t * e = CACHE_ENTRY(i);
+        if(e->dec_dsc.src == NULL) continue;
 
-            _lv_memset_00(&cache[i].dec_dsc, sizeof(lv_img_decoder_dsc_t));
-            _lv_memset_00(&cache[i], sizeof(lv_img_cache_entry_t));
+        /*Invalidate the variables with every color*/
+        if(src == NULL || src_match(e, src)) {
+            entry_evict(e);
         }
     }
 }
@@ -206,3 +254,152 @@ void lv_img_cache_invalidate_src(const void * src)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Get the hash of an image source
+ * @param src an image source
+ * @param color the color of the image (used only for variables)
+ * @return the hash
+ */
+static uint32_t src_hash(const void * src, lv_color_t color)
+{
+    uint32_t h;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+        h = (uint32_t)((lv_uintptr_t)src >> 2) ^ (uint32_t)(color.full * 2654435761U);
+    }
+    else {
+        /*FNV-1a of the path or symbol*/
+        const uint8_t * s = src;
+        h = 2166136261U;
+        while(*s) {
+            h = (h ^ *s) * 16777619U;
+            s++;
+        }
+    }
+
+    return h ^ (h >> 16);
+}
+
+/**
+ * Tell whether a cache entry has the given source. The color is not compared.
+ * @param e pointer to a used cache entry
+ * @param src an image source
+ * @return true: the entry has the same source
+ */
+static bool src_match(const lv_img_cache_entry_t * e, const void * src)
+{
+    if(e->dec_dsc.src_type == LV_IMG_SRC_VARIABLE) return e->dec_dsc.src == src;
+
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) return false;
+    return strcmp(e->dec_dsc.src, src) == 0;
+}
+
+/**
+ * Find an entry to reuse. An empty entry if there is any, else the image with the smallest
+ * time to open among the least recently used images.
+ * @param keep don't select this entry (can be NULL)
+ * @param used_only true: skip the empty entries, e.g. to find an image to close to free memory
+ * @return pointer to an entry or NULL if there is no other (used) entry than `keep`
+ */
+static lv_img_cache_entry_t * find_victim(const lv_img_cache_entry_t * keep, bool used_only)
+{
+    lv_img_cache_entry_t * victim = NULL;
+    uint16_t cnt = 0;
+    uint16_t i = lru_tail;
+    while(i != IMG_CACHE_NONE && cnt < IMG_CACHE_EVICT_CANDIDATES) {
+        lv_img_cache_entry_t * e = CACHE_ENTRY(i);
+        i = e->lru_prev;
+        if(e == keep) continue;
+        if(e->dec_dsc.src == NULL) {
+            if(used_only) continue;
+            return e;
+        }
+
+        if(victim == NULL || e->dec_dsc.time_to_open < victim->dec_dsc.time_to_open) victim = e;
+        cnt++;
+    }
+
+    return victim;
+}
+
+/**
+ * Close the image of a cache entry and move it to the end of the LRU list
+ * @param e pointer to a used cache entry
+ */
+static void entry_evict(lv_img_cache_entry_t * e)
+{
+    uint16_t i = (uint16_t)(e - LV_GC_ROOT(_lv_img_cache_array));
+
+    uint16_t * link = &hash_buckets[e->hash & bucket_mask];
+    while(*link != IMG_CACHE_NONE && *link != i) link = &CACHE_ENTRY(*link)->hash_next;
+    if(*link == i) *link = e->hash_next;
+
+    lv_img_decoder_close(&e->dec_dsc);
+    _lv_memset_00(&e->dec_dsc, sizeof(lv_img_decoder_dsc_t));
+
+    stat.size -= e->size;
+    stat.entry_cnt--;
+    e->size = 0;
+
+    lru_unlink(i);
+    lru_ins_tail(i);
+}
+
+/**
+ * Get the memory used by the decoded image of an entry
+ * @param e pointer to a cache entry with an opened image
+ * @param src the source of the image
+ * @return the size in bytes
+ */
+static uint32_t entry_get_size(const lv_img_cache_entry_t * e, const void * src)
+{
+    /*The image is read line-by-line*/
+    if(e->dec_dsc.img_data == NULL) return 0;
+
+    /*The decoder uses the variable's data directly*/
+    if(e->dec_dsc.src_type == LV_IMG_SRC_VARIABLE && e->dec_dsc.img_data == ((const lv_img_dsc_t *)src)->data) return 0;
+
+    return lv_img_buf_get_img_size(e->dec_dsc.header.w, e->dec_dsc.header.h, e->dec_dsc.header.cf);
+}
+
+/**
+ * Remove an entry from the LRU list
+ * @param i index of the entry
+ */
+static void lru_unlink(uint16_t i)
+{
+    lv_img_cache_entry_t * e = CACHE_ENTRY(i);
+    if(e->lru_prev != IMG_CACHE_NONE) CACHE_ENTRY(e->lru_prev)->lru_next = e->lru_next;
+    else lru_head = e->lru_next;
+
+    if(e->lru_next != IMG_CACHE_NONE) CACHE_ENTRY(e->lru_next)->lru_prev = e->lru_prev;
+    else lru_tail = e->lru_prev;
+}
+
+/**
+ * Add an entry to the beginning of the LRU list (most recently used)
+ * @param i index of the entry
+ */
+static void lru_ins_head(uint16_t i)
+{
+    lv_img_cache_entry_t * e = CACHE_ENTRY(i);
+    e->lru_prev = IMG_CACHE_NONE;
+    e->lru_next = lru_head;
+    if(lru_head != IMG_CACHE_NONE) CACHE_ENTRY(lru_head)->lru_prev = i;
+    lru_head = i;
+    if(lru_tail == IMG_CACHE_NONE) lru_tail = i;
+}
+
+/**
+ * Add an entry to the end of the LRU list (least recently used)
+ * @param i index of the entry
+ */
+static void lru_ins_tail(uint16_t i)
+{
+    lv_img_cache_entry_t * e = CACHE_ENTRY(i);
+    e->lru_next = IMG_CACHE_NONE;
+    e->lru_prev = lru_tail;
+    if(lru_tail != IMG_CACHE_NONE) CACHE_ENTRY(lru_tail)->lru_next = i;
+    lru_tail = i;
+    if(lru_head == IMG_CACHE_NONE) lru_head = i;
+}
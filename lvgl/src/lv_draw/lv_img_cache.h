@@ -31,12 +31,27 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_tio_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
-    int32_t life;
+    /** Memory used by the decoded image in bytes.
+     * 0 if the decoder doesn't keep the decoded image in the RAM (e.g. it reads it line-by-line)*/
+    uint32_t size;
+
+    uint32_t hash;          /**< Hash of the source (and the color for variables)*/
+    uint16_t hash_next;     /**< Next entry with the same hash bucket*/
+    uint16_t lru_prev;      /**< The more recently used entry*/
+    uint16_t lru_next;      /**< The less recently used entry*/
 } lv_img_cache_entry_t;
 
+/**
+ * Statistics of the image cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< The image was found in the cache*/
+    uint32_t miss_cnt;      /**< The image was opened*/
+    uint32_t evict_cnt;     /**< An image was closed to make room for an other*/
+    uint32_t size;          /**< Memory used by the cached images in bytes*/
+    uint16_t entry_cnt;     /**< Number of cached images*/
+} lv_img_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -59,6 +74,25 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color);
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Limit the memory used by the decoded images in the cache.
+ * The least recently used images are closed if the limit is exceeded.
+ * The last opened image is kept even if it's larger than the limit.
+ * @param max_bytes the maximal memory used by the cached images in bytes. 0: no limit
+ */
+void lv_img_cache_set_max_bytes(uint32_t max_bytes);
+
+/**
+ * Get the statistics of the image cache
+ * @param stat store the statistics here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and eviction counters of the image cache
+ */
+void lv_img_cache_reset_stat(void);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -12,6 +12,8 @@
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_prof.h"
 
 #if defined(LV_GC_INCLUDE)
     #include LV_GC_INCLUDE
@@ -29,6 +31,11 @@
 typedef struct {
 #if LV_USE_FILESYSTEM
     lv_fs_file_t * f;
+    const uint8_t * map;    /*Content of the file if the driver mapped it into the memory*/
+    uint32_t map_size;
+    uint8_t * rows;         /*Buffered rows of the image read from the file*/
+    lv_coord_t rows_y;      /*Index of the first buffered row*/
+    lv_coord_t rows_cnt;    /*Number of buffered rows*/
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
@@ -43,10 +50,18 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+#if LV_USE_FILESYSTEM
+static const uint8_t * built_in_file_get_row(lv_img_decoder_dsc_t * dsc, lv_coord_t y, uint32_t ofs, uint32_t len,
+                                             uint32_t data_pos, uint32_t row_size, uint8_t * buf);
+static lv_res_t built_in_file_read(lv_img_decoder_built_in_data_t * user_data, uint32_t pos, void * buf, uint32_t len);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_FILESYSTEM
+    static lv_img_decoder_file_stat_t file_stat;
+#endif
 
 /**********************
  *      MACROS
@@ -93,6 +108,11 @@ lv_res_t lv_img_decoder_get_info(const char * src, lv_img_header_t * header)
     header->w = 0;
     header->cf = LV_IMG_CF_UNKNOWN;
 
+    /*The decoders might not be thread safe (e.g. they use the file system)*/
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_lock();
+#endif
+
     lv_res_t res = LV_RES_INV;
     lv_img_decoder_t * d;
     _LV_LL_READ(LV_GC_ROOT(_lv_img_defoder_ll), d) {
@@ -103,6 +123,10 @@ lv_res_t lv_img_decoder_get_info(const char * src, lv_img_header_t * header)
         }
     }
 
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_unlock();
+#endif
+
     return res;
 }
 
@@ -135,6 +159,8 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 
     lv_res_t res = LV_RES_INV;
 
+    LV_PROF_START();
+
     lv_img_decoder_t * d;
     _LV_LL_READ(LV_GC_ROOT(_lv_img_defoder_ll), d) {
         /*Info an Open callbacks are required*/
@@ -153,6 +179,8 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
         if(res == LV_RES_OK) break;
     }
 
+    LV_PROF_END(LV_PROF_STAGE_IMG_DECODE, NULL);
+
     return res;
 }
 
@@ -168,7 +196,9 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
 {
     lv_res_t res = LV_RES_INV;
+    LV_PROF_START();
     if(dsc->decoder->read_line_cb) res = dsc->decoder->read_line_cb(dsc->decoder, dsc, x, y, len, buf);
+    LV_PROF_END(LV_PROF_STAGE_IMG_DECODE, NULL);
 
     return res;
 }
@@ -354,6 +384,15 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         _lv_memcpy_small(user_data->f, &f, sizeof(f));
 
+        /*Read the file directly from the memory if the driver can map it*/
+        const void * map;
+        uint32_t map_size;
+        if(lv_fs_map(user_data->f, &map, &map_size) == LV_FS_RES_OK) {
+            user_data->map = map;
+            user_data->map_size = map_size;
+            file_stat.map_cnt++;
+        }
+
 #else
         LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
         return LV_RES_INV;
@@ -415,14 +454,21 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             /*Read the palette from file*/
 #if LV_USE_FILESYSTEM
-            lv_fs_seek(user_data->f, 4); /*Skip the header*/
-            lv_color32_t cur_color;
+            uint32_t palette_bytes = palette_size * sizeof(lv_color32_t);
+            lv_color32_t * palette_p = _lv_mem_buf_get(palette_bytes);
+            if(built_in_file_read(user_data, 4, palette_p, palette_bytes) != LV_RES_OK) { /*4: skip the header*/
+                LV_LOG_WARN("Built-in image decoder can't read the palette");
+                _lv_mem_buf_release(palette_p);
+                lv_img_decoder_built_in_close(decoder, dsc);
+                return LV_RES_INV;
+            }
+
             uint32_t i;
             for(i = 0; i < palette_size; i++) {
-                lv_fs_read(user_data->f, &cur_color, sizeof(lv_color32_t), NULL);
-                user_data->palette[i] = lv_color_make(cur_color.ch.red, cur_color.ch.green, cur_color.ch.blue);
-                user_data->opa[i]     = cur_color.ch.alpha;
+                user_data->palette[i] = lv_color_make(palette_p[i].ch.red, palette_p[i].ch.green, palette_p[i].ch.blue);
+                user_data->opa[i]     = palette_p[i].ch.alpha;
             }
+            _lv_mem_buf_release(palette_p);
 #else
             LV_LOG_WARN("Image built-in decoder can read the palette because LV_USE_FILESYSTEM = 0");
             return LV_RES_INV;
@@ -524,9 +570,11 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
     if(user_data) {
 #if LV_USE_FILESYSTEM
         if(user_data->f) {
+            if(user_data->map) lv_fs_unmap(user_data->f, user_data->map, user_data->map_size);
             lv_fs_close(user_data->f);
             lv_mem_free(user_data->f);
         }
+        if(user_data->rows) lv_mem_free(user_data->rows);
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
@@ -537,6 +585,24 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
     }
 }
 
+#if LV_USE_FILESYSTEM
+/**
+ * Get the statistics of the file reads of the built-in image decoder
+ * @param stat store the statistics here
+ */
+void lv_img_decoder_get_file_stat(lv_img_decoder_file_stat_t * stat)
+{
+    *stat = file_stat;
+}
+
+/**
+ * Reset the statistics of the file reads of the built-in image decoder
+ */
+void lv_img_decoder_reset_file_stat(void)
+{
+    _lv_memset_00(&file_stat, sizeof(file_stat));
+}
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
@@ -546,25 +612,19 @@ static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * d
                                                         lv_coord_t len, uint8_t * buf)
 {
 #if LV_USE_FILESYSTEM
-    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    lv_fs_res_t res;
     uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
-
-    uint32_t pos = ((y * dsc->header.w + x) * px_size) >> 3;
-    pos += 4; /*Skip the header*/
-    res = lv_fs_seek(user_data->f, pos);
-    if(res != LV_FS_RES_OK) {
-        LV_LOG_WARN("Built-in image decoder seek failed");
-        return LV_RES_INV;
-    }
+    uint32_t row_size = ((uint32_t)dsc->header.w * px_size) >> 3;
     uint32_t btr = len * (px_size >> 3);
-    uint32_t br  = 0;
-    res = lv_fs_read(user_data->f, buf, btr, &br);
-    if(res != LV_FS_RES_OK || btr != br) {
+
+    /*4: skip the header*/
+    const uint8_t * data = built_in_file_get_row(dsc, y, (x * px_size) >> 3, btr, 4, row_size, buf);
+    if(data == NULL) {
         LV_LOG_WARN("Built-in image decoder read failed");
         return LV_RES_INV;
     }
 
+    if(data != buf) _lv_memcpy(buf, data, btr);
+
     return LV_RES_OK;
 #else
     LV_UNUSED(dsc);
@@ -642,8 +702,7 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
     }
 
 #if LV_USE_FILESYSTEM
-    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
+    uint8_t * fs_buf = NULL;
 #endif
 
     const uint8_t * data_tmp = NULL;
@@ -654,9 +713,16 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
     }
     else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+        /*Read only the bytes of the pixels. 4: skip the header*/
+        uint32_t row_ofs = (x * px_size) >> 3;
+        uint32_t btr = ((((uint32_t)x + len) * px_size + 7) >> 3) - row_ofs;
+        fs_buf = _lv_mem_buf_get(btr);
+        data_tmp = built_in_file_get_row(dsc, y, row_ofs, btr, 4, w, fs_buf);
+        if(data_tmp == NULL) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            _lv_mem_buf_release(fs_buf);
+            return LV_RES_INV;
+        }
 #else
         LV_LOG_WARN("Image built-in alpha line reader can't read file because LV_USE_FILESYSTEM = 0");
         data_tmp = NULL; /*To avoid warnings*/
@@ -677,7 +743,7 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
         }
     }
 #if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
 #endif
     return LV_RES_OK;
 
@@ -731,7 +797,7 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
 
 #if LV_USE_FILESYSTEM
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
+    uint8_t * fs_buf = NULL;
 #endif
     const uint8_t * data_tmp = NULL;
     if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
@@ -740,9 +806,17 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     }
     else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+        /*Read only the bytes of the pixels. Skip the header and the palette*/
+        uint32_t row_ofs = (x * px_size) >> 3;
+        uint32_t btr = ((((uint32_t)x + len) * px_size + 7) >> 3) - row_ofs;
+        uint32_t data_pos = 4 + (sizeof(lv_color32_t) << px_size);
+        fs_buf = _lv_mem_buf_get(btr);
+        data_tmp = built_in_file_get_row(dsc, y, row_ofs, btr, data_pos, w, fs_buf);
+        if(data_tmp == NULL) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            _lv_mem_buf_release(fs_buf);
+            return LV_RES_INV;
+        }
 #else
         LV_LOG_WARN("Image built-in indexed line reader can't read file because LV_USE_FILESYSTEM = 0");
         data_tmp = NULL; /*To avoid warnings*/
@@ -775,7 +849,7 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
         }
     }
 #if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
 #endif
     return LV_RES_OK;
 #else
@@ -783,3 +857,93 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     return LV_RES_INV;
 #endif
 }
+
+#if LV_USE_FILESYSTEM
+/**
+ * Get some bytes of a row of an opened image file.
+ * The bytes are taken from the mapped file or from the buffered rows if possible.
+ * Else a strip of rows is read into the row buffer (or only the requested bytes into `buf`).
+ * @param dsc pointer to a decoder descriptor with an opened file
+ * @param y index of the row
+ * @param ofs offset of the first byte in the row
+ * @param len number of bytes to get
+ * @param data_pos position of the first row in the file
+ * @param row_size size of a row in bytes
+ * @param buf a buffer with `len` bytes to use if the bytes are read directly
+ * @return pointer to the bytes or NULL on error
+ */
+static const uint8_t * built_in_file_get_row(lv_img_decoder_dsc_t * dsc, lv_coord_t y, uint32_t ofs, uint32_t len,
+                                             uint32_t data_pos, uint32_t row_size, uint8_t * buf)
+{
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    uint32_t pos = data_pos + (uint32_t)y * row_size + ofs;
+
+    if(user_data->map) {
+        if(pos + len > user_data->map_size) return NULL;
+        file_stat.buf_hit_cnt++;
+        return user_data->map + pos;
+    }
+
+#if LV_IMG_DECODER_FILE_BUF_SIZE
+    if(y >= user_data->rows_y && y < user_data->rows_y + user_data->rows_cnt) {
+        file_stat.buf_hit_cnt++;
+        return user_data->rows + (uint32_t)(y - user_data->rows_y) * row_size + ofs;
+    }
+
+    uint32_t row_cnt = LV_IMG_DECODER_FILE_BUF_SIZE / row_size;
+    if(row_cnt > dsc->header.h) row_cnt = dsc->header.h;
+    if(row_cnt > 0) {
+        if(user_data->rows == NULL) user_data->rows = lv_mem_alloc(row_cnt * row_size);
+
+        if(user_data->rows) {
+            /*The images are usually drawn from top to bottom so read the next rows.
+             *Read the last `row_cnt` rows at the bottom of the image.*/
+            lv_coord_t rows_y = y;
+            if(rows_y + row_cnt > dsc->header.h) rows_y = dsc->header.h - row_cnt;
+
+            if(built_in_file_read(user_data, data_pos + (uint32_t)rows_y * row_size, user_data->rows,
+                                  row_cnt * row_size) == LV_RES_OK) {
+                user_data->rows_y = rows_y;
+                user_data->rows_cnt = row_cnt;
+                return user_data->rows + (uint32_t)(y - rows_y) * row_size + ofs;
+            }
+
+            /*E.g. a truncated file. Try to read only the requested bytes.*/
+            user_data->rows_cnt = 0;
+        }
+    }
+#endif
+
+    if(built_in_file_read(user_data, pos, buf, len) != LV_RES_OK) return NULL;
+    return buf;
+}
+
+/**
+ * Read bytes from a given position of an opened image file
+ * @param user_data the decoder's data with the opened file
+ * @param pos position in the file
+ * @param buf read the bytes here
+ * @param len number of bytes to read
+ * @return LV_RES_OK: all bytes are read; LV_RES_INV: error
+ */
+static lv_res_t built_in_file_read(lv_img_decoder_built_in_data_t * user_data, uint32_t pos, void * buf, uint32_t len)
+{
+    if(user_data->map) {
+        if(pos + len > user_data->map_size) return LV_RES_INV;
+        _lv_memcpy(buf, user_data->map + pos, len);
+        return LV_RES_OK;
+    }
+
+    file_stat.seek_cnt++;
+    lv_fs_res_t res = lv_fs_seek(user_data->f, pos);
+    if(res != LV_FS_RES_OK) return LV_RES_INV;
+
+    uint32_t br = 0;
+    file_stat.read_cnt++;
+    res = lv_fs_read(user_data->f, buf, len, &br);
+    file_stat.read_bytes += br;
+    if(res != LV_FS_RES_OK || br != len) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+#endif
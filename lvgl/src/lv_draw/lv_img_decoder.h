@@ -128,6 +128,17 @@ typedef struct _lv_img_decoder_dsc {
     void * user_data;
 } lv_img_decoder_dsc_t;
 
+#if LV_USE_FILESYSTEM
+/**Statistics of the file reads of the built-in image decoder*/
+typedef struct {
+    uint32_t read_cnt;      /**< Number of `lv_fs_read()` calls*/
+    uint32_t seek_cnt;      /**< Number of `lv_fs_seek()` calls*/
+    uint32_t read_bytes;    /**< Number of bytes read from the files*/
+    uint32_t map_cnt;       /**< Number of files mapped into the memory with `lv_fs_map()`*/
+    uint32_t buf_hit_cnt;   /**< Number of lines found in the buffered rows or in a mapped file*/
+} lv_img_decoder_file_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -259,6 +270,19 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
  */
 void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 
+#if LV_USE_FILESYSTEM
+/**
+ * Get the statistics of the file reads of the built-in image decoder
+ * @param stat store the statistics here
+ */
+void lv_img_decoder_get_file_stat(lv_img_decoder_file_stat_t * stat);
+
+/**
+ * Reset the statistics of the file reads of the built-in image decoder
+ */
+void lv_img_decoder_reset_file_stat(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
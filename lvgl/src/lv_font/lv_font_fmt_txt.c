@@ -15,6 +15,7 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_core/lv_refr.h"
 
 #if defined(LV_GC_INCLUDE)
     #include LV_GC_INCLUDE
@@ -23,6 +24,16 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+    #define GLYPH_CACHE_NONE    0xFFFF
+#endif
+
+#if LV_USE_FONT_LOOKUP_TABLES
+    #define LOOKUP_BLOCK_SIZE   64      /*Number of code points in a block of the glyph ID tables*/
+    #define LOOKUP_KERN_CNT     256     /*Number of entries in the hash of kerning pairs.
+                                         *256 because the slot is used to restore the low byte of the right ID*/
+    #define LOOKUP_KERN_SLOT(left, right)   ((((left) * 31) + (right)) & (LOOKUP_KERN_CNT - 1))
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -33,10 +44,53 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+typedef struct {
+    const lv_font_t * font;
+    uint32_t letter;
+    uint8_t * bitmap;       /*NULL if the entry is unused*/
+    uint32_t size;
+    uint16_t hash_next;     /*Next entry in the same hash bucket*/
+    uint16_t lru_prev;      /*The more recently used entry*/
+    uint16_t lru_next;      /*The less recently used entry*/
+    uint8_t bpp;
+} glyph_cache_entry_t;
+
+typedef struct {
+    glyph_cache_entry_t entries[LV_FONT_GLYPH_CACHE_CNT];
+    uint16_t hash[LV_FONT_GLYPH_CACHE_CNT];     /*First entry of the hash buckets*/
+    uint16_t lru_head;      /*The most recently used entry. The unused entries are at the end*/
+    uint16_t lru_tail;
+    uint32_t gen;           /*Clear the cache if it's not `glyph_cache_gen`*/
+    lv_font_glyph_cache_stat_t stat;
+} glyph_cache_t;
+#endif
+
+#if LV_USE_FONT_LOOKUP_TABLES
+typedef struct {
+    uint16_t ** blocks;     /*Glyph IDs of `LOOKUP_BLOCK_SIZE` code points per block.
+                             *A block is NULL until a letter of it is used. NULL if the cmap isn't sparse*/
+    uint16_t block_cnt;
+} lookup_cmap_t;
+
+typedef struct _lv_font_fmt_txt_lookup_t {
+    struct _lv_font_fmt_txt_lookup_t * next;    /*Next font with lookup tables*/
+    lv_font_fmt_txt_dsc_t * dsc;
+    lookup_cmap_t * cmaps;  /*One for every cmap of the font*/
+
+    /* Hash of the recently used kerning pairs if the font has kerning pairs (not classes).
+     * An entry is `left_id << 16 | (right_id >> 8) << 8 | value` so that it can be read and written atomically.
+     * The low byte of the right ID is given by the slot. 0: unused entry*/
+    uint32_t * kern;
+} lookup_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static const uint8_t * get_bitmap_data(const lv_font_t * font, uint32_t gid);
+static uint32_t cmap_get_glyph_id(const lv_font_fmt_txt_cmap_t * cmap, uint32_t rcp);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
@@ -51,18 +105,39 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /* LV_USE_FONT_COMPRESSED */
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+    static uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t letter, uint32_t gid, uint32_t size);
+    static glyph_cache_t * glyph_cache_get_act(void);
+    static void glyph_cache_reset(glyph_cache_t * cache);
+    static uint16_t glyph_cache_hash(const lv_font_t * font, uint32_t letter);
+    static void glyph_cache_lru_unlink(glyph_cache_t * cache, uint16_t i);
+    static void glyph_cache_lru_ins_head(glyph_cache_t * cache, uint16_t i);
+    static void glyph_cache_evict(glyph_cache_t * cache, uint16_t i);
+#endif
+
+#if LV_USE_FONT_LOOKUP_TABLES
+    static lookup_t * lookup_get(lv_font_fmt_txt_dsc_t * fdsc);
+    static lookup_t * lookup_create(lv_font_fmt_txt_dsc_t * fdsc);
+    static const uint16_t * lookup_get_block(lv_font_fmt_txt_dsc_t * fdsc, uint16_t cmap_id, uint32_t rcp);
+    static void lookup_free(lookup_t * lookup);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
+    static LV_THREAD_LOCAL uint32_t rle_rdp;
+    static LV_THREAD_LOCAL const uint8_t * rle_in;
+    static LV_THREAD_LOCAL uint8_t rle_bpp;
+    static LV_THREAD_LOCAL uint8_t rle_prev_v;
+    static LV_THREAD_LOCAL uint8_t rle_cnt;
+    static LV_THREAD_LOCAL rle_state_t rle_state;
 #endif /* LV_USE_FONT_COMPRESSED */
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+    static uint32_t glyph_cache_gen = 1;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -92,7 +167,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        if(gdsc) return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+        if(gdsc) return get_bitmap_data(font, gid);
     }
     /*Handle compressed bitmap*/
     else {
@@ -117,6 +192,15 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
+#if LV_FONT_GLYPH_CACHE_CNT
+        uint8_t * cached = glyph_cache_get(font, unicode_letter, gid, buf_size);
+        if(cached) return cached;
+        /*Decompress into the common buffer if the glyph can't be cached*/
+#endif
+
+        const uint8_t * bitmap_in = get_bitmap_data(font, gid);
+        if(bitmap_in == NULL) return NULL;
+
         if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
             LV_GC_ROOT(_lv_font_decompr_buf) = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
             LV_ASSERT_MEM(LV_GC_ROOT(_lv_font_decompr_buf));
@@ -124,7 +208,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+        decompress(bitmap_in, LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp,
                    prefilter);
         return LV_GC_ROOT(_lv_font_decompr_buf);
@@ -197,8 +281,89 @@ void _lv_font_clean_up_fmt_txt(void)
         lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf));
         LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
     }
+
+    if(LV_GC_ROOT(_lv_font_bitmap_buf)) {
+        lv_mem_free(LV_GC_ROOT(_lv_font_bitmap_buf));
+        LV_GC_ROOT(_lv_font_bitmap_buf) = NULL;
+    }
+}
+
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+/**
+ * Drop all glyphs from the glyph caches. Should be called if a font is deleted or modified.
+ * The caches of the rendering threads are cleared before their next use.
+ */
+void lv_font_glyph_cache_clear(void)
+{
+    glyph_cache_gen++;
+
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache) glyph_cache_reset(cache);
 }
 
+/**
+ * Get the statistics of the glyph cache of the calling thread
+ * @param stat store the statistics here
+ */
+void lv_font_glyph_cache_get_stat(lv_font_glyph_cache_stat_t * stat)
+{
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache) *stat = cache->stat;
+    else _lv_memset_00(stat, sizeof(lv_font_glyph_cache_stat_t));
+}
+
+/**
+ * Reset the hit, miss and eviction counters of the glyph cache of the calling thread
+ */
+void lv_font_glyph_cache_reset_stat(void)
+{
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache == NULL) return;
+
+    cache->stat.hit_cnt = 0;
+    cache->stat.miss_cnt = 0;
+    cache->stat.evict_cnt = 0;
+}
+#endif
+
+#if LV_USE_FONT_LOOKUP_TABLES
+/**
+ * Free the lookup tables of a font. Should be called before the font is deleted or modified
+ * (and not while it's being drawn). The tables are built again on the next use of the font.
+ * @param font pointer to a font
+ */
+void lv_font_fmt_txt_free_lookup(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+    lookup_t * lookup = fdsc->lookup;
+    if(lookup == NULL) return;
+
+    /*Unlink it from the list of the fonts with lookup tables*/
+    lookup_t ** prev_next = (lookup_t **) &LV_GC_ROOT(_lv_font_lookup_list);
+    while(*prev_next != lookup) prev_next = &(*prev_next)->next;
+    *prev_next = lookup->next;
+
+    fdsc->lookup = NULL;
+    lookup_free(lookup);
+}
+
+/**
+ * Free the lookup tables of all fonts. Called from `lv_deinit()`.
+ */
+void _lv_font_fmt_txt_free_lookup_all(void)
+{
+    lookup_t * lookup = LV_GC_ROOT(_lv_font_lookup_list);
+    while(lookup) {
+        lookup_t * next = lookup->next;
+        lookup->dsc->lookup = NULL;
+        lookup_free(lookup);
+        lookup = next;
+    }
+
+    LV_GC_ROOT(_lv_font_lookup_list) = NULL;
+}
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
@@ -210,59 +375,104 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
-    /*Check the cache first*/
+#if LV_USE_REFR_THREADS == 0
+    /*Check the cache first.
+     *It's not used with rendering threads because the letter and its ID can't be updated atomically.*/
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
+#endif
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
-        uint32_t glyph_id = 0;
-        if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
-            glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
-        }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
-            const uint8_t * gid_ofs_8 = fdsc->cmaps[i].glyph_id_ofs_list;
-            glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
-        }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
-            uint16_t key = rcp;
-            uint8_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) fdsc->cmaps[i].unicode_list);
-                ofs = ofs >> 1;     /*The list stores `uint16_t` so the get the index divide by 2*/
-                glyph_id = fdsc->cmaps[i].glyph_id_start + ofs;
-            }
-        }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
-            uint16_t key = rcp;
-            uint8_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) fdsc->cmaps[i].unicode_list);
-                ofs = ofs >> 1;     /*The list stores `uint16_t` so the get the index divide by 2*/
-                const uint8_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
-                glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_16[ofs];
-            }
-        }
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
+
+#if LV_USE_FONT_LOOKUP_TABLES
+        /*Read the ID from the table instead of searching in the sparse list*/
+        uint32_t glyph_id;
+        const uint16_t * block = lookup_get_block(fdsc, i, rcp);
+        if(block) glyph_id = block[rcp % LOOKUP_BLOCK_SIZE];
+        else glyph_id = cmap_get_glyph_id(&fdsc->cmaps[i], rcp);
+#else
+        uint32_t glyph_id = cmap_get_glyph_id(&fdsc->cmaps[i], rcp);
+#endif
 
+#if LV_USE_REFR_THREADS == 0
         /*Update the cache*/
         fdsc->last_letter = letter;
         fdsc->last_glyph_id = glyph_id;
+#endif
         return glyph_id;
     }
 
+#if LV_USE_REFR_THREADS == 0
     fdsc->last_letter = letter;
     fdsc->last_glyph_id = 0;
+#endif
     return 0;
 
 }
 
+/**
+ * Get the bitmap of a glyph as it's stored in the font
+ * @param font pointer to a font
+ * @param gid ID of a glyph
+ * @return pointer to the bitmap or NULL if it couldn't be read
+ */
+static const uint8_t * get_bitmap_data(const lv_font_t * font, uint32_t gid)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+    if(fdsc->glyph_bitmap) return &fdsc->glyph_bitmap[fdsc->glyph_dsc[gid].bitmap_index];
+
+    /*The bitmaps are not in the memory*/
+    if(fdsc->get_bitmap_data_cb) return fdsc->get_bitmap_data_cb(font, gid);
+    return NULL;
+}
+
+/**
+ * Get the glyph ID of a code point from a cmap
+ * @param cmap pointer to a cmap
+ * @param rcp the code point relative to the start of the cmap's range (less than `range_length`)
+ * @return the glyph ID or 0 if the code point is not in the cmap
+ */
+static uint32_t cmap_get_glyph_id(const lv_font_fmt_txt_cmap_t * cmap, uint32_t rcp)
+{
+    uint32_t glyph_id = 0;
+    if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+        glyph_id = cmap->glyph_id_start + rcp;
+    }
+    else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+        const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+        glyph_id = cmap->glyph_id_start + gid_ofs_8[rcp];
+    }
+    else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+        uint16_t key = rcp;
+        uint8_t * p = _lv_utils_bsearch(&key, cmap->unicode_list, cmap->list_length,
+                                        sizeof(cmap->unicode_list[0]), unicode_list_compare);
+
+        if(p) {
+            lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) cmap->unicode_list);
+            ofs = ofs >> 1;     /*The list stores `uint16_t` so the get the index divide by 2*/
+            glyph_id = cmap->glyph_id_start + ofs;
+        }
+    }
+    else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+        uint16_t key = rcp;
+        uint8_t * p = _lv_utils_bsearch(&key, cmap->unicode_list, cmap->list_length,
+                                        sizeof(cmap->unicode_list[0]), unicode_list_compare);
+
+        if(p) {
+            lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) cmap->unicode_list);
+            ofs = ofs >> 1;     /*The list stores `uint16_t` so the get the index divide by 2*/
+            const uint8_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+            glyph_id = cmap->glyph_id_start + gid_ofs_16[ofs];
+        }
+    }
+
+    return glyph_id;
+}
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
@@ -270,6 +480,17 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     int8_t value = 0;
 
     if(fdsc->kern_classes == 0) {
+#if LV_USE_FONT_LOOKUP_TABLES
+        /*Check the hash of the recently used pairs first*/
+        uint32_t * kern_entry = NULL;
+        lookup_t * lookup = lookup_get(fdsc);
+        if(lookup && lookup->kern && gid_left <= 0xFFFF && gid_right <= 0xFFFF) {
+            kern_entry = &lookup->kern[LOOKUP_KERN_SLOT(gid_left, gid_right)];
+            uint32_t e = *kern_entry;
+            if((e >> 16) == gid_left && ((e >> 8) & 0xFF) == (gid_right >> 8)) return (int8_t)(e & 0xFF);
+        }
+#endif
+
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
         if(kdsc->glyph_ids_size == 0) {
@@ -304,6 +525,10 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
         else {
             /*Invalid value*/
         }
+
+#if LV_USE_FONT_LOOKUP_TABLES
+        if(kern_entry) *kern_entry = (gid_left << 16) | ((gid_right >> 8) << 8) | (uint8_t)value;
+#endif
     }
     else {
         /*Kern classes*/
@@ -591,3 +816,351 @@ static int32_t unicode_list_compare(const void * ref, const void * element)
 {
     return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)(*(uint16_t *)element));
 }
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+
+/**
+ * Get a decompressed glyph from the glyph cache of the calling thread.
+ * Decompress and add it to the cache if it's not cached yet.
+ * @param font pointer to a font
+ * @param letter the unicode letter of the glyph
+ * @param gid ID of the glyph
+ * @param size size of the decompressed bitmap in bytes
+ * @return pointer to the decompressed bitmap or NULL if the glyph can't be cached
+ */
+static uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t letter, uint32_t gid, uint32_t size)
+{
+    glyph_cache_t * cache = glyph_cache_get_act();
+    if(cache == NULL) return NULL;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+    uint8_t bpp = (uint8_t)fdsc->bpp;
+    uint16_t h = glyph_cache_hash(font, letter);
+    uint16_t i;
+    for(i = cache->hash[h]; i != GLYPH_CACHE_NONE; i = cache->entries[i].hash_next) {
+        glyph_cache_entry_t * e = &cache->entries[i];
+        if(e->font == font && e->letter == letter && e->bpp == bpp) {
+            cache->stat.hit_cnt++;
+            if(cache->lru_head != i) {
+                glyph_cache_lru_unlink(cache, i);
+                glyph_cache_lru_ins_head(cache, i);
+            }
+            return e->bitmap;
+        }
+    }
+
+    cache->stat.miss_cnt++;
+
+    const uint8_t * bitmap_in = get_bitmap_data(font, gid);
+    if(bitmap_in == NULL) return NULL;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+
+    /*Reuse the least recently used entry*/
+    i = cache->lru_tail;
+    if(cache->entries[i].bitmap) glyph_cache_evict(cache, i);
+
+    /*If there is no memory evict more glyphs, starting from the least recently used*/
+    uint8_t * bitmap = lv_mem_alloc(size);
+    uint16_t victim = cache->lru_tail;
+    while(bitmap == NULL && victim != GLYPH_CACHE_NONE) {
+        uint16_t prev = cache->entries[victim].lru_prev;
+        if(cache->entries[victim].bitmap) {
+            glyph_cache_evict(cache, victim);
+            bitmap = lv_mem_alloc(size);
+        }
+        victim = prev;
+    }
+    if(bitmap == NULL) return NULL;
+
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(bitmap_in, bitmap, gdsc->box_w, gdsc->box_h, bpp, prefilter);
+
+    glyph_cache_entry_t * e = &cache->entries[i];
+    e->font = font;
+    e->letter = letter;
+    e->bpp = bpp;
+    e->bitmap = bitmap;
+    e->size = size;
+    e->hash_next = cache->hash[h];
+    cache->hash[h] = i;
+    glyph_cache_lru_unlink(cache, i);
+    glyph_cache_lru_ins_head(cache, i);
+
+    cache->stat.size += size;
+    cache->stat.glyph_cnt++;
+
+    return bitmap;
+}
+
+/**
+ * Get the glyph cache of the calling thread. Create it if required.
+ * @return pointer to the glyph cache or NULL if out of memory
+ */
+static glyph_cache_t * glyph_cache_get_act(void)
+{
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(glyph_cache_t));
+        LV_ASSERT_MEM(cache);
+        if(cache == NULL) return NULL;
+
+        _lv_memset_00(cache, sizeof(glyph_cache_t));
+        uint16_t i;
+        for(i = 0; i < LV_FONT_GLYPH_CACHE_CNT; i++) {
+            cache->entries[i].lru_prev = i == 0 ? GLYPH_CACHE_NONE : i - 1;
+            cache->entries[i].lru_next = i == LV_FONT_GLYPH_CACHE_CNT - 1 ? GLYPH_CACHE_NONE : i + 1;
+            cache->hash[i] = GLYPH_CACHE_NONE;
+        }
+        cache->lru_head = 0;
+        cache->lru_tail = LV_FONT_GLYPH_CACHE_CNT - 1;
+        cache->gen = glyph_cache_gen;
+        LV_GC_ROOT(_lv_font_glyph_cache) = cache;
+    }
+
+    /*A font was deleted or modified since the last use*/
+    if(cache->gen != glyph_cache_gen) {
+        glyph_cache_reset(cache);
+        cache->gen = glyph_cache_gen;
+    }
+
+    return cache;
+}
+
+/**
+ * Free all glyphs of a glyph cache
+ * @param cache pointer to a glyph cache
+ */
+static void glyph_cache_reset(glyph_cache_t * cache)
+{
+    uint16_t i;
+    for(i = 0; i < LV_FONT_GLYPH_CACHE_CNT; i++) {
+        if(cache->entries[i].bitmap) {
+            lv_mem_free(cache->entries[i].bitmap);
+            cache->entries[i].bitmap = NULL;
+        }
+        cache->hash[i] = GLYPH_CACHE_NONE;
+    }
+
+    cache->stat.size = 0;
+    cache->stat.glyph_cnt = 0;
+}
+
+/**
+ * Get the hash bucket of a glyph
+ * @param font pointer to a font
+ * @param letter a unicode letter
+ * @return index of the hash bucket
+ */
+static uint16_t glyph_cache_hash(const lv_font_t * font, uint32_t letter)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)font >> 3) ^ (letter * 2654435761U);
+    return (uint16_t)((h ^ (h >> 16)) % LV_FONT_GLYPH_CACHE_CNT);
+}
+
+/**
+ * Remove an entry from the LRU list
+ * @param cache pointer to a glyph cache
+ * @param i index of the entry
+ */
+static void glyph_cache_lru_unlink(glyph_cache_t * cache, uint16_t i)
+{
+    glyph_cache_entry_t * e = &cache->entries[i];
+    if(e->lru_prev != GLYPH_CACHE_NONE) cache->entries[e->lru_prev].lru_next = e->lru_next;
+    else cache->lru_head = e->lru_next;
+
+    if(e->lru_next != GLYPH_CACHE_NONE) cache->entries[e->lru_next].lru_prev = e->lru_prev;
+    else cache->lru_tail = e->lru_prev;
+}
+
+/**
+ * Add an entry to the beginning of the LRU list
+ * @param cache pointer to a glyph cache
+ * @param i index of the entry
+ */
+static void glyph_cache_lru_ins_head(glyph_cache_t * cache, uint16_t i)
+{
+    glyph_cache_entry_t * e = &cache->entries[i];
+    e->lru_prev = GLYPH_CACHE_NONE;
+    e->lru_next = cache->lru_head;
+    if(cache->lru_head != GLYPH_CACHE_NONE) cache->entries[cache->lru_head].lru_prev = i;
+    cache->lru_head = i;
+    if(cache->lru_tail == GLYPH_CACHE_NONE) cache->lru_tail = i;
+}
+
+/**
+ * Remove a glyph from the cache and move its entry to the end of the LRU list
+ * @param cache pointer to a glyph cache
+ * @param i index of a used entry
+ */
+static void glyph_cache_evict(glyph_cache_t * cache, uint16_t i)
+{
+    glyph_cache_entry_t * e = &cache->entries[i];
+
+    uint16_t * link = &cache->hash[glyph_cache_hash(e->font, e->letter)];
+    while(*link != i) link = &cache->entries[*link].hash_next;
+    *link = e->hash_next;
+
+    lv_mem_free(e->bitmap);
+    e->bitmap = NULL;
+    cache->stat.size -= e->size;
+    cache->stat.glyph_cnt--;
+    cache->stat.evict_cnt++;
+
+    if(cache->lru_tail != i) {
+        glyph_cache_lru_unlink(cache, i);
+        e->lru_prev = cache->lru_tail;
+        e->lru_next = GLYPH_CACHE_NONE;
+        cache->entries[cache->lru_tail].lru_next = i;
+        cache->lru_tail = i;
+    }
+}
+#endif /*LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT*/
+
+#if LV_USE_FONT_LOOKUP_TABLES
+/**
+ * Get the lookup tables of a font and create them on the first use
+ * @param fdsc pointer to a font descriptor
+ * @return pointer to the lookup tables or NULL if they couldn't be created
+ */
+static lookup_t * lookup_get(lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(fdsc->lookup) return fdsc->lookup;
+
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_lock();
+#endif
+    /*Check again because an other thread might have created it in the meantime*/
+    if(fdsc->lookup == NULL) fdsc->lookup = lookup_create(fdsc);
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_unlock();
+#endif
+
+    return fdsc->lookup;
+}
+
+/**
+ * Allocate the lookup tables of a font with empty glyph ID blocks and kerning hash
+ * @param fdsc pointer to a font descriptor
+ * @return pointer to the new lookup tables or NULL on out of memory
+ */
+static lookup_t * lookup_create(lv_font_fmt_txt_dsc_t * fdsc)
+{
+    lookup_t * lookup = lv_mem_alloc(sizeof(lookup_t));
+    LV_ASSERT_MEM(lookup);
+    if(lookup == NULL) return NULL;
+    _lv_memset_00(lookup, sizeof(lookup_t));
+    lookup->dsc = fdsc;
+
+    lookup->cmaps = lv_mem_alloc(sizeof(lookup_cmap_t) * fdsc->cmap_num);
+    LV_ASSERT_MEM(lookup->cmaps);
+    if(lookup->cmaps == NULL) {
+        lookup_free(lookup);
+        return NULL;
+    }
+    _lv_memset_00(lookup->cmaps, sizeof(lookup_cmap_t) * fdsc->cmap_num);
+
+    /*Only the sparse cmaps need tables. In the others the ID is calculated from the code point directly*/
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->type != LV_FONT_FMT_TXT_CMAP_SPARSE_TINY && cmap->type != LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) continue;
+
+        uint16_t block_cnt = cmap->range_length / LOOKUP_BLOCK_SIZE + 1;
+        lookup->cmaps[i].blocks = lv_mem_alloc(sizeof(uint16_t *) * block_cnt);
+        LV_ASSERT_MEM(lookup->cmaps[i].blocks);
+        if(lookup->cmaps[i].blocks == NULL) {
+            lookup_free(lookup);
+            return NULL;
+        }
+        _lv_memset_00(lookup->cmaps[i].blocks, sizeof(uint16_t *) * block_cnt);
+        lookup->cmaps[i].block_cnt = block_cnt;
+    }
+
+    /*The kerning classes are already a direct lookup*/
+    if(fdsc->kern_dsc && fdsc->kern_classes == 0) {
+        lookup->kern = lv_mem_alloc(sizeof(uint32_t) * LOOKUP_KERN_CNT);
+        LV_ASSERT_MEM(lookup->kern);
+        if(lookup->kern == NULL) {
+            lookup_free(lookup);
+            return NULL;
+        }
+        _lv_memset_00(lookup->kern, sizeof(uint32_t) * LOOKUP_KERN_CNT);
+    }
+
+    lookup->next = LV_GC_ROOT(_lv_font_lookup_list);
+    LV_GC_ROOT(_lv_font_lookup_list) = lookup;
+
+    return lookup;
+}
+
+/**
+ * Get the block of glyph IDs which contains a code point of a sparse cmap.
+ * The block is filled on the first use.
+ * @param fdsc pointer to a font descriptor
+ * @param cmap_id index of the cmap
+ * @param rcp the code point relative to the start of the cmap's range (less than `range_length`)
+ * @return pointer to the `LOOKUP_BLOCK_SIZE` glyph IDs of the block or NULL if the cmap has no table
+ */
+static const uint16_t * lookup_get_block(lv_font_fmt_txt_dsc_t * fdsc, uint16_t cmap_id, uint32_t rcp)
+{
+    lookup_t * lookup = lookup_get(fdsc);
+    if(lookup == NULL) return NULL;
+
+    uint16_t ** blocks = lookup->cmaps[cmap_id].blocks;
+    if(blocks == NULL) return NULL;
+
+    uint32_t block_id = rcp / LOOKUP_BLOCK_SIZE;
+    if(blocks[block_id]) return blocks[block_id];
+
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_lock();
+#endif
+    if(blocks[block_id] == NULL) {
+        uint16_t * block = lv_mem_alloc(sizeof(uint16_t) * LOOKUP_BLOCK_SIZE);
+        LV_ASSERT_MEM(block);
+        if(block) {
+            const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[cmap_id];
+            uint32_t rcp_first = block_id * LOOKUP_BLOCK_SIZE;
+            uint32_t i;
+            for(i = 0; i < LOOKUP_BLOCK_SIZE; i++) {
+                /*The code points after the range are never looked up in this cmap*/
+                if(rcp_first + i >= cmap->range_length) block[i] = 0;
+                else block[i] = cmap_get_glyph_id(cmap, rcp_first + i);
+            }
+
+            /*Publish the block only when it's filled*/
+            blocks[block_id] = block;
+        }
+    }
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_unlock();
+#endif
+
+    return blocks[block_id];
+}
+
+/**
+ * Free the lookup tables. They should be already unlinked from the font.
+ * @param lookup pointer to lookup tables
+ */
+static void lookup_free(lookup_t * lookup)
+{
+    if(lookup->cmaps) {
+        uint16_t i;
+        for(i = 0; i < lookup->dsc->cmap_num; i++) {
+            uint16_t ** blocks = lookup->cmaps[i].blocks;
+            if(blocks == NULL) continue;
+
+            uint16_t b;
+            for(b = 0; b < lookup->cmaps[i].block_cnt; b++) {
+                if(blocks[b]) lv_mem_free(blocks[b]);
+            }
+            lv_mem_free(blocks);
+        }
+        lv_mem_free(lookup->cmaps);
+    }
+
+    if(lookup->kern) lv_mem_free(lookup->kern);
+    lv_mem_free(lookup);
+}
+#endif /*LV_USE_FONT_LOOKUP_TABLES*/
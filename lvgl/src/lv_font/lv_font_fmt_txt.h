@@ -26,6 +26,8 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+struct _lv_font_fmt_txt_lookup_t;
+
 /** This describes a glyph. */
 typedef struct {
 #if LV_FONT_FMT_TXT_LARGE == 0
@@ -190,12 +192,34 @@ typedef struct {
      */
     uint16_t bitmap_format  : 2;
 
+    /* If `glyph_bitmap` is NULL the bitmaps are read on demand with this function (e.g. `lv_font_load_lazy()`).
+     * It should return the bitmap of a glyph in the same format as it'd be stored in `glyph_bitmap`.
+     * The returned data has to be valid until the next call from the same thread.*/
+    const uint8_t * (*get_bitmap_data_cb)(const lv_font_t * font, uint32_t glyph_id);
+
     /*Cache the last letter and is glyph id*/
     uint32_t last_letter;
     uint32_t last_glyph_id;
 
+#if LV_USE_FONT_LOOKUP_TABLES
+    /*Tables to find the glyph IDs and the kerning values faster.
+     *Built on the first use of the font, initialize to NULL*/
+    struct _lv_font_fmt_txt_lookup_t * lookup;
+#endif
+
 } lv_font_fmt_txt_dsc_t;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+/** Statistics of the glyph cache of compressed fonts*/
+typedef struct {
+    uint32_t hit_cnt;       /**< The glyph was found in the cache*/
+    uint32_t miss_cnt;      /**< The glyph was decompressed*/
+    uint32_t evict_cnt;     /**< A glyph was removed to make room for an other*/
+    uint32_t size;          /**< Size of the cached glyphs in bytes*/
+    uint16_t glyph_cnt;     /**< Number of cached glyphs*/
+} lv_font_glyph_cache_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -224,6 +248,39 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+#if LV_USE_FONT_LOOKUP_TABLES
+/**
+ * Free the lookup tables of a font. Should be called before the font is deleted or modified
+ * (and not while it's being drawn). The tables are built again on the next use of the font.
+ * @param font pointer to a font
+ */
+void lv_font_fmt_txt_free_lookup(const lv_font_t * font);
+
+/**
+ * Free the lookup tables of all fonts. Called from `lv_deinit()`.
+ */
+void _lv_font_fmt_txt_free_lookup_all(void);
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+/**
+ * Drop all glyphs from the glyph caches. Should be called if a font is deleted or modified.
+ * The caches of the rendering threads are cleared before their next use.
+ */
+void lv_font_glyph_cache_clear(void);
+
+/**
+ * Get the statistics of the glyph cache of the calling thread
+ * @param stat store the statistics here
+ */
+void lv_font_glyph_cache_get_stat(lv_font_glyph_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and eviction counters of the glyph cache of the calling thread
+ */
+void lv_font_glyph_cache_reset_stat(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -12,8 +12,13 @@
 
 #include "../lvgl.h"
 #include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_gc.h"
 #include "lv_font_loader.h"
 
+#if defined(LV_GC_INCLUDE)
+    #include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
 #if LV_USE_FILESYSTEM
 
 
@@ -61,12 +66,31 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+typedef struct {
+    uint8_t * data;         /*The bitmap of the glyph as stored in the font*/
+    uint32_t gid;           /*ID of the cached glyph. 0: unused entry*/
+} lazy_cache_entry_t;
+
+/*Descriptor of the fonts loaded with `lv_font_load_lazy()`*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;  /*Has to be the first member*/
+    lv_fs_file_t file;          /*The font file is kept open to read the bitmaps*/
+    uint32_t * glyph_pos;       /*Position of the glyphs in the file. `glyph_cnt + 1` elements, the last is the end*/
+    uint32_t glyph_cnt;
+    lazy_cache_entry_t * cache; /*The bitmaps are cached in the `gid % cache_cnt` entry*/
+    uint16_t cache_cnt;
+    uint8_t bitmap_ofs;         /*The bitmaps start after this many bytes from the glyphs' position...*/
+    uint8_t bitmap_shift;       /*...and this many bits*/
+} lazy_font_dsc_t;
+
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy);
+static const uint8_t * lazy_get_bitmap_data(const lv_font_t * font, uint32_t gid);
+static const uint8_t * lazy_cache_get(lazy_font_dsc_t * lazy, uint32_t gid, uint32_t * size);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -97,7 +121,7 @@ lv_font_t * lv_font_load(const char * font_name)
     lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
 
     if(res == LV_FS_RES_OK) {
-        success = lvgl_load_font(&file, font);
+        success = lvgl_load_font(&file, font, false);
     }
 
     if(!success) {
@@ -116,6 +140,53 @@ lv_font_t * lv_font_load(const char * font_name)
     return font;
 }
 
+/**
+ * Loads a `lv_font_t` object from a binary font file but keeps only the character maps,
+ * the glyph descriptors and the kerning values in the memory.
+ * The bitmaps of the glyphs are read from the file when they are drawn and the last ones are cached.
+ * The file is kept open until `lv_font_free()`.
+ * @param font_name filename where the font file is located
+ * @param cache_cnt number of glyph bitmaps to cache
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name, uint16_t cache_cnt)
+{
+    bool success = false;
+    if(cache_cnt == 0) cache_cnt = 1;
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    memset(font, 0, sizeof(lv_font_t));
+
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+
+    if(res == LV_FS_RES_OK) {
+        success = lvgl_load_font(&file, font, true);
+    }
+
+    if(success) {
+        lazy_font_dsc_t * lazy = (lazy_font_dsc_t *) font->dsc;
+        lazy->cache = lv_mem_alloc(sizeof(lazy_cache_entry_t) * cache_cnt);
+        if(lazy->cache) {
+            memset(lazy->cache, 0, sizeof(lazy_cache_entry_t) * cache_cnt);
+            lazy->cache_cnt = cache_cnt;
+            lazy->file = file;
+        }
+        else {
+            success = false;
+        }
+    }
+
+    if(!success) {
+        LV_LOG_WARN("Error loading font file: %s\n", font_name);
+        lv_font_free(font);
+        font = NULL;
+        lv_fs_close(&file);
+    }
+
+    return font;
+}
+
 
 /**
  * Frees the memory allocated by the `lv_font_load()` function
@@ -124,9 +195,31 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+        /*The cached glyphs of the font can't be used anymore*/
+        lv_font_glyph_cache_clear();
+#endif
+
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
         if(NULL != dsc) {
+#if LV_USE_FONT_LOOKUP_TABLES
+            lv_font_fmt_txt_free_lookup(font);
+#endif
+
+            if(dsc->get_bitmap_data_cb == lazy_get_bitmap_data) {
+                lazy_font_dsc_t * lazy = (lazy_font_dsc_t *) dsc;
+                if(lazy->file.file_d) lv_fs_close(&lazy->file);
+
+                if(lazy->cache) {
+                    for(uint16_t i = 0; i < lazy->cache_cnt; i++) {
+                        if(lazy->cache[i].data) lv_mem_free(lazy->cache[i].data);
+                    }
+                    lv_mem_free(lazy->cache);
+                }
+
+                if(lazy->glyph_pos) lv_mem_free(lazy->glyph_pos);
+            }
 
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
@@ -360,7 +453,7 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
 }
 
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header, bool lazy)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
@@ -438,6 +531,30 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
     }
 
+    /*Remember only where the bitmaps are in the file*/
+    if(lazy) {
+        lazy_font_dsc_t * lazy_dsc = (lazy_font_dsc_t *) font_dsc;
+        uint32_t * glyph_pos = lv_mem_alloc(sizeof(uint32_t) * (loca_count + 1));
+        if(glyph_pos == NULL) {
+            return -1;
+        }
+
+        lazy_dsc->glyph_pos = glyph_pos;
+        lazy_dsc->glyph_cnt = loca_count;
+
+        for(unsigned int i = 0; i < loca_count; ++i) {
+            glyph_pos[i] = start + glyph_offset[i];
+            glyph_dsc[i].bitmap_index = 0;
+        }
+        glyph_pos[loca_count] = start + glyph_length - 1;
+
+        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+        lazy_dsc->bitmap_ofs = nbits / 8;
+        lazy_dsc->bitmap_shift = nbits % 8;
+
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *) lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -488,14 +605,16 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+    /*The descriptor of the lazy fonts has some extra fields*/
+    uint32_t dsc_size = lazy ? sizeof(lazy_font_dsc_t) : sizeof(lv_font_fmt_txt_dsc_t);
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *) lv_mem_alloc(dsc_size);
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, dsc_size);
 
     font->dsc = font_dsc;
+    if(lazy) font_dsc->get_bitmap_data_cb = lazy_get_bitmap_data;
 
     /* header */
     int32_t header_length = read_label(fp, 0, "head");
@@ -572,7 +691,7 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     /* glyph */
     uint32_t glyph_start = loca_start + loca_length;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header, lazy);
 
     lv_mem_free(glyph_offset);
 
@@ -690,5 +809,94 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
     return kern_length;
 }
 
+/**
+ * Read the bitmap of a glyph of a font loaded with `lv_font_load_lazy()`.
+ * Used as `get_bitmap_data_cb`.
+ * @param font pointer to the font
+ * @param gid ID of the glyph
+ * @return the bitmap as it's stored in the font or NULL on error.
+ *         Valid until the next call from the same thread.
+ */
+static const uint8_t * lazy_get_bitmap_data(const lv_font_t * font, uint32_t gid)
+{
+    static const uint8_t empty_bitmap = 0;
+
+    lazy_font_dsc_t * lazy = (lazy_font_dsc_t *) font->dsc;
+    if(gid >= lazy->glyph_cnt) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &lazy->dsc.glyph_dsc[gid];
+    if(gdsc->box_w * gdsc->box_h == 0) return &empty_bitmap;
+
+    /*The file system and the cache are shared by the rendering threads*/
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_lock();
+#endif
+
+    uint32_t size;
+    const uint8_t * data = lazy_cache_get(lazy, gid, &size);
+
+#if LV_USE_REFR_THREADS
+    /*An other thread might replace the cache entry while the bitmap is used so return a copy*/
+    if(data) {
+        if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_bitmap_buf)) < size) {
+            uint8_t * buf = lv_mem_realloc(LV_GC_ROOT(_lv_font_bitmap_buf), size);
+            LV_ASSERT_MEM(buf);
+            if(buf) LV_GC_ROOT(_lv_font_bitmap_buf) = buf;
+        }
+
+        if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_bitmap_buf)) >= size) {
+            _lv_memcpy(LV_GC_ROOT(_lv_font_bitmap_buf), data, size);
+            data = LV_GC_ROOT(_lv_font_bitmap_buf);
+        }
+        else {
+            data = NULL;
+        }
+    }
+
+    _lv_refr_draw_unlock();
+#endif
+
+    return data;
+}
+
+/**
+ * Get the bitmap of a glyph from the cache of a lazy font or read it from the file
+ * @param lazy pointer to the descriptor of a lazy font
+ * @param gid ID of the glyph
+ * @param size store the size of the bitmap here
+ * @return the bitmap or NULL if it couldn't be read
+ */
+static const uint8_t * lazy_cache_get(lazy_font_dsc_t * lazy, uint32_t gid, uint32_t * size)
+{
+    lazy_cache_entry_t * e = &lazy->cache[gid % lazy->cache_cnt];
+    *size = lazy->glyph_pos[gid + 1] - lazy->glyph_pos[gid] - lazy->bitmap_ofs;
+    if(e->gid == gid) return e->data;
+
+    /*Read one more byte if the bitmap doesn't start at a byte boundary*/
+    e->gid = 0;
+    uint32_t read_size = *size + (lazy->bitmap_shift ? 1 : 0);
+    uint8_t * data = lv_mem_realloc(e->data, read_size);
+    LV_ASSERT_MEM(data);
+    if(data == NULL) return NULL;
+    e->data = data;
+
+    uint32_t br = 0;
+    if(lv_fs_seek(&lazy->file, lazy->glyph_pos[gid] + lazy->bitmap_ofs) != LV_FS_RES_OK ||
+       lv_fs_read(&lazy->file, data, read_size, &br) != LV_FS_RES_OK || br != read_size) {
+        LV_LOG_WARN("Error reading the bitmap of glyph %d", gid);
+        return NULL;
+    }
+
+    if(lazy->bitmap_shift) {
+        uint8_t shift = lazy->bitmap_shift;
+        for(uint32_t i = 0; i < *size; i++) {
+            data[i] = (data[i] << shift) | (data[i + 1] >> (8 - shift));
+        }
+    }
+
+    e->gid = gid;
+    return data;
+}
+
 #endif /*LV_USE_FILESYSTEM*/
 
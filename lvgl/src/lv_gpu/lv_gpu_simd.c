@@ -0,0 +1,730 @@
+/**
+ * @file lv_gpu_simd.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_gpu_simd.h"
+#include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_mem.h"
+
+#if LV_GPU_SIMD_ENABLED
+
+#if defined(LV_GPU_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(LV_GPU_SIMD_SSE2)
+    #include <emmintrin.h>
+#elif defined(LV_GPU_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels processed by one vector*/
+#define PX_PER_VEC      ((int32_t)(sizeof(vec_t) / sizeof(lv_color_t)))
+
+/*Number of 8 bit channels processed by one vector (one lane each)*/
+#define CH_PER_VEC      ((int32_t)(sizeof(vec_t) / sizeof(uint16_t)))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A vector of 16 bit lanes. RGB565 pixels take one lane, ARGB8888 pixels take two lanes.*/
+#if defined(LV_GPU_SIMD_AVX2)
+typedef __m256i vec_t;
+#elif defined(LV_GPU_SIMD_SSE2)
+typedef __m128i vec_t;
+#elif defined(LV_GPU_SIMD_NEON)
+typedef uint16x8_t vec_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*Shifts need immediate operands so they are macros*/
+#if defined(LV_GPU_SIMD_AVX2)
+#define V_SRL16(v, n)   _mm256_srli_epi16(v, n)
+#define V_SLL16(v, n)   _mm256_slli_epi16(v, n)
+#elif defined(LV_GPU_SIMD_SSE2)
+#define V_SRL16(v, n)   _mm_srli_epi16(v, n)
+#define V_SLL16(v, n)   _mm_slli_epi16(v, n)
+#elif defined(LV_GPU_SIMD_NEON)
+#define V_SRL16(v, n)   vshrq_n_u16(v, n)
+#define V_SLL16(v, n)   vshlq_n_u16(v, n)
+#endif
+
+/**********************
+ *   VECTOR PRIMITIVES
+ **********************/
+
+#if defined(LV_GPU_SIMD_AVX2)
+
+static inline vec_t v_load(const void * p)
+{
+    return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline void v_store(void * p, vec_t v)
+{
+    _mm256_storeu_si256((__m256i *)p, v);
+}
+
+static inline vec_t v_set16(uint16_t x)
+{
+    return _mm256_set1_epi16((short)x);
+}
+
+static inline vec_t v_set32(uint32_t x)
+{
+    return _mm256_set1_epi32((int)x);
+}
+
+static inline vec_t v_and(vec_t a, vec_t b)
+{
+    return _mm256_and_si256(a, b);
+}
+
+static inline vec_t v_or(vec_t a, vec_t b)
+{
+    return _mm256_or_si256(a, b);
+}
+
+static inline vec_t v_add16(vec_t a, vec_t b)
+{
+    return _mm256_add_epi16(a, b);
+}
+
+static inline vec_t v_sub16(vec_t a, vec_t b)
+{
+    return _mm256_sub_epi16(a, b);
+}
+
+static inline vec_t v_mul16(vec_t a, vec_t b)
+{
+    return _mm256_mullo_epi16(a, b);
+}
+
+static inline vec_t v_mulhi16(vec_t a, vec_t b)
+{
+    return _mm256_mulhi_epu16(a, b);
+}
+
+static inline vec_t v_cmpeq16(vec_t a, vec_t b)
+{
+    return _mm256_cmpeq_epi16(a, b);
+}
+
+/*Lanes are 0..255 so the signed compare is fine*/
+static inline vec_t v_cmpge16(vec_t a, vec_t b)
+{
+    return _mm256_or_si256(_mm256_cmpgt_epi16(a, b), _mm256_cmpeq_epi16(a, b));
+}
+
+static inline vec_t v_select(vec_t sel, vec_t a, vec_t b)
+{
+    return _mm256_blendv_epi8(b, a, sel);
+}
+
+/*Same as `LV_MATH_UDIV255` for 0..65535*/
+static inline vec_t v_udiv255(vec_t x)
+{
+    return _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16((short)0x8081)), 7);
+}
+
+/*Load one mask value for each pixel*/
+static inline vec_t v_load_mask(const lv_opa_t * mask)
+{
+#if LV_COLOR_DEPTH == 16
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)mask));
+#else
+    __m256i m = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)mask));
+    return _mm256_or_si256(m, _mm256_slli_epi32(m, 16));
+#endif
+}
+
+/*Load `CH_PER_VEC` 8 bit values into the lanes*/
+static inline vec_t v_load_u8(const uint8_t * p)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)p));
+}
+
+/*Store the lanes (0..255) as 8 bit values*/
+static inline void v_store_u8(uint8_t * p, vec_t v)
+{
+    /*The packing works in the 128 bit halves so bring the two results together*/
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08);
+    _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(packed));
+}
+
+#elif defined(LV_GPU_SIMD_SSE2)
+
+static inline vec_t v_load(const void * p)
+{
+    return _mm_loadu_si128((const __m128i *)p);
+}
+
+static inline void v_store(void * p, vec_t v)
+{
+    _mm_storeu_si128((__m128i *)p, v);
+}
+
+static inline vec_t v_set16(uint16_t x)
+{
+    return _mm_set1_epi16((short)x);
+}
+
+static inline vec_t v_set32(uint32_t x)
+{
+    return _mm_set1_epi32((int)x);
+}
+
+static inline vec_t v_and(vec_t a, vec_t b)
+{
+    return _mm_and_si128(a, b);
+}
+
+static inline vec_t v_or(vec_t a, vec_t b)
+{
+    return _mm_or_si128(a, b);
+}
+
+static inline vec_t v_add16(vec_t a, vec_t b)
+{
+    return _mm_add_epi16(a, b);
+}
+
+static inline vec_t v_sub16(vec_t a, vec_t b)
+{
+    return _mm_sub_epi16(a, b);
+}
+
+static inline vec_t v_mul16(vec_t a, vec_t b)
+{
+    return _mm_mullo_epi16(a, b);
+}
+
+static inline vec_t v_mulhi16(vec_t a, vec_t b)
+{
+    return _mm_mulhi_epu16(a, b);
+}
+
+static inline vec_t v_cmpeq16(vec_t a, vec_t b)
+{
+    return _mm_cmpeq_epi16(a, b);
+}
+
+/*Lanes are 0..255 so the signed compare is fine*/
+static inline vec_t v_cmpge16(vec_t a, vec_t b)
+{
+    return _mm_or_si128(_mm_cmpgt_epi16(a, b), _mm_cmpeq_epi16(a, b));
+}
+
+static inline vec_t v_select(vec_t sel, vec_t a, vec_t b)
+{
+    return _mm_or_si128(_mm_and_si128(sel, a), _mm_andnot_si128(sel, b));
+}
+
+/*Same as `LV_MATH_UDIV255` for 0..65535*/
+static inline vec_t v_udiv255(vec_t x)
+{
+    return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16((short)0x8081)), 7);
+}
+
+/*Load one mask value for each pixel*/
+static inline vec_t v_load_mask(const lv_opa_t * mask)
+{
+#if LV_COLOR_DEPTH == 16
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+#else
+    uint32_t m32;
+    _lv_memcpy_small(&m32, mask, sizeof(m32));
+    __m128i m = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)m32), _mm_setzero_si128());
+    return _mm_unpacklo_epi16(m, m);
+#endif
+}
+
+/*Load `CH_PER_VEC` 8 bit values into the lanes*/
+static inline vec_t v_load_u8(const uint8_t * p)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+}
+
+/*Store the lanes (0..255) as 8 bit values*/
+static inline void v_store_u8(uint8_t * p, vec_t v)
+{
+    _mm_storel_epi64((__m128i *)p, _mm_packus_epi16(v, v));
+}
+
+#elif defined(LV_GPU_SIMD_NEON)
+
+static inline vec_t v_load(const void * p)
+{
+    return vld1q_u16((const uint16_t *)p);
+}
+
+static inline void v_store(void * p, vec_t v)
+{
+    vst1q_u16((uint16_t *)p, v);
+}
+
+static inline vec_t v_set16(uint16_t x)
+{
+    return vdupq_n_u16(x);
+}
+
+static inline vec_t v_set32(uint32_t x)
+{
+    return vreinterpretq_u16_u32(vdupq_n_u32(x));
+}
+
+static inline vec_t v_and(vec_t a, vec_t b)
+{
+    return vandq_u16(a, b);
+}
+
+static inline vec_t v_or(vec_t a, vec_t b)
+{
+    return vorrq_u16(a, b);
+}
+
+static inline vec_t v_add16(vec_t a, vec_t b)
+{
+    return vaddq_u16(a, b);
+}
+
+static inline vec_t v_sub16(vec_t a, vec_t b)
+{
+    return vsubq_u16(a, b);
+}
+
+static inline vec_t v_mul16(vec_t a, vec_t b)
+{
+    return vmulq_u16(a, b);
+}
+
+static inline vec_t v_mulhi16(vec_t a, vec_t b)
+{
+    uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(a), vget_low_u16(b)), 16);
+    uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(a), vget_high_u16(b)), 16);
+    return vcombine_u16(lo, hi);
+}
+
+static inline vec_t v_cmpeq16(vec_t a, vec_t b)
+{
+    return vceqq_u16(a, b);
+}
+
+static inline vec_t v_cmpge16(vec_t a, vec_t b)
+{
+    return vcgeq_u16(a, b);
+}
+
+static inline vec_t v_select(vec_t sel, vec_t a, vec_t b)
+{
+    return vbslq_u16(sel, a, b);
+}
+
+/*Same as `LV_MATH_UDIV255` for 0..65408*/
+static inline vec_t v_udiv255(vec_t x)
+{
+    return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+/*Load one mask value for each pixel*/
+static inline vec_t v_load_mask(const lv_opa_t * mask)
+{
+#if LV_COLOR_DEPTH == 16
+    return vmovl_u8(vld1_u8(mask));
+#else
+    uint32_t m32;
+    _lv_memcpy_small(&m32, mask, sizeof(m32));
+    uint16x8_t m = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(m32)));
+    return vzipq_u16(m, m).val[0];
+#endif
+}
+
+/*Load `CH_PER_VEC` 8 bit values into the lanes*/
+static inline vec_t v_load_u8(const uint8_t * p)
+{
+    return vmovl_u8(vld1_u8(p));
+}
+
+/*Store the lanes (0..255) as 8 bit values*/
+static inline void v_store_u8(uint8_t * p, vec_t v)
+{
+    vst1_u8(p, vmovn_u16(v));
+}
+
+#endif
+
+/**
+ * Mix two vectors of pixels. The same as `lv_color_mix` on every pixel.
+ * @param fg foreground pixels
+ * @param bg background pixels
+ * @param mix mix ratio of each pixel (one lane per channel group)
+ * @return the mixed pixels
+ */
+static inline vec_t v_color_mix(vec_t fg, vec_t bg, vec_t mix)
+{
+    vec_t mix_inv = v_sub16(v_set16(255), mix);
+#if LV_COLOR_DEPTH == 16
+    vec_t ofs = v_set16(LV_COLOR_MIX_ROUND_OFS);
+    vec_t mask5 = v_set16(0x1F);
+    vec_t mask6 = v_set16(0x3F);
+
+    vec_t r = v_add16(v_add16(v_mul16(V_SRL16(fg, 11), mix), v_mul16(V_SRL16(bg, 11), mix_inv)), ofs);
+    vec_t g = v_add16(v_add16(v_mul16(v_and(V_SRL16(fg, 5), mask6), mix),
+                              v_mul16(v_and(V_SRL16(bg, 5), mask6), mix_inv)), ofs);
+    vec_t b = v_add16(v_add16(v_mul16(v_and(fg, mask5), mix), v_mul16(v_and(bg, mask5), mix_inv)), ofs);
+
+    r = V_SLL16(v_udiv255(r), 11);
+    g = V_SLL16(v_udiv255(g), 5);
+    b = v_udiv255(b);
+
+    return v_or(v_or(r, g), b);
+#else
+    /*The 16 bit lanes of a pixel are [B|G<<8, R|A<<8] so the low and high bytes give [B, R] and [G, A]*/
+    vec_t mask8 = v_set16(0xFF);
+    vec_t br = v_add16(v_mul16(v_and(fg, mask8), mix), v_mul16(v_and(bg, mask8), mix_inv));
+    vec_t ga = v_add16(v_mul16(V_SRL16(fg, 8), mix), v_mul16(V_SRL16(bg, 8), mix_inv));
+#if LV_COLOR_MIX_ROUND_OFS
+    br = v_add16(br, v_set16(LV_COLOR_MIX_ROUND_OFS));
+    ga = v_add16(ga, v_set16(LV_COLOR_MIX_ROUND_OFS));
+#endif
+
+    br = v_udiv255(br);
+    ga = V_SLL16(v_udiv255(ga), 8);
+
+    /*Like `lv_color_mix` set the alpha channel to 0xFF*/
+    return v_or(v_or(br, ga), v_set32(0xFF000000));
+#endif
+}
+
+/**
+ * Tell whether a mask is fully transparent or fully opaque in the range of a vector
+ * @param mask pointer to `PX_PER_VEC` mask values
+ * @return LV_OPA_TRANSP, LV_OPA_COVER or LV_OPA_50 if the values are mixed
+ */
+static inline lv_opa_t mask_get_vec_state(const lv_opa_t * mask)
+{
+    uint32_t m32[(PX_PER_VEC + 3) / 4];
+    _lv_memcpy_small(m32, mask, PX_PER_VEC);
+
+    uint32_t all_or = 0;
+    uint32_t all_and = 0xFFFFFFFF;
+    uint32_t i;
+    for(i = 0; i < sizeof(m32) / sizeof(m32[0]); i++) {
+        all_or |= m32[i];
+        all_and &= m32[i];
+    }
+
+    if(all_or == 0) return LV_OPA_TRANSP;
+    else if(all_and == 0xFFFFFFFF) return LV_OPA_COVER;
+    else return LV_OPA_50;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the name of the instruction set used by the SIMD blend kernels
+ * @return "AVX2", "SSE2" or "NEON"
+ */
+const char * lv_gpu_simd_get_isa(void)
+{
+#if defined(LV_GPU_SIMD_AVX2)
+    return "AVX2";
+#elif defined(LV_GPU_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "NEON";
+#endif
+}
+
+/**
+ * Fill an area in the buffer with a color
+ * @param buf a buffer which should be filled
+ * @param buf_w width of the buffer in pixels
+ * @param color fill color
+ * @param fill_w width to fill in pixels (<= buf_w)
+ * @param fill_h height to fill in pixels
+ * @note `buf_w - fill_w` is offset to the next line after fill
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_simd_fill(lv_color_t * buf, lv_coord_t buf_w, lv_color_t color,
+                                            lv_coord_t fill_w, lv_coord_t fill_h)
+{
+#if LV_COLOR_DEPTH == 16
+    vec_t c = v_set16(color.full);
+#else
+    vec_t c = v_set32(color.full);
+#endif
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < fill_h; y++) {
+        for(x = 0; x <= fill_w - PX_PER_VEC; x += PX_PER_VEC) {
+            v_store(&buf[x], c);
+        }
+        for(; x < fill_w; x++) buf[x] = color;
+
+        buf += buf_w;
+    }
+}
+
+/**
+ * Fill an area in the buffer with a color with a given opacity
+ * @param buf a buffer which should be filled
+ * @param buf_w width of the buffer in pixels
+ * @param color fill color
+ * @param opa opacity of the color (< LV_OPA_MAX)
+ * @param fill_w width to fill in pixels (<= buf_w)
+ * @param fill_h height to fill in pixels
+ * @note `buf_w - fill_w` is offset to the next line after fill
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_simd_fill_opa(lv_color_t * buf, lv_coord_t buf_w, lv_color_t color, lv_opa_t opa,
+                                                lv_coord_t fill_w, lv_coord_t fill_h)
+{
+#if LV_COLOR_DEPTH == 16
+    vec_t c = v_set16(color.full);
+#else
+    vec_t c = v_set32(color.full);
+#endif
+    vec_t mix = v_set16(opa);
+
+    uint16_t color_premult[3];
+    lv_color_premult(color, opa, color_premult);
+    lv_opa_t opa_inv = 255 - opa;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < fill_h; y++) {
+        for(x = 0; x <= fill_w - PX_PER_VEC; x += PX_PER_VEC) {
+            v_store(&buf[x], v_color_mix(c, v_load(&buf[x]), mix));
+        }
+        for(; x < fill_w; x++) buf[x] = lv_color_mix_premult(color_premult, buf[x], opa_inv);
+
+        buf += buf_w;
+    }
+}
+
+/**
+ * Fill an area in the buffer with a color but take into account a mask which describes the opacity of each pixel
+ * @param buf a buffer which should be filled using a mask
+ * @param buf_w width of the buffer in pixels
+ * @param color fill color
+ * @param mask 0..255 values describing the opacity of the corresponding pixel. It's width is `fill_w`
+ * @param opa overall opacity. 255 in `mask` should mean this opacity.
+ * @param fill_w width to fill in pixels (<= buf_w)
+ * @param fill_h height to fill in pixels
+ * @note `buf_w - fill_w` is offset to the next line after fill
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_simd_fill_mask(lv_color_t * buf, lv_coord_t buf_w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa,
+                                                 lv_coord_t fill_w, lv_coord_t fill_h)
+{
+#if LV_COLOR_DEPTH == 16
+    vec_t c = v_set16(color.full);
+#else
+    vec_t c = v_set32(color.full);
+#endif
+    vec_t zero = v_set16(0);
+    vec_t cover = v_set16(LV_OPA_COVER);
+    vec_t opa_v = v_set16(opa);
+    bool opa_full = opa > LV_OPA_MAX ? true : false;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < fill_h; y++) {
+        for(x = 0; x <= fill_w - PX_PER_VEC; x += PX_PER_VEC) {
+            lv_opa_t state = mask_get_vec_state(&mask[x]);
+            if(state == LV_OPA_TRANSP) continue;
+            if(state == LV_OPA_COVER && opa_full) {
+                v_store(&buf[x], c);
+                continue;
+            }
+
+            vec_t m = v_load_mask(&mask[x]);
+            vec_t bg = v_load(&buf[x]);
+            vec_t res;
+            if(opa_full) {
+                res = v_color_mix(c, bg, m);
+                res = v_select(v_cmpeq16(m, cover), c, res);
+            }
+            else {
+                vec_t opa_tmp = V_SRL16(v_mul16(m, opa_v), 8);
+                opa_tmp = v_select(v_cmpeq16(m, cover), opa_v, opa_tmp);
+                res = v_color_mix(c, bg, opa_tmp);
+            }
+            v_store(&buf[x], v_select(v_cmpeq16(m, zero), bg, res));
+        }
+
+        for(; x < fill_w; x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            if(opa_full) {
+                if(mask[x] == LV_OPA_COVER) buf[x] = color;
+                else buf[x] = lv_color_mix(color, buf[x], mask[x]);
+            }
+            else {
+                lv_opa_t opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+                buf[x] = lv_color_mix(color, buf[x], opa_tmp);
+            }
+        }
+
+        buf += buf_w;
+        mask += fill_w;
+    }
+}
+
+/**
+ * Blend a map (e.g. RGB image with opacity) to a buffer
+ * @param buf a buffer where `map` should be blended
+ * @param buf_w width of the buffer in pixels
+ * @param map an "image" to blend
+ * @param map_w width of the map in pixels
+ * @param opa opacity of `map` (< LV_OPA_MAX)
+ * @param copy_w width of the area to blend in pixels (<= buf_w)
+ * @param copy_h height of the area to blend in pixels
+ * @note `map_w - copy_w` is offset to the next line after blend
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_simd_blend(lv_color_t * buf, lv_coord_t buf_w, const lv_color_t * map,
+                                             lv_coord_t map_w, lv_opa_t opa,
+                                             lv_coord_t copy_w, lv_coord_t copy_h)
+{
+    vec_t mix = v_set16(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < copy_h; y++) {
+        for(x = 0; x <= copy_w - PX_PER_VEC; x += PX_PER_VEC) {
+            v_store(&buf[x], v_color_mix(v_load(&map[x]), v_load(&buf[x]), mix));
+        }
+        for(; x < copy_w; x++) buf[x] = lv_color_mix(map[x], buf[x], opa);
+
+        buf += buf_w;
+        map += map_w;
+    }
+}
+
+/**
+ * Blend a map to a buffer but take into account a mask which describes the opacity of each pixel
+ * (e.g. the alpha channel of an ARGB image or an anti-aliased edge)
+ * @param buf a buffer where `map` should be blended
+ * @param buf_w width of the buffer in pixels
+ * @param map an "image" to blend
+ * @param map_w width of the map in pixels
+ * @param mask 0..255 values describing the opacity of the corresponding pixel. It's width is `copy_w`
+ * @param opa overall opacity. 255 in `mask` should mean this opacity.
+ * @param copy_w width of the area to blend in pixels (<= buf_w)
+ * @param copy_h height of the area to blend in pixels
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_simd_blend_mask(lv_color_t * buf, lv_coord_t buf_w, const lv_color_t * map,
+                                                  lv_coord_t map_w, const lv_opa_t * mask, lv_opa_t opa,
+                                                  lv_coord_t copy_w, lv_coord_t copy_h)
+{
+    vec_t zero = v_set16(0);
+    vec_t cover = v_set16(LV_OPA_COVER);
+    vec_t opa_max = v_set16(LV_OPA_MAX);
+    vec_t opa_v = v_set16(opa);
+    bool opa_full = opa > LV_OPA_MAX ? true : false;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < copy_h; y++) {
+        for(x = 0; x <= copy_w - PX_PER_VEC; x += PX_PER_VEC) {
+            lv_opa_t state = mask_get_vec_state(&mask[x]);
+            if(state == LV_OPA_TRANSP) continue;
+
+            vec_t fg = v_load(&map[x]);
+            if(state == LV_OPA_COVER && opa_full) {
+                v_store(&buf[x], fg);
+                continue;
+            }
+
+            vec_t m = v_load_mask(&mask[x]);
+            vec_t bg = v_load(&buf[x]);
+            vec_t res;
+            if(opa_full) {
+                res = v_color_mix(fg, bg, m);
+                res = v_select(v_cmpeq16(m, cover), fg, res);
+            }
+            else {
+                vec_t opa_tmp = V_SRL16(v_mul16(m, opa_v), 8);
+                opa_tmp = v_select(v_cmpge16(m, opa_max), opa_v, opa_tmp);
+                res = v_color_mix(fg, bg, opa_tmp);
+            }
+            v_store(&buf[x], v_select(v_cmpeq16(m, zero), bg, res));
+        }
+
+        for(; x < copy_w; x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            if(opa_full) {
+                if(mask[x] == LV_OPA_COVER) buf[x] = map[x];
+                else buf[x] = lv_color_mix(map[x], buf[x], mask[x]);
+            }
+            else {
+                lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                buf[x] = lv_color_mix(map[x], buf[x], opa_tmp);
+            }
+        }
+
+        buf += buf_w;
+        mask += copy_w;
+        map += map_w;
+    }
+}
+
+/**
+ * Slide the windows of a box blur by one line. Every 8 bit channel of the line has its own window.
+ * @param sum sum of the channels in their window. `add` is added to it and `sub` is subtracted from it.
+ * @param add the channels entering the windows
+ * @param sub the channels leaving the windows
+ * @param out store the average of the windows (before sliding them) here
+ * @param win number of lines in a window (2..257 so that the sums fit into 16 bits)
+ * @param len number of channels in the line
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_simd_blur_step(uint16_t * sum, const uint8_t * add, const uint8_t * sub,
+                                                 uint8_t * out, uint16_t win, uint32_t len)
+{
+    /*Divide by multiplying with the reciprocal. It gives the quotient or one less which is corrected
+     *by checking the remainder. The remainder is less than 2 * 257 so the signed compare is fine too.*/
+    vec_t win_v = v_set16(win);
+    vec_t rec_v = v_set16((uint16_t)(0x10000 / win));
+
+    int32_t i;
+    for(i = 0; i <= (int32_t)len - CH_PER_VEC; i += CH_PER_VEC) {
+        vec_t s = v_load(&sum[i]);
+        vec_t q = v_mulhi16(s, rec_v);
+        vec_t rem = v_sub16(s, v_mul16(q, win_v));
+        q = v_sub16(q, v_cmpge16(rem, win_v));     /*Subtract -1 where the quotient is one less*/
+        v_store_u8(&out[i], q);
+
+        s = v_add16(v_sub16(s, v_load_u8(&sub[i])), v_load_u8(&add[i]));
+        v_store(&sum[i], s);
+    }
+
+    for(; i < (int32_t)len; i++) {
+        out[i] = sum[i] / win;
+        sum[i] = sum[i] - sub[i] + add[i];
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_GPU_SIMD_ENABLED*/
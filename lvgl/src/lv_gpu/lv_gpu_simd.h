@@ -0,0 +1,146 @@
+/**
+ * @file lv_gpu_simd.h
+ *
+ */
+
+#ifndef LV_GPU_SIMD_H
+#define LV_GPU_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_misc/lv_area.h"
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The instruction set is selected at build time from the compiler's target flags
+ *(e.g. `-mavx2` or `-mfpu=neon`). Only RGB565 (without byte swap) and ARGB8888 are supported.*/
+#if LV_USE_GPU_SIMD && (LV_COLOR_DEPTH == 32 || (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0))
+#  if defined(__AVX2__)
+#    define LV_GPU_SIMD_AVX2    1
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LV_GPU_SIMD_SSE2    1
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define LV_GPU_SIMD_NEON    1
+#  endif
+#endif
+
+#if defined(LV_GPU_SIMD_AVX2) || defined(LV_GPU_SIMD_SSE2) || defined(LV_GPU_SIMD_NEON)
+#  define LV_GPU_SIMD_ENABLED   1
+#else
+#  define LV_GPU_SIMD_ENABLED   0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_GPU_SIMD_ENABLED
+
+/**
+ * Get the name of the instruction set used by the SIMD blend kernels
+ * @return "AVX2", "SSE2" or "NEON"
+ */
+const char * lv_gpu_simd_get_isa(void);
+
+/**
+ * Fill an area in the buffer with a color
+ * @param buf a buffer which should be filled
+ * @param buf_w width of the buffer in pixels
+ * @param color fill color
+ * @param fill_w width to fill in pixels (<= buf_w)
+ * @param fill_h height to fill in pixels
+ * @note `buf_w - fill_w` is offset to the next line after fill
+ */
+void lv_gpu_simd_fill(lv_color_t * buf, lv_coord_t buf_w, lv_color_t color, lv_coord_t fill_w, lv_coord_t fill_h);
+
+/**
+ * Fill an area in the buffer with a color with a given opacity
+ * @param buf a buffer which should be filled
+ * @param buf_w width of the buffer in pixels
+ * @param color fill color
+ * @param opa opacity of the color (< LV_OPA_MAX)
+ * @param fill_w width to fill in pixels (<= buf_w)
+ * @param fill_h height to fill in pixels
+ * @note `buf_w - fill_w` is offset to the next line after fill
+ */
+void lv_gpu_simd_fill_opa(lv_color_t * buf, lv_coord_t buf_w, lv_color_t color, lv_opa_t opa,
+                          lv_coord_t fill_w, lv_coord_t fill_h);
+
+/**
+ * Fill an area in the buffer with a color but take into account a mask which describes the opacity of each pixel
+ * @param buf a buffer which should be filled using a mask
+ * @param buf_w width of the buffer in pixels
+ * @param color fill color
+ * @param mask 0..255 values describing the opacity of the corresponding pixel. It's width is `fill_w`
+ * @param opa overall opacity. 255 in `mask` should mean this opacity.
+ * @param fill_w width to fill in pixels (<= buf_w)
+ * @param fill_h height to fill in pixels
+ * @note `buf_w - fill_w` is offset to the next line after fill
+ */
+void lv_gpu_simd_fill_mask(lv_color_t * buf, lv_coord_t buf_w, lv_color_t color, const lv_opa_t * mask,
+                           lv_opa_t opa, lv_coord_t fill_w, lv_coord_t fill_h);
+
+/**
+ * Blend a map (e.g. RGB image with opacity) to a buffer
+ * @param buf a buffer where `map` should be blended
+ * @param buf_w width of the buffer in pixels
+ * @param map an "image" to blend
+ * @param map_w width of the map in pixels
+ * @param opa opacity of `map` (< LV_OPA_MAX)
+ * @param copy_w width of the area to blend in pixels (<= buf_w)
+ * @param copy_h height of the area to blend in pixels
+ * @note `map_w - copy_w` is offset to the next line after blend
+ */
+void lv_gpu_simd_blend(lv_color_t * buf, lv_coord_t buf_w, const lv_color_t * map, lv_coord_t map_w, lv_opa_t opa,
+                       lv_coord_t copy_w, lv_coord_t copy_h);
+
+/**
+ * Blend a map to a buffer but take into account a mask which describes the opacity of each pixel
+ * (e.g. the alpha channel of an ARGB image or an anti-aliased edge)
+ * @param buf a buffer where `map` should be blended
+ * @param buf_w width of the buffer in pixels
+ * @param map an "image" to blend
+ * @param map_w width of the map in pixels
+ * @param mask 0..255 values describing the opacity of the corresponding pixel. It's width is `copy_w`
+ * @param opa overall opacity. 255 in `mask` should mean this opacity.
+ * @param copy_w width of the area to blend in pixels (<= buf_w)
+ * @param copy_h height of the area to blend in pixels
+ */
+void lv_gpu_simd_blend_mask(lv_color_t * buf, lv_coord_t buf_w, const lv_color_t * map, lv_coord_t map_w,
+                            const lv_opa_t * mask, lv_opa_t opa, lv_coord_t copy_w, lv_coord_t copy_h);
+
+/**
+ * Slide the windows of a box blur by one line. Every 8 bit channel of the line has its own window.
+ * @param sum sum of the channels in their window. `add` is added to it and `sub` is subtracted from it.
+ * @param add the channels entering the windows
+ * @param sub the channels leaving the windows
+ * @param out store the average of the windows (before sliding them) here
+ * @param win number of lines in a window (2..257 so that the sums fit into 16 bits)
+ * @param len number of channels in the line
+ */
+void lv_gpu_simd_blur_step(uint16_t * sum, const uint8_t * add, const uint8_t * sub, uint8_t * out, uint16_t win,
+                           uint32_t len);
+
+#endif /*LV_GPU_SIMD_ENABLED*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_GPU_SIMD_H*/
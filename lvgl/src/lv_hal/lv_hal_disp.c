@@ -109,8 +109,42 @@ void lv_disp_buf_init(lv_disp_buf_t * disp_buf, void * buf1, void * buf2, uint32
     disp_buf->buf2    = buf2;
     disp_buf->buf_act = disp_buf->buf1;
     disp_buf->size    = size_in_px_cnt;
+
+#if LV_USE_FLUSH_THREAD
+    disp_buf->ring[0] = buf1;
+    disp_buf->ring[1] = buf2;
+    disp_buf->ring_cnt = buf2 ? 2 : 1;
+#endif
 }
 
+#if LV_USE_FLUSH_THREAD
+/**
+ * Initialize a display buffer with more than 2 draw buffers.
+ * The buffers are rendered in order while the previous ones are flushed on the flush thread.
+ * @param disp_buf pointer `lv_disp_buf_t` variable to initialize
+ * @param bufs array of `buf_cnt` buffers. Its content is copied.
+ * @param buf_cnt number of buffers in `bufs` (1..`LV_DISP_BUF_RING_MAX`)
+ * @param size_in_px_cnt size of each buffer in pixel count.
+ */
+void lv_disp_buf_init_ring(lv_disp_buf_t * disp_buf, void * bufs[], uint8_t buf_cnt, uint32_t size_in_px_cnt)
+{
+    LV_ASSERT_NULL(bufs);
+
+    if(buf_cnt > LV_DISP_BUF_RING_MAX) {
+        LV_LOG_WARN("lv_disp_buf_init_ring: too many buffers. Increase LV_DISP_BUF_RING_MAX.");
+        buf_cnt = LV_DISP_BUF_RING_MAX;
+    }
+
+    lv_disp_buf_init(disp_buf, bufs[0], buf_cnt > 1 ? bufs[1] : NULL, size_in_px_cnt);
+
+    uint8_t i;
+    for(i = 0; i < buf_cnt; i++) {
+        disp_buf->ring[i] = bufs[i];
+    }
+    disp_buf->ring_cnt = buf_cnt;
+}
+#endif
+
 /**
  * Register an initialized display driver.
  * Automatically set the first display as active.
@@ -129,6 +163,9 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     _lv_memcpy(&disp->driver, driver, sizeof(lv_disp_drv_t));
 
     _lv_ll_init(&disp->scr_ll, sizeof(lv_obj_t));
+#if LV_USE_OBJ_POOL
+    _lv_ll_set_pool(&disp->scr_ll, &LV_GC_ROOT(_lv_obj_pool)[0]);
+#endif
     disp->last_activity_time = 0;
 
     if(disp_def == NULL) disp_def = disp;
@@ -325,7 +362,13 @@ LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
     /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
     if(disp_drv->screen_transp) {
+#if LV_USE_FLUSH_THREAD
+        /*`buf_act` might be being rendered. Clear the flushed buffer instead.*/
+        void * buf = disp_drv->buffer->buf_flushing ? disp_drv->buffer->buf_flushing : disp_drv->buffer->buf_act;
+        _lv_memset_00(buf, disp_drv->buffer->size * sizeof(lv_color32_t));
+#else
         _lv_memset_00(disp_drv->buffer->buf_act, disp_drv->buffer->size * sizeof(lv_color32_t));
+#endif
     }
 #endif
 
@@ -58,6 +58,16 @@ typedef struct {
     volatile int flushing_last;
     volatile uint32_t last_area         : 1; /*1: the last area is being rendered*/
     volatile uint32_t last_part         : 1; /*1: the last part of the current area is being rendered*/
+#if LV_USE_FLUSH_THREAD
+    void * ring[LV_DISP_BUF_RING_MAX]; /*The draw buffers. They are rendered and flushed in this order*/
+    void * buf_flushing;               /*The buffer being flushed by the flush thread*/
+    uint32_t flush_cnt;                /*Number of buffers flushed by the flush thread*/
+    uint32_t stall_cnt;                /*Number of times the renderer waited for a free buffer*/
+    uint32_t stall_time;               /*Time [ms] the renderer waited for a free buffer*/
+    uint8_t ring_cnt;                  /*Number of buffers in `ring`*/
+    uint8_t ring_act;                  /*Index of `buf_act` in `ring`*/
+    volatile uint8_t ring_queued;      /*Number of buffers waiting for flushing or being flushed*/
+#endif
 } lv_disp_buf_t;
 
 /**
@@ -138,6 +148,21 @@ typedef struct _disp_drv_t {
 
 } lv_disp_drv_t;
 
+/**
+ * Statistics about the invalidated and redrawn areas of a display
+ */
+typedef struct {
+    uint32_t inv_cnt;       /**< Number of areas invalidated on the display*/
+    uint32_t inv_skip_cnt;  /**< Number of invalidated areas skipped because they were already invalid*/
+    uint32_t merge_cnt;     /**< Number of times areas were merged because the buffer of invalid areas was full*/
+    uint32_t join_cnt;      /**< Number of areas joined before refreshing*/
+    uint32_t refr_cnt;      /**< Number of areas refreshed*/
+    uint64_t px_inv;        /**< Number of invalidated pixels*/
+    uint64_t px_refr;       /**< Number of redrawn pixels. `px_refr - px_inv` is the overdraw caused by joining*/
+    uint32_t cull_cnt;      /**< Number of objects not drawn because an opaque sibling covered them*/
+    uint64_t px_cull;       /**< Number of pixels not drawn because an opaque sibling covered them*/
+} lv_disp_inv_stat_t;
+
 struct _lv_obj_t;
 
 /**
@@ -172,6 +197,7 @@ uint8_t del_prev  :
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p : 10;
+    lv_disp_inv_stat_t inv_stat;
 
     /*Miscellaneous data*/
     uint32_t last_activity_time; /**< Last time there was activity on this display */
@@ -214,6 +240,18 @@ void lv_disp_drv_init(lv_disp_drv_t * driver);
  */
 void lv_disp_buf_init(lv_disp_buf_t * disp_buf, void * buf1, void * buf2, uint32_t size_in_px_cnt);
 
+#if LV_USE_FLUSH_THREAD
+/**
+ * Initialize a display buffer with more than 2 draw buffers.
+ * The buffers are rendered in order while the previous ones are flushed on the flush thread.
+ * @param disp_buf pointer `lv_disp_buf_t` variable to initialize
+ * @param bufs array of `buf_cnt` buffers. Its content is copied.
+ * @param buf_cnt number of buffers in `bufs` (1..`LV_DISP_BUF_RING_MAX`)
+ * @param size_in_px_cnt size of each buffer in pixel count.
+ */
+void lv_disp_buf_init_ring(lv_disp_buf_t * disp_buf, void * bufs[], uint8_t buf_cnt, uint32_t size_in_px_cnt);
+#endif
+
 /**
  * Register an initialized display driver.
  * Automatically set the first display as active.
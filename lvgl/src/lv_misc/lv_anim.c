@@ -27,6 +27,8 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 #define LV_ANIM_TASK_PRIO LV_TASK_PRIO_HIGH
+#define LV_ANIM_ARRAY_MIN_SIZE 8    /*Must be a power of 2*/
+#define ANIM_BUCKETS (LV_GC_ROOT(_lv_anim_array) + anim_array_size)
 
 /**********************
  *      TYPEDEFS
@@ -37,13 +39,20 @@
  **********************/
 static void anim_task(lv_task_t * param);
 static void anim_mark_list_change(void);
-static bool anim_ready_handler(lv_anim_t * a);
+static void anim_ready_handler(lv_anim_t * a);
+static lv_anim_t ** anim_array_resize(uint32_t size);
+static void anim_array_compact(void);
+static void anim_remove(lv_anim_t * a);
+static inline uint32_t anim_hash(const void * var);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_task_run;
-static bool anim_list_changed;
+static uint32_t anim_cnt;           /*Number of animations*/
+static uint32_t anim_used;          /*Used slots of the array including the deleted (NULL) ones*/
+static uint32_t anim_array_size;    /*Slots of the array and number of hash buckets after them*/
+static bool anim_task_running;
 static lv_task_t * _lv_anim_task;
 const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
 
@@ -60,11 +69,14 @@ const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
  */
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    LV_GC_ROOT(_lv_anim_array) = NULL;
+    anim_cnt = 0;
+    anim_used = 0;
+    anim_array_size = 0;
+    anim_task_running = false;
     last_task_run = lv_tick_get();
     _lv_anim_task = lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_ANIM_TASK_PRIO, NULL);
     anim_mark_list_change(); /*Turn off the animation task*/
-    anim_list_changed = false; /*The list has not actually changed*/
 }
 
 /**
@@ -95,13 +107,25 @@ void lv_anim_start(lv_anim_t * a)
     /* Do not let two animations for the  same 'var' with the same 'fp'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*fp == NULL would delete all animations of var*/
 
-    /*If the list is empty the anim task was suspended and it's last run measure is invalid*/
-    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+    /*If there are no animations the anim task was suspended and it's last run measure is invalid*/
+    if(anim_cnt == 0) {
         last_task_run = lv_tick_get() - 1;
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+    /*Make room for the new animation at the end of the array.
+     *Don't move the animations while `anim_task` is iterating over them*/
+    if(anim_used >= anim_array_size && anim_used > anim_cnt && !anim_task_running) {
+        anim_array_compact();
+    }
+    if(anim_used >= anim_array_size) {
+        lv_anim_t ** array = anim_array_resize(anim_array_size ? anim_array_size * 2 : LV_ANIM_ARRAY_MIN_SIZE);
+        LV_ASSERT_MEM(array);
+        if(array == NULL) return;
+    }
+
+    /*The array stores only pointers. The animations are allocated one by one so they don't move
+     *when the array is resized or compacted: `lv_anim_get()` and the callbacks keep `lv_anim_t *`*/
+    lv_anim_t * new_anim = lv_mem_alloc(sizeof(lv_anim_t));
     LV_ASSERT_MEM(new_anim);
     if(new_anim == NULL) return;
 
@@ -109,13 +133,20 @@ void lv_anim_start(lv_anim_t * a)
     a->time_orig = a->time;
     _lv_memcpy(new_anim, a, sizeof(lv_anim_t));
 
+    /*Add it to the array and to the hash bucket of its variable*/
+    uint32_t h = anim_hash(new_anim->var);
+    new_anim->array_id = anim_used;
+    new_anim->hash_next = ANIM_BUCKETS[h];
+    ANIM_BUCKETS[h] = new_anim;
+    LV_GC_ROOT(_lv_anim_array)[anim_used] = new_anim;
+    anim_used++;
+    anim_cnt++;
+
     /*Set the start value*/
     if(new_anim->early_apply) {
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start);
     }
 
-    /* Creating an animation changed the linked list.
-     * It's important if it happens in a ready callback. (see `anim_task`)*/
     anim_mark_list_change();
 
     LV_LOG_TRACE("animation created")
@@ -130,19 +161,17 @@ void lv_anim_start(lv_anim_t * a)
  */
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
+    if(anim_cnt == 0) return false;
+
+    /*All the animations of `var` are in the same hash bucket*/
     bool del = false;
-    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    lv_anim_t * a = ANIM_BUCKETS[anim_hash(var)];
     while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+        /*'a' might be deleted, so get the next animation while 'a' is valid*/
+        lv_anim_t * a_next = a->hash_next;
 
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_task`. It need to know if a delete occurred in
-                                         the linked list*/
+            anim_remove(a);
             del = true;
         }
 
@@ -161,11 +190,14 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
  */
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) {
+    if(anim_cnt == 0) return NULL;
+
+    lv_anim_t * a = ANIM_BUCKETS[anim_hash(var)];
+    while(a != NULL) {
         if(a->var == var && a->exec_cb == exec_cb) {
             return a;
         }
+        a = a->hash_next;
     }
 
     return NULL;
@@ -177,11 +209,7 @@ lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
  */
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt;
+    return anim_cnt;
 }
 
 /**
@@ -444,57 +472,64 @@ static void anim_task(lv_task_t * param)
 {
     (void)param;
 
-    lv_anim_t * a;
-    _LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) {
-        a->has_run = 0;
-    }
+    /*Called again from a callback of an animation (e.g. via `lv_refr_now`)*/
+    if(anim_task_running) return;
+    anim_task_running = true;
 
     uint32_t elaps = lv_tick_elaps(last_task_run);
 
-    a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
-
-        if(!a->has_run) {
-            a->has_run = 1; /*The list readying might be reseted so need to know which anim has run already*/
-
-            /*The animation will run now for the first time. Call `start_cb`*/
-            int32_t new_act_time = a->act_time + elaps;
-            if(a->act_time <= 0 && new_act_time >= 0) {
-                if(a->start_cb) a->start_cb(a);
+    /* Deleted animations leave a NULL in the array and the new ones are added to its end
+     * so the array can be changed by the callbacks without restarting the iteration.
+     * The array might be reallocated by `lv_anim_start` so always read it from the root.*/
+    uint32_t i;
+    for(i = 0; i < anim_used; i++) {
+        lv_anim_t * a = LV_GC_ROOT(_lv_anim_array)[i];
+        if(a == NULL) continue;
+
+        /*The animation will run now for the first time. Call `start_cb`*/
+        int32_t new_act_time = a->act_time + elaps;
+        if(a->act_time <= 0 && new_act_time >= 0) {
+            if(a->start_cb) {
+                a->start_cb(a);
+                if(LV_GC_ROOT(_lv_anim_array)[i] != a) continue;   /*Deleted in the callback*/
             }
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
-
-                int32_t new_value;
-                if(a->path.cb) new_value = a->path.cb(&a->path, a);
-                else new_value = lv_anim_path_linear(&a->path, a);
-
-                if(new_value != a->current) {
-                    a->current = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
+        }
+        a->act_time += elaps;
+        if(a->act_time >= 0) {
+            if(a->act_time > a->time) a->act_time = a->time;
+
+            int32_t new_value;
+            if(a->path.cb) new_value = a->path.cb(&a->path, a);
+            else new_value = lv_anim_path_linear(&a->path, a);
+
+            if(new_value != a->current) {
+                a->current = new_value;
+                /*Apply the calculated value*/
+                if(a->exec_cb) {
+                    a->exec_cb(a->var, new_value);
+                    if(LV_GC_ROOT(_lv_anim_array)[i] != a) continue;   /*Deleted in the callback*/
                 }
+            }
 
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
+            /*If the time is elapsed the animation is ready*/
+            if(a->act_time >= a->time) {
+                anim_ready_handler(a);
             }
         }
+    }
 
-        /* If the linked list changed due to anim. delete then it's not safe to continue
-         * the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+    anim_task_running = false;
+
+    /*Remove the deleted animations from the array and shrink it if it's mostly empty*/
+    if(anim_cnt == 0) {
+        anim_used = 0;
+        anim_array_resize(0);
+    }
+    else if(anim_used > anim_cnt) {
+        anim_array_compact();
+        if(anim_array_size > LV_ANIM_ARRAY_MIN_SIZE && anim_used <= anim_array_size / 4) {
+            anim_array_resize(anim_array_size / 2);
+        }
     }
 
     last_task_run = lv_tick_get();
@@ -504,9 +539,8 @@ static void anim_task(lv_task_t * param)
  * Called when an animation is ready to do the necessary thinks
  * e.g. repeat, play back, delete etc.
  * @param a pointer to an animation descriptor
- * @return true: animation delete occurred and the `LV_GC_ROOT(_lv_anim_ll)` has changed
  * */
-static bool anim_ready_handler(lv_anim_t * a)
+static void anim_ready_handler(lv_anim_t * a)
 {
     /*In the end of a forward anim decrement repeat cnt.*/
     if(a->playback_now == 0 && a->repeat_cnt > 0 && a->repeat_cnt != LV_ANIM_REPEAT_INFINITE) {
@@ -518,14 +552,11 @@ static bool anim_ready_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready */
     if(a->repeat_cnt == 0 && ((a->playback_time == 0) || (a->playback_time && a->playback_now == 1))) {
 
-        /*Create copy from the animation and delete the animation from the list.
+        /*Create copy from the animation and delete the animation from the array.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
         lv_anim_t a_tmp;
         _lv_memcpy(&a_tmp, a, sizeof(lv_anim_t));
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        lv_mem_free(a);
-        /*Flag that the list has changed */
-        anim_mark_list_change();
+        anim_remove(a);
 
         /* Call the callback function at the end*/
         if(a_tmp.ready_cb != NULL) a_tmp.ready_cb(&a_tmp);
@@ -549,15 +580,100 @@ static bool anim_ready_handler(lv_anim_t * a)
             a->time = a->playback_now == 0 ? a->time_orig : a->playback_time;
         }
     }
-
-    return anim_list_changed;
 }
+
 static void anim_mark_list_change(void)
 {
-    anim_list_changed = true;
-    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
+    if(anim_cnt == 0)
         lv_task_set_prio(_lv_anim_task, LV_TASK_PRIO_OFF);
     else
         lv_task_set_prio(_lv_anim_task, LV_ANIM_TASK_PRIO);
 }
+
+/**
+ * Reallocate the array of the animation pointers and rebuild the hash buckets after it.
+ * @param size new number of slots (power of 2), at least `anim_used`. 0: free the array
+ * @return pointer to the new array or NULL if `size == 0` or out of memory (the old array is kept)
+ */
+static lv_anim_t ** anim_array_resize(uint32_t size)
+{
+    if(size == 0) {
+        lv_mem_free(LV_GC_ROOT(_lv_anim_array));
+        LV_GC_ROOT(_lv_anim_array) = NULL;
+        anim_array_size = 0;
+        return NULL;
+    }
+
+    lv_anim_t ** array = lv_mem_alloc(2 * size * sizeof(lv_anim_t *));
+    if(array == NULL) return NULL;
+
+    if(anim_used) _lv_memcpy(array, LV_GC_ROOT(_lv_anim_array), anim_used * sizeof(lv_anim_t *));
+    lv_mem_free(LV_GC_ROOT(_lv_anim_array));
+    LV_GC_ROOT(_lv_anim_array) = array;
+    anim_array_size = size;
+
+    _lv_memset_00(ANIM_BUCKETS, size * sizeof(lv_anim_t *));
+    uint32_t i;
+    for(i = 0; i < anim_used; i++) {
+        lv_anim_t * a = array[i];
+        if(a == NULL) continue;
+        uint32_t h = anim_hash(a->var);
+        a->hash_next = ANIM_BUCKETS[h];
+        ANIM_BUCKETS[h] = a;
+    }
+
+    return array;
+}
+
+/**
+ * Remove the deleted (NULL) slots from the array keeping the order of the animations.
+ */
+static void anim_array_compact(void)
+{
+    lv_anim_t ** array = LV_GC_ROOT(_lv_anim_array);
+    uint32_t used = 0;
+    uint32_t i;
+    for(i = 0; i < anim_used; i++) {
+        if(array[i] == NULL) continue;
+        array[used] = array[i];
+        array[used]->array_id = used;
+        used++;
+    }
+
+    anim_used = used;
+}
+
+/**
+ * Remove an animation from its hash bucket and from the array, and free it.
+ * The slot in the array is only cleared and reused after `anim_array_compact`.
+ * @param a pointer to an animation in the array
+ */
+static void anim_remove(lv_anim_t * a)
+{
+    lv_anim_t ** next_p = &ANIM_BUCKETS[anim_hash(a->var)];
+    while(*next_p != a) next_p = &(*next_p)->hash_next;
+    *next_p = a->hash_next;
+
+    LV_GC_ROOT(_lv_anim_array)[a->array_id] = NULL;
+    while(anim_used > 0 && LV_GC_ROOT(_lv_anim_array)[anim_used - 1] == NULL) anim_used--;
+
+    lv_mem_free(a);
+    anim_cnt--;
+
+    /*Free the array if it's not iterated by `anim_task`*/
+    if(anim_cnt == 0 && !anim_task_running) anim_array_resize(0);
+
+    anim_mark_list_change();
+}
+
+/**
+ * Get the hash bucket of a variable
+ * @param var pointer to the animated variable
+ * @return index of the bucket
+ */
+static inline uint32_t anim_hash(const void * var)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)var >> 2) * 2654435761U;
+    return (h ^ (h >> 16)) & (anim_array_size - 1);
+}
 #endif
@@ -98,7 +98,8 @@ typedef struct _lv_anim_t {
     /*Animation system use these - user shouldn't set*/
     uint32_t time_orig;
     uint8_t playback_now : 1; /**< Play back is in progress*/
-    uint32_t has_run : 1;     /**< Indicates the animation has run in this round*/
+    uint32_t array_id;        /**< Index in the array of the animations*/
+    struct _lv_anim_t * hash_next; /**< Next animation with the same hash of `var`*/
 } lv_anim_t;
 
 
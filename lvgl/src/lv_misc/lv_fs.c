@@ -313,6 +313,49 @@ lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size)
     return res;
 }
 
+/**
+ * Map the whole content of a file into the memory (e.g. with `mmap` or if the file is in memory mapped flash)
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param data pointer to a variable to store the address of the content
+ * @param size pointer to a variable to store the size of the content
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** data, uint32_t * size)
+{
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    if(data == NULL || size == NULL) return LV_FS_RES_INV_PARAM;
+
+    lv_fs_res_t res = file_p->drv->map_cb(file_p->drv, file_p->file_d, data, size);
+
+    return res;
+}
+
+/**
+ * Release the content of a file mapped by `lv_fs_map()`. Should be called before closing the file.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param data the address given by `lv_fs_map()`
+ * @param size the size given by `lv_fs_map()`
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_unmap(lv_fs_file_t * file_p, const void * data, uint32_t size)
+{
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    /*Nothing to release if e.g. the file is in memory mapped flash*/
+    if(file_p->drv->unmap_cb == NULL) return LV_FS_RES_OK;
+
+    lv_fs_res_t res = file_p->drv->unmap_cb(file_p->drv, file_p->file_d, data, size);
+
+    return res;
+}
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -77,6 +77,8 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*size_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
     lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t * drv, const char * oldname, const char * newname);
     lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
+    lv_fs_res_t (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p);
+    lv_fs_res_t (*unmap_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void * data, uint32_t size);
 
     lv_fs_res_t (*dir_open_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
@@ -211,6 +213,24 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p);
  */
 lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size);
 
+/**
+ * Map the whole content of a file into the memory (e.g. with `mmap` or if the file is in memory mapped flash)
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param data pointer to a variable to store the address of the content
+ * @param size pointer to a variable to store the size of the content
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** data, uint32_t * size);
+
+/**
+ * Release the content of a file mapped by `lv_fs_map()`. Should be called before closing the file.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param data the address given by `lv_fs_map()`
+ * @param size the size given by `lv_fs_map()`
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_unmap(lv_fs_file_t * file_p, const void * data, uint32_t size);
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -26,37 +26,72 @@ extern "C" {
  *********************/
 
 #define LV_ITERATE_ROOTS(f) \
+    LV_ITERATE_GLOBAL_ROOTS(f)                                     \
+    LV_ITERATE_OBJ_POOL_ROOTS(f)                                   \
+    LV_ITERATE_DRAW_ROOTS(f)
+
+#define LV_ITERATE_GLOBAL_ROOTS(f) \
     f(lv_ll_t, _lv_task_ll)  /*Linked list to store the lv_tasks*/ \
     f(lv_ll_t, _lv_disp_ll)  /*Linked list of screens*/            \
     f(lv_ll_t, _lv_indev_ll) /*Linked list of screens*/            \
     f(lv_ll_t, _lv_drv_ll)                                         \
     f(lv_ll_t, _lv_file_ll)                                        \
-    f(lv_ll_t, _lv_anim_ll)                                        \
+    f(struct _lv_anim_t **, _lv_anim_array)                        \
     f(lv_ll_t, _lv_group_ll)                                       \
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
     f(lv_ll_t, _lv_obj_style_trans_ll)                             \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
     f(lv_task_t*, _lv_task_act)                                    \
-    f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
-    f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
     f(void * , _lv_theme_material_styles)                          \
     f(void * , _lv_theme_template_styles)                          \
     f(void * , _lv_theme_mono_styles)                              \
     f(void * , _lv_theme_empty_styles)                             \
+    f(void * , _lv_font_lookup_list)                               \
+    f(lv_ll_t, _lv_cont_layout_ll)                                 \
+    f(lv_ll_t, _lv_indev_hit_index_ll)                             \
+
+
+/*Slab pools of the objects and of the `ext_attr` of the common widgets (see `lv_obj.c`)*/
+#if LV_USE_OBJ_POOL
+#define LV_OBJ_POOL_CNT 5
+typedef lv_mem_pool_t lv_obj_pool_arr_t[LV_OBJ_POOL_CNT];
+
+#define LV_ITERATE_OBJ_POOL_ROOTS(f) \
+    f(lv_obj_pool_arr_t, _lv_obj_pool)                             \
+
+#else
+#define LV_ITERATE_OBJ_POOL_ROOTS(f)
+#endif
+
+/*Draw state. With `LV_USE_REFR_THREADS` every rendering thread has its own copy*/
+#define LV_ITERATE_DRAW_ROOTS(f) \
+    f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
+    f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
     f(uint8_t *, _lv_font_decompr_buf)                             \
+    f(uint8_t *, _lv_font_bitmap_buf)                              \
+    f(void *, _lv_font_glyph_cache)                                \
+    f(void *, _lv_draw_shadow_cache)                               \
 
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
-#define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
+#define LV_DEFINE_DRAW_ROOT(root_type, root_name) LV_THREAD_LOCAL root_type root_name;
+#define LV_ROOTS LV_ITERATE_GLOBAL_ROOTS(LV_DEFINE_ROOT) LV_ITERATE_OBJ_POOL_ROOTS(LV_DEFINE_ROOT) \
+    LV_ITERATE_DRAW_ROOTS(LV_DEFINE_DRAW_ROOT)
 
 #if LV_ENABLE_GC == 1
 #if LV_MEM_CUSTOM != 1
 #error "GC requires CUSTOM_MEM"
 #endif /* LV_MEM_CUSTOM */
+#if LV_USE_REFR_THREADS
+#error "GC can't be used with LV_USE_REFR_THREADS"
+#endif /* LV_USE_REFR_THREADS */
 #else  /* LV_ENABLE_GC */
 #define LV_GC_ROOT(x) x
 #define LV_EXTERN_ROOT(root_type, root_name) extern root_type root_name;
-LV_ITERATE_ROOTS(LV_EXTERN_ROOT)
+#define LV_EXTERN_DRAW_ROOT(root_type, root_name) extern LV_THREAD_LOCAL root_type root_name;
+LV_ITERATE_GLOBAL_ROOTS(LV_EXTERN_ROOT)
+LV_ITERATE_OBJ_POOL_ROOTS(LV_EXTERN_ROOT)
+LV_ITERATE_DRAW_ROOTS(LV_EXTERN_DRAW_ROOT)
 #endif /* LV_ENABLE_GC */
 
 /**********************
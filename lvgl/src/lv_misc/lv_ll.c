@@ -20,6 +20,14 @@
 #define LL_PREV_P_OFFSET(ll_p) (ll_p->n_size)
 #define LL_NEXT_P_OFFSET(ll_p) (ll_p->n_size + sizeof(lv_ll_node_t *))
 
+#ifdef LV_ARCH_64
+    /*Round the size up to 8*/
+    #define LL_NODE_SIZE_ROUND(size) (((size) + 7) & (~0x7))
+#else
+    /*Round the size up to 4*/
+    #define LL_NODE_SIZE_ROUND(size) (((size) + 3) & (~0x3))
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -27,6 +35,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_ll_node_t * node_alloc(lv_ll_t * ll_p);
 static void node_set_prev(lv_ll_t * ll_p, lv_ll_node_t * act, lv_ll_node_t * prev);
 static void node_set_next(lv_ll_t * ll_p, lv_ll_node_t * act, lv_ll_node_t * next);
 
@@ -51,17 +60,37 @@ void _lv_ll_init(lv_ll_t * ll_p, uint32_t node_size)
 {
     ll_p->head = NULL;
     ll_p->tail = NULL;
-#ifdef LV_ARCH_64
-    /*Round the size up to 8*/
-    node_size = (node_size + 7) & (~0x7);
-#else
-    /*Round the size up to 4*/
-    node_size = (node_size + 3) & (~0x3);
+#if LV_USE_OBJ_POOL
+    ll_p->pool = NULL;
 #endif
 
-    ll_p->n_size = node_size;
+    ll_p->n_size = LL_NODE_SIZE_ROUND(node_size);
 }
 
+#if LV_USE_OBJ_POOL
+/**
+ * Initialize a memory pool for the nodes of linked lists
+ * @param pool pointer to a memory pool
+ * @param node_size the size of 1 node in bytes (as in `_lv_ll_init`)
+ * @param node_cnt number of nodes in a slab of the pool
+ */
+void _lv_ll_init_pool(lv_mem_pool_t * pool, uint32_t node_size, uint16_t node_cnt)
+{
+    _lv_mem_pool_init(pool, LL_NODE_SIZE_ROUND(node_size) + LL_NODE_META_SIZE, node_cnt);
+}
+
+/**
+ * Allocate the new nodes of a linked list from a memory pool.
+ * Should be called before adding nodes to the linked list.
+ * @param ll_p pointer to linked list
+ * @param pool pointer to a memory pool initialized with `_lv_ll_init_pool` and the node size of `ll_p`
+ */
+void _lv_ll_set_pool(lv_ll_t * ll_p, lv_mem_pool_t * pool)
+{
+    ll_p->pool = pool;
+}
+#endif
+
 /**
  * Add a new head to a linked list
  * @param ll_p pointer to linked list
@@ -71,7 +100,7 @@ void * _lv_ll_ins_head(lv_ll_t * ll_p)
 {
     lv_ll_node_t * n_new;
 
-    n_new = lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+    n_new = node_alloc(ll_p);
 
     if(n_new != NULL) {
         node_set_prev(ll_p, n_new, NULL);       /*No prev. before the new head*/
@@ -107,7 +136,7 @@ void * _lv_ll_ins_prev(lv_ll_t * ll_p, void * n_act)
         if(n_new == NULL) return NULL;
     }
     else {
-        n_new = lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+        n_new = node_alloc(ll_p);
         if(n_new == NULL) return NULL;
 
         lv_ll_node_t * n_prev;
@@ -130,7 +159,7 @@ void * _lv_ll_ins_tail(lv_ll_t * ll_p)
 {
     lv_ll_node_t * n_new;
 
-    n_new = lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+    n_new = node_alloc(ll_p);
 
     if(n_new != NULL) {
         node_set_next(ll_p, n_new, NULL);       /*No next after the new tail*/
@@ -185,6 +214,25 @@ void _lv_ll_remove(lv_ll_t * ll_p, void * node_p)
     }
 }
 
+/**
+ * Free a node which was removed from its linked list with `_lv_ll_remove`
+ * @param ll_p pointer to the linked list which allocated the node
+ * @param node_p pointer to the removed node
+ */
+void _lv_ll_free_node(lv_ll_t * ll_p, void * node_p)
+{
+#if LV_USE_OBJ_POOL
+    if(ll_p->pool != NULL) {
+        _lv_mem_pool_free(ll_p->pool, node_p);
+        return;
+    }
+#else
+    (void) ll_p;    /*Unused*/
+#endif
+
+    lv_mem_free(node_p);
+}
+
 /**
  * Remove and free all elements from a linked list. The list remain valid but become empty.
  * @param ll_p pointer to linked list
@@ -201,7 +249,7 @@ void _lv_ll_clear(lv_ll_t * ll_p)
         i_next = _lv_ll_get_next(ll_p, i);
 
         _lv_ll_remove(ll_p, i);
-        lv_mem_free(i);
+        _lv_ll_free_node(ll_p, i);
 
         i = i_next;
     }
@@ -384,6 +432,20 @@ bool _lv_ll_is_empty(lv_ll_t * ll_p)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Allocate a new node for a linked list
+ * @param ll_p pointer to linked list
+ * @return pointer to the new node or NULL if out of memory
+ */
+static lv_ll_node_t * node_alloc(lv_ll_t * ll_p)
+{
+#if LV_USE_OBJ_POOL
+    if(ll_p->pool != NULL) return _lv_mem_pool_alloc(ll_p->pool);
+#endif
+
+    return lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+}
+
 /**
  * Set the previous node pointer of a node
  * @param ll_p pointer to linked list
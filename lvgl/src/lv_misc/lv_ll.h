@@ -34,6 +34,9 @@ typedef struct {
     uint32_t n_size;
     lv_ll_node_t * head;
     lv_ll_node_t * tail;
+#if LV_USE_OBJ_POOL
+    lv_mem_pool_t * pool;   /**< Allocate the nodes from this pool if not NULL*/
+#endif
 } lv_ll_t;
 
 /**********************
@@ -47,6 +50,24 @@ typedef struct {
  */
 void _lv_ll_init(lv_ll_t * ll_p, uint32_t node_size);
 
+#if LV_USE_OBJ_POOL
+/**
+ * Initialize a memory pool for the nodes of linked lists
+ * @param pool pointer to a memory pool
+ * @param node_size the size of 1 node in bytes (as in `_lv_ll_init`)
+ * @param node_cnt number of nodes in a slab of the pool
+ */
+void _lv_ll_init_pool(lv_mem_pool_t * pool, uint32_t node_size, uint16_t node_cnt);
+
+/**
+ * Allocate the new nodes of a linked list from a memory pool.
+ * Should be called before adding nodes to the linked list.
+ * @param ll_p pointer to linked list
+ * @param pool pointer to a memory pool initialized with `_lv_ll_init_pool` and the node size of `ll_p`
+ */
+void _lv_ll_set_pool(lv_ll_t * ll_p, lv_mem_pool_t * pool);
+#endif
+
 /**
  * Add a new head to a linked list
  * @param ll_p pointer to linked list
@@ -77,6 +98,13 @@ void * _lv_ll_ins_tail(lv_ll_t * ll_p);
  */
 void _lv_ll_remove(lv_ll_t * ll_p, void * node_p);
 
+/**
+ * Free a node which was removed from its linked list with `_lv_ll_remove`
+ * @param ll_p pointer to the linked list which allocated the node
+ * @param node_p pointer to the removed node
+ */
+void _lv_ll_free_node(lv_ll_t * ll_p, void * node_p);
+
 /**
  * Remove and free all elements from a linked list. The list remain valid but become empty.
  * @param ll_p pointer to linked list
@@ -10,6 +10,7 @@
 #include "lv_mem.h"
 #include "lv_math.h"
 #include "lv_gc.h"
+#include "lv_thread.h"
 #include <string.h>
 
 #if LV_MEM_CUSTOM != 0
@@ -48,7 +49,12 @@
 typedef union {
     struct {
         MEM_UNIT used : 1;    /* 1: if the entry is used*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+        MEM_UNIT prev_free : 1; /* 1: if the previous entry is free*/
+        MEM_UNIT d_size : 30; /* Size off the data (1 means 4 bytes)*/
+#else
         MEM_UNIT d_size : 31; /* Size off the data (1 means 4 bytes)*/
+#endif
     } s;
     MEM_UNIT header; /* The header (used + d_size)*/
 } lv_mem_header_t;
@@ -60,21 +66,76 @@ typedef struct {
 
 #endif /* LV_ENABLE_GC */
 
+/*Precedes every block of a pool to find its slab without walking the slabs*/
+typedef struct {
+    lv_mem_slab_t * slab;
+    lv_uintptr_t check;     /*`POOL_BLK_CHECK()` of the pool and the slab. Tells whether an unknown pointer is a block*/
+} pool_blk_header_t;
+
 #ifdef LV_ARCH_64
     #define ALIGN_MASK  0x7
 #else
     #define ALIGN_MASK  0x3
 #endif
 
+#define POOL_SLAB_HEADER_SIZE ((sizeof(lv_mem_slab_t) + ALIGN_MASK) & (~ALIGN_MASK))
+#define POOL_BLK_HEADER_SIZE ((sizeof(pool_blk_header_t) + ALIGN_MASK) & (~ALIGN_MASK))
+#define POOL_BLK_CHECK(pool, slab) (~((lv_uintptr_t)(pool) ^ (lv_uintptr_t)(slab)))
+
 #define MEM_BUF_SMALL_SIZE 16
+#define MEM_BUF_SMALL_NUM  2
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/*The free entries are sorted into `MEM_FL_CNT` first level classes by the highest set bit of their size
+ *and every first level class is divided into `MEM_SL_CNT` second level classes linearly.*/
+#ifdef LV_ARCH_64
+    #define MEM_ALIGN_LOG2  3
+#else
+    #define MEM_ALIGN_LOG2  2
+#endif
+#define MEM_SL_LOG2     4
+#define MEM_SL_CNT      (1 << MEM_SL_LOG2)
+#define MEM_FL_SHIFT    (MEM_SL_LOG2 + MEM_ALIGN_LOG2)
+#define MEM_SMALL_SIZE  (1 << MEM_FL_SHIFT)     /*Sizes below it are in the first class with linear steps*/
+#define MEM_FL_MAX      (LV_MEM_SIZE > (1UL << 24) ? 30 : LV_MEM_SIZE > (1UL << 20) ? 24 : \
+                         LV_MEM_SIZE > (1UL << 16) ? 20 : 16)
+#define MEM_FL_CNT      (MEM_FL_MAX - MEM_FL_SHIFT + 1)
+
+/*A free entry stores the offset of the next and previous free entries at the beginning of its data
+ *and its size at the end of its data. So the data of the entries can't be smaller than this.*/
+#define MEM_ENT_MIN     ((3 * sizeof(uint32_t) + ALIGN_MASK) & (~ALIGN_MASK))
+#define MEM_FREE_NONE   0xFFFFFFFF
+#endif
+
+/*The rendering threads share the built-in heap*/
+#if LV_MEM_CUSTOM == 0 && LV_USE_REFR_THREADS
+    #define MEM_LOCK()      _lv_mutex_lock(&mem_mutex)
+    #define MEM_UNLOCK()    _lv_mutex_unlock(&mem_mutex)
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_mem_slab_t * pool_slab_create(lv_mem_pool_t * pool);
+static lv_mem_slab_t * pool_find_slab(const lv_mem_pool_t * pool, const void * p);
+static void pool_slab_unlink(lv_mem_pool_t * pool, lv_mem_slab_t * s);
+static void pool_slab_to_front(lv_mem_pool_t * pool, lv_mem_slab_t * s);
 #if LV_MEM_CUSTOM == 0
     static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
+#if LV_MEM_TLSF
+    static void tlsf_reset(void);
+    static void * tlsf_alloc(size_t size);
+    static void tlsf_trunc(lv_mem_ent_t * e, size_t size);
+    static void tlsf_release(lv_mem_ent_t * e);
+    static bool tlsf_expand(lv_mem_ent_t * e, size_t size);
+#else
     static void * ent_alloc(lv_mem_ent_t * e, size_t size);
     static void ent_trunc(lv_mem_ent_t * e, size_t size);
+    static void mem_defrag_core(void);
+#endif
 #endif
 
 /**********************
@@ -90,12 +151,18 @@ static uint32_t zero_mem; /*Give the address of this variable if 0 byte should b
     static uint32_t mem_max_size; /*Tracks the maximum total size of memory ever used from the internal heap*/
 #endif
 
-static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
-static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
+#if LV_MEM_CUSTOM == 0 && LV_USE_REFR_THREADS
+    static lv_mutex_t mem_mutex;
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    static uint32_t fl_bitmap;                          /*A bit is set if the first level class has free entries*/
+    static uint16_t sl_bitmap[MEM_FL_CNT];              /*A bit is set if the second level class has free entries*/
+    static uint32_t free_head[MEM_FL_CNT][MEM_SL_CNT];  /*Offset of the first free entry in the classes*/
+#endif
 
-static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_SIZE, .used = 0},
-    {.p = mem_buf2_32, .size = MEM_BUF_SMALL_SIZE, .used = 0}
-};
+static LV_THREAD_LOCAL uint8_t mem_buf_small[MEM_BUF_SMALL_NUM][MEM_BUF_SMALL_SIZE];
+static LV_THREAD_LOCAL uint8_t mem_buf_small_used[MEM_BUF_SMALL_NUM];
 
 /**********************
  *      MACROS
@@ -117,6 +184,10 @@ void _lv_mem_init(void)
 {
 #if LV_MEM_CUSTOM == 0
 
+#if LV_USE_REFR_THREADS
+    _lv_mutex_init(&mem_mutex);
+#endif
+
 #if LV_MEM_ADR == 0
     /*Allocate a large array to store the dynamically allocated data*/
     static LV_MEM_ATTR MEM_UNIT work_mem_int[LV_MEM_SIZE / sizeof(MEM_UNIT)];
@@ -130,6 +201,9 @@ void _lv_mem_init(void)
     full->header.s.used = 0;
     /*The total mem size id reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+#if LV_MEM_TLSF
+    tlsf_reset();
+#endif
 #endif
 }
 
@@ -145,6 +219,9 @@ void _lv_mem_deinit(void)
     full->header.s.used = 0;
     /*The total mem size id reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+#if LV_MEM_TLSF
+    tlsf_reset();
+#endif
 #endif
 }
 
@@ -170,6 +247,11 @@ void * lv_mem_alloc(size_t size)
 
 #if LV_MEM_CUSTOM == 0
     /*Use the built-in allocators*/
+    MEM_LOCK();
+
+#if LV_MEM_TLSF
+    alloc = tlsf_alloc(size);
+#else
     lv_mem_ent_t * e = NULL;
 
     /* Search for a appropriate entry*/
@@ -183,6 +265,16 @@ void * lv_mem_alloc(size_t size)
         }
         /* End if there is not next entry OR the alloc. is successful*/
     } while(e != NULL && alloc == NULL);
+#endif
+
+    /*Update the statistics while the heap is locked*/
+    if(alloc != NULL && (uintptr_t) alloc > (uintptr_t) work_mem) {
+        if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
+            mem_max_size = ((uintptr_t) alloc - (uintptr_t) work_mem) + size;
+        }
+    }
+
+    MEM_UNLOCK();
 
 #else
     /*Use custom, user defined malloc function*/
@@ -207,16 +299,6 @@ void * lv_mem_alloc(size_t size)
     if(alloc == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
     }
-    else {
-#if LV_MEM_CUSTOM == 0
-        /* just a safety check, should always be true */
-        if((uintptr_t) alloc > (uintptr_t) work_mem) {
-            if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
-                mem_max_size = ((uintptr_t) alloc - (uintptr_t) work_mem) + size;
-            }
-        }
-#endif
-    }
 
     return alloc;
 }
@@ -234,6 +316,8 @@ void lv_mem_free(const void * data)
     _lv_memset((void *)data, 0xbb, _lv_mem_get_size(data));
 #endif
 
+    MEM_LOCK();
+
 #if LV_ENABLE_GC == 0
     /*e points to the header*/
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
@@ -241,7 +325,10 @@ void lv_mem_free(const void * data)
 #endif
 
 #if LV_MEM_CUSTOM == 0
-#if LV_MEM_AUTO_DEFRAG
+#if LV_MEM_TLSF
+    /*The adjacent free entries are joined immediately*/
+    tlsf_release(e);
+#elif LV_MEM_AUTO_DEFRAG
     static uint16_t full_defrag_cnt = 0;
     full_defrag_cnt++;
     if(full_defrag_cnt < LV_MEM_FULL_DEFRAG_CNT) {
@@ -261,12 +348,12 @@ void lv_mem_free(const void * data)
     }
     else {
         full_defrag_cnt = 0;
-        lv_mem_defrag();
+        mem_defrag_core();
 
     }
 
 
-#endif /*LV_MEM_AUTO_DEFRAG*/
+#endif /*LV_MEM_TLSF*/
 #else /*Use custom, user defined free function*/
 #if LV_ENABLE_GC == 0
     LV_MEM_CUSTOM_FREE(e);
@@ -274,6 +361,8 @@ void lv_mem_free(const void * data)
     LV_MEM_CUSTOM_FREE((void *)data);
 #endif /*LV_ENABLE_GC*/
 #endif
+
+    MEM_UNLOCK();
 }
 
 /**
@@ -297,6 +386,8 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     new_size = (new_size + 3) & (~0x3);
 #endif
 
+    MEM_LOCK();
+
     /*data_p could be previously freed pointer (in this case it is invalid)*/
     if(data_p != NULL) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
@@ -306,21 +397,44 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     }
 
     uint32_t old_size = _lv_mem_get_size(data_p);
-    if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
+    if(old_size == new_size) {
+        MEM_UNLOCK();
+        return data_p; /*Also avoid reallocating the same memory*/
+    }
 
 #if LV_MEM_CUSTOM == 0
     /* Truncate the memory if the new size is smaller. */
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
+#if LV_MEM_TLSF
+        tlsf_trunc(e, new_size);
+#else
         ent_trunc(e, new_size);
+#endif
+        MEM_UNLOCK();
         return &e->first_data;
     }
+
+#if LV_MEM_TLSF
+    /*Try to grow into the free entry after the data*/
+    if(data_p != NULL && old_size != 0) {
+        lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
+        if(tlsf_expand(e, new_size)) {
+            if((uintptr_t) data_p - (uintptr_t) work_mem + e->header.s.d_size > mem_max_size) {
+                mem_max_size = (uintptr_t) data_p - (uintptr_t) work_mem + e->header.s.d_size;
+            }
+            MEM_UNLOCK();
+            return data_p;
+        }
+    }
+#endif
 #endif
 
     void * new_p;
     new_p = lv_mem_alloc(new_size);
     if(new_p == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
+        MEM_UNLOCK();
         return NULL;
     }
 
@@ -332,6 +446,7 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
         }
     }
 
+    MEM_UNLOCK();
 
     return new_p;
 }
@@ -352,62 +467,36 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
-    lv_mem_ent_t * e_free;
-    lv_mem_ent_t * e_next;
-    e_free = ent_get_next(NULL);
-
-    while(1) {
-        /*Search the next free entry*/
-        while(e_free != NULL) {
-            if(e_free->header.s.used != 0) {
-                e_free = ent_get_next(e_free);
-            }
-            else {
-                break;
-            }
-        }
-
-        if(e_free == NULL) return;
-
-        /*Joint the following free entries to the free*/
-        e_next = ent_get_next(e_free);
-        while(e_next != NULL) {
-            if(e_next->header.s.used == 0) {
-                e_free->header.s.d_size += e_next->header.s.d_size + sizeof(e_next->header);
-            }
-            else {
-                break;
-            }
-
-            e_next = ent_get_next(e_next);
-        }
-
-        if(e_next == NULL) return;
-
-        /*Continue from the lastly checked entry*/
-        e_free = e_next;
-    }
+    /*With TLSF the free entries are joined on free*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
+    MEM_LOCK();
+    mem_defrag_core();
+    MEM_UNLOCK();
 #endif
 }
 
 lv_res_t lv_mem_test(void)
 {
+    lv_res_t res = LV_RES_OK;
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
     lv_mem_ent_t * e;
     e = ent_get_next(NULL);
     while(e) {
         if(e->header.s.d_size > LV_MEM_SIZE) {
-            return LV_RES_INV;
+            res = LV_RES_INV;
+            break;
         }
         uint8_t * e8 = (uint8_t *) e;
         if(e8 + e->header.s.d_size > work_mem + LV_MEM_SIZE) {
-            return LV_RES_INV;
+            res = LV_RES_INV;
+            break;
         }
         e = ent_get_next(e);
     }
+    MEM_UNLOCK();
 #endif
-    return LV_RES_OK;
+    return res;
 }
 
 /**
@@ -420,6 +509,7 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     /*Init the data*/
     _lv_memset(mon_p, 0, sizeof(lv_mem_monitor_t));
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
     lv_mem_ent_t * e;
     e = NULL;
 
@@ -441,6 +531,7 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     }
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->max_used = mem_max_size;
+    MEM_UNLOCK();
     mon_p->used_pct   = 100 - (100U * mon_p->free_size) / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct   = (uint32_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
@@ -490,10 +581,10 @@ void * _lv_mem_buf_get(uint32_t size)
     /*Try small static buffers first*/
     uint8_t i;
     if(size <= MEM_BUF_SMALL_SIZE) {
-        for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-            if(mem_buf_small[i].used == 0) {
-                mem_buf_small[i].used = 1;
-                return mem_buf_small[i].p;
+        for(i = 0; i < MEM_BUF_SMALL_NUM; i++) {
+            if(mem_buf_small_used[i] == 0) {
+                mem_buf_small_used[i] = 1;
+                return mem_buf_small[i];
             }
         }
     }
@@ -549,9 +640,9 @@ void _lv_mem_buf_release(void * p)
     uint8_t i;
 
     /*Try small static buffers first*/
-    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-        if(mem_buf_small[i].p == p) {
-            mem_buf_small[i].used = 0;
+    for(i = 0; i < MEM_BUF_SMALL_NUM; i++) {
+        if(mem_buf_small[i] == p) {
+            mem_buf_small_used[i] = 0;
             return;
         }
     }
@@ -572,8 +663,8 @@ void _lv_mem_buf_release(void * p)
 void _lv_mem_buf_free_all(void)
 {
     uint8_t i;
-    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-        mem_buf_small[i].used = 0;
+    for(i = 0; i < MEM_BUF_SMALL_NUM; i++) {
+        mem_buf_small_used[i] = 0;
     }
 
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
@@ -586,6 +677,115 @@ void _lv_mem_buf_free_all(void)
     }
 }
 
+/**
+ * Initialize a memory pool. No memory is allocated until the first block is requested.
+ * @param pool pointer to a memory pool
+ * @param blk_size size of a block in bytes
+ * @param blk_cnt number of blocks in a slab
+ */
+void _lv_mem_pool_init(lv_mem_pool_t * pool, uint32_t blk_size, uint16_t blk_cnt)
+{
+    /*A free block needs to store a pointer to the next free block*/
+    if(blk_size < sizeof(void *)) blk_size = sizeof(void *);
+
+    pool->slab = NULL;
+    pool->blk_size = (blk_size + ALIGN_MASK) & (~ALIGN_MASK);
+    pool->blk_cnt = blk_cnt;
+    pool->empty_cnt = 0;
+}
+
+/**
+ * Allocate a block from a memory pool. Allocate a new slab if there is no free block.
+ * @param pool pointer to a memory pool
+ * @return pointer to the allocated block or NULL if out of memory
+ */
+void * _lv_mem_pool_alloc(lv_mem_pool_t * pool)
+{
+    lv_mem_slab_t * s = pool->slab;
+    while(s != NULL && s->free_blk == NULL) s = s->next;
+
+    if(s == NULL) {
+        s = pool_slab_create(pool);
+        if(s == NULL) return NULL;
+        pool->empty_cnt++;
+    }
+
+    /*Move the slab to the front to find it quickly next time*/
+    pool_slab_to_front(pool, s);
+
+    void * blk = s->free_blk;
+    s->free_blk = *((void **)blk);
+    if(s->used_cnt == 0) pool->empty_cnt--;
+    s->used_cnt++;
+
+    return blk;
+}
+
+/**
+ * Free a block of a memory pool. If all the blocks of a slab are free the slab is freed too,
+ * unless it's the only empty slab of the pool.
+ * @param pool pointer to a memory pool
+ * @param p pointer to a block of this or an other memory pool
+ * @return LV_RES_OK: the block is freed; LV_RES_INV: `p` is not in the pool
+ */
+lv_res_t _lv_mem_pool_free(lv_mem_pool_t * pool, void * p)
+{
+    lv_mem_slab_t * s = pool_find_slab(pool, p);
+    if(s == NULL) return LV_RES_INV;
+
+#if LV_MEM_ADD_JUNK
+    _lv_memset(p, 0xbb, pool->blk_size);
+#endif
+
+    *((void **)p) = s->free_blk;
+    s->free_blk = p;
+    s->used_cnt--;
+
+    /*Keep one empty slab to not allocate and free a slab again and again around a slab boundary*/
+    if(s->used_cnt == 0 && pool->empty_cnt > 0) {
+        pool_slab_unlink(pool, s);
+        lv_mem_free(s);
+        return LV_RES_OK;
+    }
+
+    if(s->used_cnt == 0) pool->empty_cnt++;
+
+    /*Move the slab to the front to allocate from it next time*/
+    pool_slab_to_front(pool, s);
+
+    return LV_RES_OK;
+}
+
+/**
+ * Tell whether a block belongs to a memory pool
+ * @param pool pointer to a memory pool
+ * @param p pointer to a block of this or an other memory pool
+ * @return true: `p` is a block of the pool
+ */
+bool _lv_mem_pool_owns(const lv_mem_pool_t * pool, const void * p)
+{
+    return pool_find_slab(pool, p) != NULL;
+}
+
+/**
+ * Free the slabs of a memory pool which have no allocated blocks
+ * @param pool pointer to a memory pool
+ */
+void _lv_mem_pool_trim(lv_mem_pool_t * pool)
+{
+    lv_mem_slab_t * s = pool->slab;
+    while(s != NULL) {
+        lv_mem_slab_t * next = s->next;
+        if(s->used_cnt == 0) {
+            pool_slab_unlink(pool, s);
+            lv_mem_free(s);
+        }
+        s = next;
+    }
+
+    pool->empty_cnt = 0;
+}
+
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
  * Same as `memcpy` but optimized for 4 byte operation.
@@ -809,6 +1009,84 @@ LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Allocate a new slab for a memory pool, add all of its blocks to the slab's free list
+ * and add the slab to the front of the pool's slabs.
+ * @param pool pointer to a memory pool
+ * @return pointer to the new slab or NULL if out of memory
+ */
+static lv_mem_slab_t * pool_slab_create(lv_mem_pool_t * pool)
+{
+    uint32_t blk_step = POOL_BLK_HEADER_SIZE + pool->blk_size;
+    lv_mem_slab_t * s = lv_mem_alloc(POOL_SLAB_HEADER_SIZE + blk_step * pool->blk_cnt);
+    if(s == NULL) return NULL;
+
+    s->prev = NULL;
+    s->next = pool->slab;
+    if(pool->slab) pool->slab->prev = s;
+    pool->slab = s;
+    s->used_cnt = 0;
+    s->free_blk = NULL;
+
+    /*Link the blocks from the last so that the first block will be allocated first*/
+    uint8_t * blk = (uint8_t *)s + POOL_SLAB_HEADER_SIZE + blk_step * (pool->blk_cnt - 1) + POOL_BLK_HEADER_SIZE;
+    uint16_t i;
+    for(i = 0; i < pool->blk_cnt; i++) {
+        pool_blk_header_t * h = (pool_blk_header_t *)(blk - POOL_BLK_HEADER_SIZE);
+        h->slab = s;
+        h->check = POOL_BLK_CHECK(pool, s);
+
+        *((void **)blk) = s->free_blk;
+        s->free_blk = blk;
+        blk -= blk_step;
+    }
+
+    return s;
+}
+
+/**
+ * Find the slab of a memory pool which contains a block.
+ * The slab is stored before the block so it doesn't depend on the number of slabs.
+ * @param pool pointer to a memory pool
+ * @param p pointer to a block
+ * @return pointer to the slab or NULL if `p` is not in the pool
+ */
+static lv_mem_slab_t * pool_find_slab(const lv_mem_pool_t * pool, const void * p)
+{
+    const pool_blk_header_t * h = (const pool_blk_header_t *)((const uint8_t *)p - POOL_BLK_HEADER_SIZE);
+    if(h->check != POOL_BLK_CHECK(pool, h->slab)) return NULL;
+
+    return h->slab;
+}
+
+/**
+ * Remove a slab from the slabs of a memory pool
+ * @param pool pointer to a memory pool
+ * @param s pointer to a slab of the pool
+ */
+static void pool_slab_unlink(lv_mem_pool_t * pool, lv_mem_slab_t * s)
+{
+    if(s->prev) s->prev->next = s->next;
+    else pool->slab = s->next;
+    if(s->next) s->next->prev = s->prev;
+}
+
+/**
+ * Move a slab to the front of the slabs of a memory pool
+ * @param pool pointer to a memory pool
+ * @param s pointer to a slab of the pool
+ */
+static void pool_slab_to_front(lv_mem_pool_t * pool, lv_mem_slab_t * s)
+{
+    if(s == pool->slab) return;
+
+    pool_slab_unlink(pool, s);
+    s->prev = NULL;
+    s->next = pool->slab;
+    pool->slab->prev = s;
+    pool->slab = s;
+}
+
 #if LV_MEM_CUSTOM == 0
 /**
  * Give the next entry after 'act_e'
@@ -832,6 +1110,248 @@ static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e)
     return next_e;
 }
 
+#if LV_MEM_TLSF
+
+/**
+ * Get the index of the most significant set bit
+ * @param x a non zero value
+ * @return 0..31
+ */
+static inline uint32_t tlsf_fls(uint32_t x)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    uint32_t i = 0;
+    while(x >>= 1) i++;
+    return i;
+#endif
+}
+
+/**
+ * Get the index of the least significant set bit
+ * @param x a non zero value
+ * @return 0..31
+ */
+static inline uint32_t tlsf_ffs(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    uint32_t i = 0;
+    while((x & 1) == 0) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * Get the class of a free entry with the given size
+ * @param size data size of the entry
+ * @param fl store the first level index here
+ * @param sl store the second level index here
+ */
+static inline void tlsf_mapping(uint32_t size, uint32_t * fl, uint32_t * sl)
+{
+    if(size < MEM_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size >> MEM_ALIGN_LOG2;
+    }
+    else {
+        uint32_t f = tlsf_fls(size);
+        *sl = (size >> (f - MEM_SL_LOG2)) ^ MEM_SL_CNT;
+        *fl = f - MEM_FL_SHIFT + 1;
+    }
+}
+
+/**
+ * Tell the entry after an entry whether its previous entry is free
+ * @param e pointer to an entry
+ * @param prev_free true: `e` is free; false: `e` is used
+ */
+static inline void tlsf_set_prev_free(lv_mem_ent_t * e, bool prev_free)
+{
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next) next->header.s.prev_free = prev_free ? 1 : 0;
+}
+
+/**
+ * Add a free entry to the list of its class
+ * @param e pointer to a free entry
+ */
+static void tlsf_insert(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    uint32_t ofs = (uint32_t)((uint8_t *)e - work_mem);
+    uint32_t * link = (uint32_t *)&e->first_data;
+    link[0] = free_head[fl][sl];
+    link[1] = MEM_FREE_NONE;
+    if(link[0] != MEM_FREE_NONE) ((uint32_t *)&work_mem[link[0] + sizeof(lv_mem_header_t)])[1] = ofs;
+    free_head[fl][sl] = ofs;
+
+    fl_bitmap |= 1UL << fl;
+    sl_bitmap[fl] |= 1U << sl;
+
+    /*Save the size at the end to find the beginning of the entry from the next entry*/
+    uint32_t * footer = (uint32_t *)(&e->first_data + e->header.s.d_size - sizeof(uint32_t));
+    *footer = e->header.s.d_size;
+
+    e->header.s.used = 0;
+    tlsf_set_prev_free(e, true);
+}
+
+/**
+ * Remove a free entry from the list of its class
+ * @param e pointer to a free entry
+ */
+static void tlsf_remove(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    uint32_t * link = (uint32_t *)&e->first_data;
+    if(link[0] != MEM_FREE_NONE) ((uint32_t *)&work_mem[link[0] + sizeof(lv_mem_header_t)])[1] = link[1];
+    if(link[1] != MEM_FREE_NONE) ((uint32_t *)&work_mem[link[1] + sizeof(lv_mem_header_t)])[0] = link[0];
+    else {
+        free_head[fl][sl] = link[0];
+        if(link[0] == MEM_FREE_NONE) {
+            sl_bitmap[fl] &= ~(1U << sl);
+            if(sl_bitmap[fl] == 0) fl_bitmap &= ~(1UL << fl);
+        }
+    }
+
+    tlsf_set_prev_free(e, false);
+}
+
+/**
+ * Initialize the classes with the first entry covering the whole work memory
+ */
+static void tlsf_reset(void)
+{
+    uint32_t fl;
+    uint32_t sl;
+    for(fl = 0; fl < MEM_FL_CNT; fl++) {
+        for(sl = 0; sl < MEM_SL_CNT; sl++) {
+            free_head[fl][sl] = MEM_FREE_NONE;
+        }
+        sl_bitmap[fl] = 0;
+    }
+    fl_bitmap = 0;
+
+    lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
+    full->header.s.prev_free = 0;
+    tlsf_insert(full);
+}
+
+/**
+ * Allocate from the first non empty class whose every entry is large enough
+ * @param size size of the new memory in bytes (already rounded up)
+ * @return pointer to the allocated memory or NULL if there is no large enough free entry
+ */
+static void * tlsf_alloc(size_t size)
+{
+    if(size < MEM_ENT_MIN) size = MEM_ENT_MIN;
+    if(size >= (1UL << MEM_FL_MAX)) return NULL;
+
+    /*Round up the size to the next class to be sure that any entry of the class is large enough*/
+    uint32_t size_search = size;
+    if(size_search >= MEM_SMALL_SIZE) size_search += (1UL << (tlsf_fls(size_search) - MEM_SL_LOG2)) - 1;
+
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(size_search, &fl, &sl);
+    if(fl >= MEM_FL_CNT) return NULL;
+
+    uint32_t sl_map = sl_bitmap[fl] & (~0UL << sl);
+    if(sl_map == 0) {
+        uint32_t fl_map = fl_bitmap & (~0UL << (fl + 1));
+        if(fl_map == 0) return NULL;
+        fl = tlsf_ffs(fl_map);
+        sl_map = sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    lv_mem_ent_t * e = (lv_mem_ent_t *)&work_mem[free_head[fl][sl]];
+    tlsf_remove(e);
+    e->header.s.used = 1;
+    tlsf_trunc(e, size);
+
+    return &e->first_data;
+}
+
+/**
+ * Truncate the data of a used entry and release the remaining part
+ * @param e pointer to a used entry
+ * @param size new size in bytes
+ */
+static void tlsf_trunc(lv_mem_ent_t * e, size_t size)
+{
+    size = (size + ALIGN_MASK) & (~ALIGN_MASK);
+    if(size < MEM_ENT_MIN) size = MEM_ENT_MIN;
+
+    /*Keep the remaining part if it's too small for a free entry*/
+    if(e->header.s.d_size < size + sizeof(lv_mem_header_t) + MEM_ENT_MIN) return;
+
+    lv_mem_ent_t * rest = (lv_mem_ent_t *)(&e->first_data + size);
+    rest->header.s.prev_free = 0;
+    rest->header.s.d_size = (uint32_t)(e->header.s.d_size - size - sizeof(lv_mem_header_t));
+    e->header.s.d_size = (uint32_t)size;
+
+    tlsf_release(rest);
+}
+
+/**
+ * Free an entry, join it with the adjacent free entries and add it to its class
+ * @param e pointer to an entry
+ */
+static void tlsf_release(lv_mem_ent_t * e)
+{
+    e->header.s.used = 0;
+
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next && next->header.s.used == 0) {
+        tlsf_remove(next);
+        e->header.s.d_size += next->header.s.d_size + sizeof(lv_mem_header_t);
+    }
+
+    if(e->header.s.prev_free) {
+        uint32_t prev_size = ((uint32_t *)e)[-1];
+        lv_mem_ent_t * prev = (lv_mem_ent_t *)((uint8_t *)e - prev_size - sizeof(lv_mem_header_t));
+        tlsf_remove(prev);
+        prev->header.s.d_size += e->header.s.d_size + sizeof(lv_mem_header_t);
+        e = prev;
+    }
+
+    tlsf_insert(e);
+}
+
+/**
+ * Grow a used entry into the free entry after it
+ * @param e pointer to a used entry
+ * @param size the new size in bytes (already rounded up)
+ * @return true: the entry is large enough now; false: the next entry is used or too small
+ */
+static bool tlsf_expand(lv_mem_ent_t * e, size_t size)
+{
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next == NULL || next->header.s.used) return false;
+    if(e->header.s.d_size + sizeof(lv_mem_header_t) + next->header.s.d_size < size) return false;
+
+    tlsf_remove(next);
+    e->header.s.d_size += next->header.s.d_size + sizeof(lv_mem_header_t);
+    tlsf_trunc(e, size);
+
+    return true;
+}
+
+#else
+
 /**
  * Try to do the real allocation with a given size
  * @param e try to allocate to this entry
@@ -887,4 +1407,48 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
     e->header.s.d_size = (uint32_t)size;
 }
 
+/**
+ * Join the adjacent free memory blocks. The heap has to be locked.
+ */
+static void mem_defrag_core(void)
+{
+    lv_mem_ent_t * e_free;
+    lv_mem_ent_t * e_next;
+    e_free = ent_get_next(NULL);
+
+    while(1) {
+        /*Search the next free entry*/
+        while(e_free != NULL) {
+            if(e_free->header.s.used != 0) {
+                e_free = ent_get_next(e_free);
+            }
+            else {
+                break;
+            }
+        }
+
+        if(e_free == NULL) return;
+
+        /*Joint the following free entries to the free*/
+        e_next = ent_get_next(e_free);
+        while(e_next != NULL) {
+            if(e_next->header.s.used == 0) {
+                e_free->header.s.d_size += e_next->header.s.d_size + sizeof(e_next->header);
+            }
+            else {
+                break;
+            }
+
+            e_next = ent_get_next(e_next);
+        }
+
+        if(e_next == NULL) return;
+
+        /*Continue from the lastly checked entry*/
+        e_free = e_next;
+    }
+}
+
+#endif /*LV_MEM_TLSF*/
+
 #endif
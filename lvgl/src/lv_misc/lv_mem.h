@@ -17,6 +17,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "lv_log.h"
 #include "lv_types.h"
 
@@ -57,7 +58,27 @@ typedef struct {
 } lv_mem_buf_t;
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
-extern lv_mem_buf_arr_t _lv_mem_buf;
+extern LV_THREAD_LOCAL lv_mem_buf_arr_t _lv_mem_buf;
+
+/**
+ * A slab of a memory pool. The blocks follow the header.
+ */
+typedef struct _lv_mem_slab_t {
+    struct _lv_mem_slab_t * next;
+    struct _lv_mem_slab_t * prev;
+    void * free_blk;        /**< First free block. A free block stores the pointer to the next one*/
+    uint16_t used_cnt;      /**< Number of allocated blocks*/
+} lv_mem_slab_t;
+
+/**
+ * Pool of equally sized blocks. The blocks are allocated in slabs with `lv_mem_alloc`.
+ */
+typedef struct {
+    lv_mem_slab_t * slab;   /**< List of slabs. The last used slab is the first*/
+    uint32_t blk_size;      /**< Size of a block in bytes*/
+    uint16_t blk_cnt;       /**< Number of blocks in a slab*/
+    uint16_t empty_cnt;     /**< Number of slabs without allocated blocks*/
+} lv_mem_pool_t;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -138,6 +159,44 @@ void _lv_mem_buf_release(void * p);
  */
 void _lv_mem_buf_free_all(void);
 
+/**
+ * Initialize a memory pool. No memory is allocated until the first block is requested.
+ * @param pool pointer to a memory pool
+ * @param blk_size size of a block in bytes
+ * @param blk_cnt number of blocks in a slab
+ */
+void _lv_mem_pool_init(lv_mem_pool_t * pool, uint32_t blk_size, uint16_t blk_cnt);
+
+/**
+ * Allocate a block from a memory pool. Allocate a new slab if there is no free block.
+ * @param pool pointer to a memory pool
+ * @return pointer to the allocated block or NULL if out of memory
+ */
+void * _lv_mem_pool_alloc(lv_mem_pool_t * pool);
+
+/**
+ * Free a block of a memory pool. If all the blocks of a slab are free the slab is freed too,
+ * unless it's the only empty slab of the pool.
+ * @param pool pointer to a memory pool
+ * @param p pointer to a block of this or an other memory pool
+ * @return LV_RES_OK: the block is freed; LV_RES_INV: `p` is not in the pool
+ */
+lv_res_t _lv_mem_pool_free(lv_mem_pool_t * pool, void * p);
+
+/**
+ * Tell whether a block belongs to a memory pool
+ * @param pool pointer to a memory pool
+ * @param p pointer to a block of this or an other memory pool
+ * @return true: `p` is a block of the pool
+ */
+bool _lv_mem_pool_owns(const lv_mem_pool_t * pool, const void * p);
+
+/**
+ * Free the slabs of a memory pool which have no allocated blocks
+ * @param pool pointer to a memory pool
+ */
+void _lv_mem_pool_trim(lv_mem_pool_t * pool);
+
 
 //! @cond Doxygen_Suppress
 
@@ -0,0 +1,416 @@
+/**
+ * @file lv_prof.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#if defined(__unix__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L    /*For `clock_gettime()`*/
+#endif
+
+#include "lv_prof.h"
+
+#if LV_USE_PROF
+
+#include "lv_mem.h"
+#include "lv_printf.h"
+#include "lv_thread.h"
+#include "../lv_hal/lv_hal_tick.h"
+
+#if LV_PROF_TIME_CUSTOM
+#include LV_PROF_TIME_CUSTOM_INCLUDE
+#else
+#include <time.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Max. number of nested events on a thread*/
+#define PROF_DEPTH_MAX  32
+
+#define PROF_THREADS    (LV_USE_REFR_THREADS || LV_USE_FLUSH_THREAD)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A started event*/
+typedef struct {
+    uint64_t start;
+    uint64_t child_time;    /*Time of the ended events enclosed by this event*/
+    bool on;                /*The profiler was enabled when the event has started*/
+} prof_level_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static inline uint64_t time_ns(void);
+static inline uint32_t time_clamp(uint64_t t);
+static void stat_add(lv_prof_stat_t * stat, uint32_t t, uint32_t self_t);
+static void frame_finish(uint64_t start, uint32_t t);
+static inline void prof_lock(void);
+static inline void prof_unlock(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static LV_THREAD_LOCAL prof_level_t levels[PROF_DEPTH_MAX];
+static LV_THREAD_LOCAL uint32_t depth;
+static LV_THREAD_LOCAL uint8_t thread_id;
+
+static lv_prof_event_t events[LV_PROF_EVENT_CNT];
+static uint32_t event_head;     /*Index of the next event to write*/
+static uint32_t event_cnt;
+
+static lv_prof_frame_t frames[LV_PROF_FRAME_CNT];
+static uint32_t frame_head;     /*Index of the next frame to write*/
+static uint32_t frame_cnt;
+static lv_prof_frame_t frame_act;  /*The statistics of the frame being refreshed*/
+
+static bool enabled = true;
+static uint32_t event_filter = 0xFFFFFFFF;
+
+#if PROF_THREADS
+static lv_mutex_t prof_mutex;
+#endif
+
+static const char * const stage_names[_LV_PROF_STAGE_LAST] = {
+    [LV_PROF_STAGE_REFR] = "refr",
+    [LV_PROF_STAGE_INV_JOIN] = "inv_join",
+    [LV_PROF_STAGE_AREA] = "area",
+    [LV_PROF_STAGE_TOP_OBJ] = "top_obj",
+    [LV_PROF_STAGE_DESIGN] = "design",
+    [LV_PROF_STAGE_DRAW_RECT] = "draw_rect",
+    [LV_PROF_STAGE_DRAW_LABEL] = "draw_label",
+    [LV_PROF_STAGE_DRAW_IMG] = "draw_img",
+    [LV_PROF_STAGE_DRAW_LINE] = "draw_line",
+    [LV_PROF_STAGE_DRAW_ARC] = "draw_arc",
+    [LV_PROF_STAGE_DRAW_POLYGON] = "draw_polygon",
+    [LV_PROF_STAGE_BLEND_FILL] = "blend_fill",
+    [LV_PROF_STAGE_BLEND_MAP] = "blend_map",
+    [LV_PROF_STAGE_MASK] = "mask",
+    [LV_PROF_STAGE_IMG_DECODE] = "img_decode",
+    [LV_PROF_STAGE_FLUSH] = "flush",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the profiler. Called from `lv_init()`.
+ */
+void _lv_prof_init(void)
+{
+#if PROF_THREADS
+    _lv_mutex_init(&prof_mutex);
+#endif
+    lv_prof_reset();
+}
+
+/**
+ * Start measuring an event. Has to be followed by `_lv_prof_end()` on the same thread.
+ * Events started before the matching `_lv_prof_end()` are enclosed by this event.
+ */
+void _lv_prof_start(void)
+{
+    depth++;
+    if(depth > PROF_DEPTH_MAX) return;  /*Too deep, don't measure it*/
+
+    prof_level_t * l = &levels[depth - 1];
+    l->on = enabled;
+    if(l->on) {
+        l->child_time = 0;
+        l->start = time_ns();
+    }
+}
+
+/**
+ * Finish the last started event on this thread and record it
+ * @param stage the stage of the event
+ * @param name name of the event (e.g. type of a widget) or NULL to use the stage's name.
+ *             It has to be a static string.
+ */
+void _lv_prof_end(lv_prof_stage_t stage, const char * name)
+{
+    if(depth == 0) return;  /*Not started*/
+    depth--;
+    if(depth >= PROF_DEPTH_MAX) return;
+
+    prof_level_t * l = &levels[depth];
+    if(l->on == false) return;
+
+    uint64_t t = time_ns() - l->start;
+    uint64_t self_t = t > l->child_time ? t - l->child_time : 0;
+    if(depth > 0) levels[depth - 1].child_time += t;
+
+    prof_lock();
+
+    stat_add(&frame_act.stages[stage], time_clamp(t), time_clamp(self_t));
+
+    if(event_filter & (1UL << stage)) {
+        lv_prof_event_t * e = &events[event_head];
+        e->start = l->start;
+        e->time = time_clamp(t);
+        e->frame_id = frame_act.id;
+        e->name = name;
+        e->stage = stage;
+        e->depth = depth;
+        e->thread_id = thread_id;
+
+        event_head++;
+        if(event_head >= LV_PROF_EVENT_CNT) event_head = 0;
+        if(event_cnt < LV_PROF_EVENT_CNT) event_cnt++;
+    }
+
+    /*The end of a display refresh closes the frame*/
+    if(stage == LV_PROF_STAGE_REFR && depth == 0 && thread_id == 0) {
+        frame_finish(l->start, time_clamp(t));
+    }
+
+    prof_unlock();
+}
+
+/**
+ * Set the ID of the calling thread used in the recorded events
+ * @param id 0 for the thread calling `lv_task_handler()`; a unique number for the other threads
+ */
+void _lv_prof_set_thread_id(uint8_t id)
+{
+    thread_id = id;
+}
+
+/**
+ * Enable or disable the recording of the events. It's enabled by default.
+ * @param en true: enable; false: disable
+ */
+void lv_prof_set_enabled(bool en)
+{
+    enabled = en;
+}
+
+/**
+ * Tell whether the events are recorded
+ * @return true: enabled; false: disabled
+ */
+bool lv_prof_is_enabled(void)
+{
+    return enabled;
+}
+
+/**
+ * Select the stages whose events are stored in the event buffer (the frame statistics contain all stages).
+ * E.g. leave out the frequent blending and masking events to fit more frames into the buffer.
+ * @param mask OR-ed `1 << LV_PROF_STAGE_...` values. All stages are stored by default.
+ */
+void lv_prof_set_event_filter(uint32_t mask)
+{
+    event_filter = mask;
+}
+
+/**
+ * Delete the recorded events and frames
+ */
+void lv_prof_reset(void)
+{
+    prof_lock();
+    event_head = 0;
+    event_cnt = 0;
+    frame_head = 0;
+    frame_cnt = 0;
+    _lv_memset_00(frame_act.stages, sizeof(frame_act.stages));
+    prof_unlock();
+}
+
+/**
+ * Get the number of events in the event buffer
+ * @return number of events, at most `LV_PROF_EVENT_CNT`
+ */
+uint32_t lv_prof_get_event_cnt(void)
+{
+    return event_cnt;
+}
+
+/**
+ * Get an event from the event buffer
+ * @param id index of the event. 0: the oldest event
+ * @param event store the event here
+ * @return true: `event` is set; false: `id` is invalid
+ */
+bool lv_prof_get_event(uint32_t id, lv_prof_event_t * event)
+{
+    bool res = false;
+    prof_lock();
+    if(id < event_cnt) {
+        *event = events[(event_head + LV_PROF_EVENT_CNT - event_cnt + id) % LV_PROF_EVENT_CNT];
+        res = true;
+    }
+    prof_unlock();
+
+    return res;
+}
+
+/**
+ * Get the number of frames whose statistics are stored
+ * @return number of frames, at most `LV_PROF_FRAME_CNT`
+ */
+uint32_t lv_prof_get_frame_cnt(void)
+{
+    return frame_cnt;
+}
+
+/**
+ * Get the statistics of a frame
+ * @param id index of the frame. 0: the latest frame
+ * @param frame store the statistics here
+ * @return true: `frame` is set; false: `id` is invalid
+ */
+bool lv_prof_get_frame(uint32_t id, lv_prof_frame_t * frame)
+{
+    bool res = false;
+    prof_lock();
+    if(id < frame_cnt) {
+        *frame = frames[(frame_head + LV_PROF_FRAME_CNT - 1 - id) % LV_PROF_FRAME_CNT];
+        res = true;
+    }
+    prof_unlock();
+
+    return res;
+}
+
+/**
+ * Get the name of a stage
+ * @param stage a stage
+ * @return name of the stage, e.g. "draw_rect"
+ */
+const char * lv_prof_get_stage_name(lv_prof_stage_t stage)
+{
+    if(stage >= _LV_PROF_STAGE_LAST) return "unknown";
+    return stage_names[stage];
+}
+
+/**
+ * Write the events of the event buffer in the Trace Event Format of Chrome
+ * (can be opened in `chrome://tracing` or https://ui.perfetto.dev)
+ * @param write_cb called to write the parts of the output
+ * @param user_data parameter of `write_cb`
+ * @return number of written events
+ */
+uint32_t lv_prof_export_chrome_trace(lv_prof_write_cb_t write_cb, void * user_data)
+{
+    char buf[192];
+    int len;
+
+    prof_lock();
+
+    /*Write the time stamps relative to the earliest event*/
+    uint32_t first = (event_head + LV_PROF_EVENT_CNT - event_cnt) % LV_PROF_EVENT_CNT;
+    uint64_t t0 = UINT64_MAX;
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        const lv_prof_event_t * e = &events[(first + i) % LV_PROF_EVENT_CNT];
+        if(e->start < t0) t0 = e->start;
+    }
+
+    len = lv_snprintf(buf, sizeof(buf), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    write_cb(user_data, buf, len);
+
+    for(i = 0; i < event_cnt; i++) {
+        const lv_prof_event_t * e = &events[(first + i) % LV_PROF_EVENT_CNT];
+        const char * stage_name = lv_prof_get_stage_name(e->stage);
+        uint64_t ts = e->start - t0;
+        len = lv_snprintf(buf, sizeof(buf),
+                          "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lu.%03lu,\"dur\":%lu.%03lu,"
+                          "\"pid\":0,\"tid\":%u,\"args\":{\"frame\":%lu}}%s\n",
+                          e->name ? e->name : stage_name, stage_name,
+                          (unsigned long)(ts / 1000), (unsigned long)(ts % 1000),
+                          (unsigned long)(e->time / 1000), (unsigned long)(e->time % 1000),
+                          (unsigned int)e->thread_id, (unsigned long)e->frame_id,
+                          i + 1 < event_cnt ? "," : "");
+        if(len >= (int)sizeof(buf)) len = sizeof(buf) - 1;
+        write_cb(user_data, buf, len);
+    }
+
+    len = lv_snprintf(buf, sizeof(buf), "]}\n");
+    write_cb(user_data, buf, len);
+
+    prof_unlock();
+
+    return event_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the current time
+ * @return the time in nanoseconds
+ */
+static inline uint64_t time_ns(void)
+{
+#if LV_PROF_TIME_CUSTOM
+    return (uint64_t)(LV_PROF_TIME_CUSTOM_NS_EXPR);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#else
+    return (uint64_t)lv_tick_get() * 1000000;
+#endif
+}
+
+static inline uint32_t time_clamp(uint64_t t)
+{
+    return t > UINT32_MAX ? UINT32_MAX : (uint32_t)t;
+}
+
+static void stat_add(lv_prof_stat_t * stat, uint32_t t, uint32_t self_t)
+{
+    stat->cnt++;
+    stat->time = time_clamp((uint64_t)stat->time + t);
+    stat->self_time = time_clamp((uint64_t)stat->self_time + self_t);
+    if(t > stat->max_time) stat->max_time = t;
+}
+
+/**
+ * Save the statistics of the current frame in the frame buffer and start a new frame
+ * @param start start time of the frame's refresh
+ * @param t duration of the frame's refresh
+ */
+static void frame_finish(uint64_t start, uint32_t t)
+{
+    frame_act.start = start;
+    frame_act.time = t;
+    frames[frame_head] = frame_act;
+
+    frame_head++;
+    if(frame_head >= LV_PROF_FRAME_CNT) frame_head = 0;
+    if(frame_cnt < LV_PROF_FRAME_CNT) frame_cnt++;
+
+    frame_act.id++;
+    _lv_memset_00(frame_act.stages, sizeof(frame_act.stages));
+}
+
+static inline void prof_lock(void)
+{
+#if PROF_THREADS
+    _lv_mutex_lock(&prof_mutex);
+#endif
+}
+
+static inline void prof_unlock(void)
+{
+#if PROF_THREADS
+    _lv_mutex_unlock(&prof_mutex);
+#endif
+}
+
+#endif /*LV_USE_PROF*/
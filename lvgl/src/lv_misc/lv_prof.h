@@ -0,0 +1,211 @@
+/**
+ * @file lv_prof.h
+ * Measure the time of the rendering stages
+ */
+
+#ifndef LV_PROF_H
+#define LV_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The measured stages of the rendering
+ */
+enum {
+    LV_PROF_STAGE_REFR,         /**< Refreshing a display (a frame)*/
+    LV_PROF_STAGE_INV_JOIN,     /**< Joining the invalidated areas*/
+    LV_PROF_STAGE_AREA,         /**< Drawing an area into a draw buffer*/
+    LV_PROF_STAGE_TOP_OBJ,      /**< Searching the top object which covers an area*/
+    LV_PROF_STAGE_DESIGN,       /**< Drawing a widget with its children*/
+    LV_PROF_STAGE_DRAW_RECT,
+    LV_PROF_STAGE_DRAW_LABEL,
+    LV_PROF_STAGE_DRAW_IMG,
+    LV_PROF_STAGE_DRAW_LINE,
+    LV_PROF_STAGE_DRAW_ARC,
+    LV_PROF_STAGE_DRAW_POLYGON,
+    LV_PROF_STAGE_BLEND_FILL,
+    LV_PROF_STAGE_BLEND_MAP,
+    LV_PROF_STAGE_MASK,         /**< Applying the masks on a line*/
+    LV_PROF_STAGE_IMG_DECODE,   /**< Opening an image or reading a line of it with an image decoder*/
+    LV_PROF_STAGE_FLUSH,        /**< Calling `flush_cb`. On the flush thread it might end in the next frame.*/
+    _LV_PROF_STAGE_LAST,
+};
+typedef uint8_t lv_prof_stage_t;
+
+/**
+ * A timed event of a stage
+ */
+typedef struct {
+    uint64_t start;         /**< Start time [ns]*/
+    uint32_t time;          /**< Duration [ns]*/
+    uint32_t frame_id;      /**< ID of the frame during which the event has ended*/
+    const char * name;      /**< Type of the widget for `LV_PROF_STAGE_DESIGN`, else NULL*/
+    lv_prof_stage_t stage;
+    uint8_t depth;          /**< Number of events enclosing this event on the same thread*/
+    uint8_t thread_id;      /**< 0: the thread calling `lv_task_handler()`; else a rendering or flush thread*/
+} lv_prof_event_t;
+
+/**
+ * Aggregated time of a stage
+ */
+typedef struct {
+    uint32_t cnt;           /**< Number of events*/
+    uint32_t time;          /**< Total time including the enclosed stages [ns]*/
+    uint32_t self_time;     /**< Total time without the enclosed stages [ns]*/
+    uint32_t max_time;      /**< The longest event [ns]*/
+} lv_prof_stat_t;
+
+/**
+ * The statistics of a frame
+ */
+typedef struct {
+    uint64_t start;         /**< Start time of the refresh [ns]*/
+    uint32_t time;          /**< Duration of the refresh [ns]*/
+    uint32_t id;            /**< Incremented for every frame*/
+    lv_prof_stat_t stages[_LV_PROF_STAGE_LAST];
+} lv_prof_frame_t;
+
+/**
+ * Called by `lv_prof_export_chrome_trace()` to write the next part of the output
+ * @param user_data the parameter given to `lv_prof_export_chrome_trace()`
+ * @param buf the characters to write (not '\0' terminated)
+ * @param len number of characters in `buf`
+ */
+typedef void (*lv_prof_write_cb_t)(void * user_data, const char * buf, uint32_t len);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_USE_PROF
+
+/**
+ * Initialize the profiler. Called from `lv_init()`.
+ */
+void _lv_prof_init(void);
+
+/**
+ * Start measuring an event. Has to be followed by `_lv_prof_end()` on the same thread.
+ * Events started before the matching `_lv_prof_end()` are enclosed by this event.
+ */
+void _lv_prof_start(void);
+
+/**
+ * Finish the last started event on this thread and record it
+ * @param stage the stage of the event
+ * @param name name of the event (e.g. type of a widget) or NULL to use the stage's name.
+ *             It has to be a static string.
+ */
+void _lv_prof_end(lv_prof_stage_t stage, const char * name);
+
+/**
+ * Set the ID of the calling thread used in the recorded events
+ * @param id 0 for the thread calling `lv_task_handler()`; a unique number for the other threads
+ */
+void _lv_prof_set_thread_id(uint8_t id);
+
+/**
+ * Enable or disable the recording of the events. It's enabled by default.
+ * @param en true: enable; false: disable
+ */
+void lv_prof_set_enabled(bool en);
+
+/**
+ * Tell whether the events are recorded
+ * @return true: enabled; false: disabled
+ */
+bool lv_prof_is_enabled(void);
+
+/**
+ * Select the stages whose events are stored in the event buffer (the frame statistics contain all stages).
+ * E.g. leave out the frequent blending and masking events to fit more frames into the buffer.
+ * @param mask OR-ed `1 << LV_PROF_STAGE_...` values. All stages are stored by default.
+ */
+void lv_prof_set_event_filter(uint32_t mask);
+
+/**
+ * Delete the recorded events and frames
+ */
+void lv_prof_reset(void);
+
+/**
+ * Get the number of events in the event buffer
+ * @return number of events, at most `LV_PROF_EVENT_CNT`
+ */
+uint32_t lv_prof_get_event_cnt(void);
+
+/**
+ * Get an event from the event buffer
+ * @param id index of the event. 0: the oldest event
+ * @param event store the event here
+ * @return true: `event` is set; false: `id` is invalid
+ */
+bool lv_prof_get_event(uint32_t id, lv_prof_event_t * event);
+
+/**
+ * Get the number of frames whose statistics are stored
+ * @return number of frames, at most `LV_PROF_FRAME_CNT`
+ */
+uint32_t lv_prof_get_frame_cnt(void);
+
+/**
+ * Get the statistics of a frame
+ * @param id index of the frame. 0: the latest frame
+ * @param frame store the statistics here
+ * @return true: `frame` is set; false: `id` is invalid
+ */
+bool lv_prof_get_frame(uint32_t id, lv_prof_frame_t * frame);
+
+/**
+ * Get the name of a stage
+ * @param stage a stage
+ * @return name of the stage, e.g. "draw_rect"
+ */
+const char * lv_prof_get_stage_name(lv_prof_stage_t stage);
+
+/**
+ * Write the events of the event buffer in the Trace Event Format of Chrome
+ * (can be opened in `chrome://tracing` or https://ui.perfetto.dev)
+ * @param write_cb called to write the parts of the output
+ * @param user_data parameter of `write_cb`
+ * @return number of written events
+ */
+uint32_t lv_prof_export_chrome_trace(lv_prof_write_cb_t write_cb, void * user_data);
+
+#endif /*LV_USE_PROF*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#if LV_USE_PROF
+#define LV_PROF_START()             _lv_prof_start()
+#define LV_PROF_END(stage, name)    _lv_prof_end(stage, name)
+#else
+#define LV_PROF_START()
+#define LV_PROF_END(stage, name)
+#endif
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PROF_H*/
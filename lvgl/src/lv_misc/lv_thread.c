@@ -0,0 +1,143 @@
+/**
+ * @file lv_thread.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_thread.h"
+
+#if LV_USE_REFR_THREADS || LV_USE_FLUSH_THREAD
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize a recursive mutex
+ * @param mutex pointer to a mutex to initialize
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t _lv_mutex_init(lv_mutex_t * mutex)
+{
+    pthread_mutexattr_t attr;
+    if(pthread_mutexattr_init(&attr) != 0) return LV_RES_INV;
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    int ret = pthread_mutex_init(mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    return ret == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+/**
+ * Lock a mutex. It can be locked again from the same thread.
+ * @param mutex pointer to an initialized mutex
+ */
+void _lv_mutex_lock(lv_mutex_t * mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+/**
+ * Unlock a mutex
+ * @param mutex pointer to a mutex locked by this thread
+ */
+void _lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+/**
+ * Free the resources of a mutex
+ * @param mutex pointer to an unlocked mutex
+ */
+void _lv_mutex_destroy(lv_mutex_t * mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+/**
+ * Initialize a condition variable
+ * @param cond pointer to a condition variable to initialize
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t _lv_cond_init(lv_cond_t * cond)
+{
+    return pthread_cond_init(cond, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+/**
+ * Wait for a condition variable to be signaled
+ * @param cond pointer to a condition variable
+ * @param mutex the mutex protecting the condition. It has to be locked exactly once by the caller.
+ */
+void _lv_cond_wait(lv_cond_t * cond, lv_mutex_t * mutex)
+{
+    pthread_cond_wait(cond, mutex);
+}
+
+/**
+ * Wake up all threads waiting for a condition variable
+ * @param cond pointer to a condition variable
+ */
+void _lv_cond_broadcast(lv_cond_t * cond)
+{
+    pthread_cond_broadcast(cond);
+}
+
+/**
+ * Free the resources of a condition variable
+ * @param cond pointer to a condition variable nobody waits for
+ */
+void _lv_cond_destroy(lv_cond_t * cond)
+{
+    pthread_cond_destroy(cond);
+}
+
+/**
+ * Start a new thread
+ * @param thread store the thread's handle here
+ * @param cb the thread's function
+ * @param user_data parameter of `cb`
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t _lv_thread_create(lv_thread_t * thread, lv_thread_cb_t cb, void * user_data)
+{
+    return pthread_create(thread, NULL, cb, user_data) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+/**
+ * Wait until a thread returns
+ * @param thread pointer to a thread started by `_lv_thread_create()`
+ */
+void _lv_thread_join(lv_thread_t * thread)
+{
+    pthread_join(*thread, NULL);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_USE_REFR_THREADS || LV_USE_FLUSH_THREAD*/
@@ -0,0 +1,117 @@
+/**
+ * @file lv_thread.h
+ * Minimal threading primitives used by the rendering and flush threads.
+ */
+
+#ifndef LV_THREAD_H
+#define LV_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_types.h"
+
+#if LV_USE_REFR_THREADS || LV_USE_FLUSH_THREAD
+
+#include <pthread.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef pthread_mutex_t lv_mutex_t;
+typedef pthread_cond_t lv_cond_t;
+typedef pthread_t lv_thread_t;
+
+typedef void * (*lv_thread_cb_t)(void *);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a recursive mutex
+ * @param mutex pointer to a mutex to initialize
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t _lv_mutex_init(lv_mutex_t * mutex);
+
+/**
+ * Lock a mutex. It can be locked again from the same thread.
+ * @param mutex pointer to an initialized mutex
+ */
+void _lv_mutex_lock(lv_mutex_t * mutex);
+
+/**
+ * Unlock a mutex
+ * @param mutex pointer to a mutex locked by this thread
+ */
+void _lv_mutex_unlock(lv_mutex_t * mutex);
+
+/**
+ * Free the resources of a mutex
+ * @param mutex pointer to an unlocked mutex
+ */
+void _lv_mutex_destroy(lv_mutex_t * mutex);
+
+/**
+ * Initialize a condition variable
+ * @param cond pointer to a condition variable to initialize
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t _lv_cond_init(lv_cond_t * cond);
+
+/**
+ * Wait for a condition variable to be signaled
+ * @param cond pointer to a condition variable
+ * @param mutex the mutex protecting the condition. It has to be locked exactly once by the caller.
+ */
+void _lv_cond_wait(lv_cond_t * cond, lv_mutex_t * mutex);
+
+/**
+ * Wake up all threads waiting for a condition variable
+ * @param cond pointer to a condition variable
+ */
+void _lv_cond_broadcast(lv_cond_t * cond);
+
+/**
+ * Free the resources of a condition variable
+ * @param cond pointer to a condition variable nobody waits for
+ */
+void _lv_cond_destroy(lv_cond_t * cond);
+
+/**
+ * Start a new thread
+ * @param thread store the thread's handle here
+ * @param cb the thread's function. Its return value is ignored.
+ * @param user_data parameter of `cb`
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t _lv_thread_create(lv_thread_t * thread, lv_thread_cb_t cb, void * user_data);
+
+/**
+ * Wait until a thread returns
+ * @param thread pointer to a thread started by `_lv_thread_create()`
+ */
+void _lv_thread_join(lv_thread_t * thread);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_REFR_THREADS || LV_USE_FLUSH_THREAD*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_THREAD_H*/
@@ -13,6 +13,7 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include "../lv_conf_internal.h"
 
 /*********************
  *      DEFINES
@@ -79,6 +80,19 @@ typedef uint32_t lv_uintptr_t;
 
 #define LV_UNUSED(x) ((void) x)
 
+/*Storage class of the state which has to be private for every rendering thread and the flush thread*/
+#if LV_USE_REFR_THREADS || LV_USE_FLUSH_THREAD
+#  if defined(__cplusplus)
+#    define LV_THREAD_LOCAL thread_local
+#  elif __STDC_VERSION__ >= 201112L
+#    define LV_THREAD_LOCAL _Thread_local
+#  else
+#    define LV_THREAD_LOCAL __thread
+#  endif
+#else
+#  define LV_THREAD_LOCAL
+#endif
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
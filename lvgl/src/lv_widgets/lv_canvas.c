@@ -13,6 +13,7 @@
 #include "../lv_draw/lv_draw.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_themes/lv_theme.h"
+#include "../lv_gpu/lv_gpu_simd.h"
 
 #if LV_USE_CANVAS != 0
 
@@ -21,6 +22,15 @@
  *********************/
 #define LV_OBJX_NAME "lv_canvas"
 
+/*Channels of a pixel in the fast blur. With 32 bit colors the bytes of the pixel, else red, green, blue and alpha.*/
+#define BLUR_CH_CNT     4
+
+/*Number of lines blurred together by the fast blur. A strip of rows is 2 cache lines wide with 32 bit colors.*/
+#define BLUR_STRIP_W    32
+
+/*The largest box of the fast blur. 255 * 257 still fits into the 16 bit sums.*/
+#define BLUR_WIN_MAX    257
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -50,6 +60,17 @@ static void set_px_cb_alpha8(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t
 
 static void set_px_alpha_generic(lv_img_dsc_t * d, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa);
 
+static bool blur_get_area(const lv_img_dsc_t * dsc, const lv_area_t * area, lv_area_t * res);
+static void blur_hor(lv_obj_t * canvas, const lv_area_t * a, uint16_t r);
+static void blur_ver(lv_obj_t * canvas, const lv_area_t * a, uint16_t r);
+static bool blur_is_fast(const lv_img_dsc_t * dsc, uint16_t r);
+static bool blur_fast(lv_img_dsc_t * dsc, const lv_area_t * a, uint16_t r, bool hor);
+static void blur_line_read(const lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, bool col,
+                           uint8_t * ch);
+static uint8_t * blur_line_out(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool col, uint8_t * ch);
+static void blur_line_write(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, bool col,
+                            const uint8_t * ch);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -393,124 +414,9 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > ext->dsc.header.w - 1) a.x2 = ext->dsc.header.w - 1;
-        if(a.y2 > ext->dsc.header.h - 1) a.y2 = ext->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = ext->dsc.header.w - 1;
-        a.y2 = ext->dsc.header.h - 1;
-    }
-
-    lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(ext->dsc.header.cf);
-
-    lv_coord_t line_w = lv_img_buf_get_img_size(ext->dsc.header.w, 1, ext->dsc.header.cf);
-    uint8_t * line_buf = _lv_mem_buf_get(line_w);
-
-    lv_img_dsc_t line_img;
-    line_img.data = line_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = ext->dsc.header.w;
-    line_img.header.h = 1;
-    line_img.header.cf = ext->dsc.header.cf;
-
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t x_safe;
-
-    for(y = a.y1; y <= a.y2; y++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
-
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_TRANSP;
-        _lv_memcpy(line_buf, &ext->dsc.data[y * line_w], line_w);
-
-
-        for(x = a.x1 - r_back; x <= a.x1 + r_front; x++) {
-            x_safe = x < 0 ? 0 : x;
-            x_safe = x_safe > ext->dsc.header.w - 1 ? ext->dsc.header.w - 1 : x_safe;
-
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(x = a.x1; x <= a.x2; x++) {
-
-            if(asum) {
-                c.ch.red = rsum / r;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-                uint8_t gtmp = gsum / r;
-                c.ch.green_h = gtmp >> 3;
-                c.ch.green_l = gtmp & 0x7;
-#else
-                c.ch.green = gsum / r;
-#endif
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
-
-                lv_img_buf_set_px_color(&ext->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&ext->dsc, x, y, opa);
-
-            x_safe = x - r_back;
-            x_safe = x_safe < 0 ? 0 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum -= c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum -= c.ch.green;
-#endif
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
-
-            x_safe = x + 1 + r_front;
-            x_safe = x_safe > ext->dsc.header.w - 1 ? ext->dsc.header.w - 1 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, LV_COLOR_RED);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
+    if(blur_get_area(&ext->dsc, area, &a)) blur_hor(canvas, &a, r);
 
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-    }
     lv_obj_invalidate(canvas);
-
-    _lv_mem_buf_release(line_buf);
 }
 
 
@@ -529,128 +435,53 @@ void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > ext->dsc.header.w - 1) a.x2 = ext->dsc.header.w - 1;
-        if(a.y2 > ext->dsc.header.h - 1) a.y2 = ext->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = ext->dsc.header.w - 1;
-        a.y2 = ext->dsc.header.h - 1;
-    }
-
-    lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(ext->dsc.header.cf);
-    lv_coord_t col_w = lv_img_buf_get_img_size(1, ext->dsc.header.h, ext->dsc.header.cf);
-    uint8_t * col_buf = _lv_mem_buf_get(col_w);
-    lv_img_dsc_t line_img;
-
-    line_img.data = col_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = 1;
-    line_img.header.h = ext->dsc.header.h;
-    line_img.header.cf = ext->dsc.header.cf;
+    if(blur_get_area(&ext->dsc, area, &a)) blur_ver(canvas, &a, r);
 
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t y_safe;
-
-    for(x = a.x1; x <= a.x2; x++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
-
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_COVER;
+    lv_obj_invalidate(canvas);
+}
 
-        for(y = a.y1 - r_back; y <= a.y1 + r_front; y++) {
-            y_safe = y < 0 ? 0 : y;
-            y_safe = y_safe > ext->dsc.header.h - 1 ? ext->dsc.header.h - 1 : y_safe;
+/**
+ * Blur the canvas in both directions. The blur of `r` size is split into `pass_cnt` smaller box blurs
+ * which give about the same amount of blur but the more passes the closer the result is to a Gaussian blur.
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param r radius of the blur
+ * @param pass_cnt number of box blurs in each direction.
+ *                 1: the same as `lv_canvas_blur_hor` and `lv_canvas_blur_ver`; 3: close to a Gaussian blur
+ */
+void lv_canvas_blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r, uint8_t pass_cnt)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
 
-            c = lv_img_buf_get_px_color(&ext->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&ext->dsc, x, y_safe);
+    if(r == 0 || pass_cnt == 0) return;
 
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
+    lv_area_t a;
+    if(blur_get_area(&ext->dsc, area, &a)) {
+        /*The variance of a box blur of `w` size is (w^2 - 1) / 12 and the variances of the passes add up.
+         *So use `w` and `w + 1` sizes whose (w^2 - 1) add up to about r^2 - 1.*/
+        uint32_t var = (uint32_t)r * r - 1;
+        uint32_t w = 1;
+        while((uint64_t)(w + 1) * (w + 1) <= var / pass_cnt + 1) w++;
+
+        /*A pass of `w + 1` size adds 2 * w + 1 to the variance*/
+        uint32_t var_rest = var - pass_cnt * (w * w - 1);
+        uint32_t large_cnt = LV_MATH_MIN((var_rest + w) / (2 * w + 1), pass_cnt);
+
+        /*A box of 1 size wouldn't change anything*/
+        uint8_t i;
+        for(i = 0; i < pass_cnt; i++) {
+            uint16_t pass_r = i < large_cnt ? w + 1 : w;
+            if(pass_r > 1) blur_hor(canvas, &a, pass_r);
         }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(y = a.y1; y <= a.y2; y++) {
-            if(asum) {
-                c.ch.red = rsum / r;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-                uint8_t gtmp = gsum / r;
-                c.ch.green_h = gtmp >> 3;
-                c.ch.green_l = gtmp & 0x7;
-#else
-                c.ch.green = gsum / r;
-#endif
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
-
-                lv_img_buf_set_px_color(&ext->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&ext->dsc, x, y, opa);
-
-            y_safe = y - r_back;
-            y_safe = y_safe < 0 ? 0 : y_safe;
-            c = lv_img_buf_get_px_color(&line_img, 0, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, 0, y_safe);
-
-            rsum -= c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum -= c.ch.green;
-#endif
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
-
-            y_safe = y + 1 + r_front;
-            y_safe = y_safe > ext->dsc.header.h - 1 ? ext->dsc.header.h - 1 : y_safe;
-
-            c = lv_img_buf_get_px_color(&ext->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&ext->dsc, x, y_safe);
-
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
+        for(i = 0; i < pass_cnt; i++) {
+            uint16_t pass_r = i < large_cnt ? w + 1 : w;
+            if(pass_r > 1) blur_ver(canvas, &a, pass_r);
         }
     }
 
     lv_obj_invalidate(canvas);
-
-    _lv_mem_buf_release(col_buf);
 }
 
 /**
@@ -1238,4 +1069,489 @@ static void set_px_true_color_alpha(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_
     lv_img_buf_set_px_color(&d, x, y, res_color);
 }
 
+/**
+ * Get the area of the canvas to blur
+ * @param dsc the canvas' image
+ * @param area the area to blur or `NULL` to blur the whole canvas
+ * @param res store the area clipped to the canvas here
+ * @return true: the area is on the canvas; false: nothing to blur
+ */
+static bool blur_get_area(const lv_img_dsc_t * dsc, const lv_area_t * area, lv_area_t * res)
+{
+    lv_area_t canvas_area;
+    canvas_area.x1 = 0;
+    canvas_area.y1 = 0;
+    canvas_area.x2 = dsc->header.w - 1;
+    canvas_area.y2 = dsc->header.h - 1;
+
+    if(area == NULL) {
+        lv_area_copy(res, &canvas_area);
+        return true;
+    }
+
+    return _lv_area_intersect(res, area, &canvas_area);
+}
+
+/**
+ * Apply horizontal box blur on an area of the canvas
+ * @param canvas pointer to a canvas object
+ * @param a the area to blur. It's on the canvas.
+ * @param r size of the box
+ */
+static void blur_hor(lv_obj_t * canvas, const lv_area_t * a, uint16_t r)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+    if(blur_is_fast(&ext->dsc, r) && blur_fast(&ext->dsc, a, r, true)) return;
+
+    lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
+
+    uint16_t r_back = r / 2;
+    uint16_t r_front = r / 2;
+
+    if((r & 0x1) == 0) r_back--;
+
+    bool has_alpha = lv_img_cf_has_alpha(ext->dsc.header.cf);
+
+    lv_coord_t line_w = lv_img_buf_get_img_size(ext->dsc.header.w, 1, ext->dsc.header.cf);
+    uint8_t * line_buf = _lv_mem_buf_get(line_w);
+
+    lv_img_dsc_t line_img;
+    line_img.data = line_buf;
+    line_img.header.always_zero = 0;
+    line_img.header.w = ext->dsc.header.w;
+    line_img.header.h = 1;
+    line_img.header.cf = ext->dsc.header.cf;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    lv_coord_t x_safe;
+
+    for(y = a->y1; y <= a->y2; y++) {
+        uint32_t asum = 0;
+        uint32_t rsum = 0;
+        uint32_t gsum = 0;
+        uint32_t bsum = 0;
+
+        lv_color_t c;
+        lv_opa_t opa = LV_OPA_TRANSP;
+        _lv_memcpy(line_buf, &ext->dsc.data[y * line_w], line_w);
+
+
+        for(x = a->x1 - r_back; x <= a->x1 + r_front; x++) {
+            x_safe = x < 0 ? 0 : x;
+            x_safe = x_safe > ext->dsc.header.w - 1 ? ext->dsc.header.w - 1 : x_safe;
+
+            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
+            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
+
+            rsum += c.ch.red;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            gsum += (c.ch.green_h << 3) + c.ch.green_l;
+#else
+            gsum += c.ch.green;
+#endif
+            bsum += c.ch.blue;
+            if(has_alpha) asum += opa;
+        }
+
+        /*Just to indicate that the px is visible*/
+        if(has_alpha == false) asum = LV_OPA_COVER;
+
+        for(x = a->x1; x <= a->x2; x++) {
+
+            if(asum) {
+                c.ch.red = rsum / r;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+                uint8_t gtmp = gsum / r;
+                c.ch.green_h = gtmp >> 3;
+                c.ch.green_l = gtmp & 0x7;
+#else
+                c.ch.green = gsum / r;
+#endif
+                c.ch.blue = bsum / r;
+                if(has_alpha) opa = asum / r;
+
+                lv_img_buf_set_px_color(&ext->dsc, x, y, c);
+            }
+            if(has_alpha) lv_img_buf_set_px_alpha(&ext->dsc, x, y, opa);
+
+            x_safe = x - r_back;
+            x_safe = x_safe < 0 ? 0 : x_safe;
+            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
+            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
+
+            rsum -= c.ch.red;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
+#else
+            gsum -= c.ch.green;
+#endif
+            bsum -= c.ch.blue;
+            if(has_alpha) asum -= opa;
+
+            x_safe = x + 1 + r_front;
+            x_safe = x_safe > ext->dsc.header.w - 1 ? ext->dsc.header.w - 1 : x_safe;
+            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, LV_COLOR_RED);
+            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
+
+            rsum += c.ch.red;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            gsum += (c.ch.green_h << 3) + c.ch.green_l;
+#else
+            gsum += c.ch.green;
+#endif
+            bsum += c.ch.blue;
+            if(has_alpha) asum += opa;
+        }
+    }
+    _lv_mem_buf_release(line_buf);
+}
+
+/**
+ * Apply vertical box blur on an area of the canvas
+ * @param canvas pointer to a canvas object
+ * @param a the area to blur. It's on the canvas.
+ * @param r size of the box
+ */
+static void blur_ver(lv_obj_t * canvas, const lv_area_t * a, uint16_t r)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+    if(blur_is_fast(&ext->dsc, r) && blur_fast(&ext->dsc, a, r, false)) return;
+
+    lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
+
+    uint16_t r_back = r / 2;
+    uint16_t r_front = r / 2;
+
+    if((r & 0x1) == 0) r_back--;
+
+    bool has_alpha = lv_img_cf_has_alpha(ext->dsc.header.cf);
+    lv_coord_t col_w = lv_img_buf_get_img_size(1, ext->dsc.header.h, ext->dsc.header.cf);
+    uint8_t * col_buf = _lv_mem_buf_get(col_w);
+    lv_img_dsc_t line_img;
+
+    line_img.data = col_buf;
+    line_img.header.always_zero = 0;
+    line_img.header.w = 1;
+    line_img.header.h = ext->dsc.header.h;
+    line_img.header.cf = ext->dsc.header.cf;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    lv_coord_t y_safe;
+
+    for(x = a->x1; x <= a->x2; x++) {
+        uint32_t asum = 0;
+        uint32_t rsum = 0;
+        uint32_t gsum = 0;
+        uint32_t bsum = 0;
+
+        lv_color_t c;
+        lv_opa_t opa = LV_OPA_COVER;
+
+        for(y = a->y1 - r_back; y <= a->y1 + r_front; y++) {
+            y_safe = y < 0 ? 0 : y;
+            y_safe = y_safe > ext->dsc.header.h - 1 ? ext->dsc.header.h - 1 : y_safe;
+
+            c = lv_img_buf_get_px_color(&ext->dsc, x, y_safe, color);
+            if(has_alpha) opa = lv_img_buf_get_px_alpha(&ext->dsc, x, y_safe);
+
+            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
+            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
+
+            rsum += c.ch.red;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            gsum += (c.ch.green_h << 3) + c.ch.green_l;
+#else
+            gsum += c.ch.green;
+#endif
+            bsum += c.ch.blue;
+            if(has_alpha) asum += opa;
+        }
+
+        /*Just to indicate that the px is visible*/
+        if(has_alpha == false) asum = LV_OPA_COVER;
+
+        for(y = a->y1; y <= a->y2; y++) {
+            if(asum) {
+                c.ch.red = rsum / r;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+                uint8_t gtmp = gsum / r;
+                c.ch.green_h = gtmp >> 3;
+                c.ch.green_l = gtmp & 0x7;
+#else
+                c.ch.green = gsum / r;
+#endif
+                c.ch.blue = bsum / r;
+                if(has_alpha) opa = asum / r;
+
+                lv_img_buf_set_px_color(&ext->dsc, x, y, c);
+            }
+            if(has_alpha) lv_img_buf_set_px_alpha(&ext->dsc, x, y, opa);
+
+            y_safe = y - r_back;
+            y_safe = y_safe < 0 ? 0 : y_safe;
+            c = lv_img_buf_get_px_color(&line_img, 0, y_safe, color);
+            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, 0, y_safe);
+
+            rsum -= c.ch.red;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
+#else
+            gsum -= c.ch.green;
+#endif
+            bsum -= c.ch.blue;
+            if(has_alpha) asum -= opa;
+
+            y_safe = y + 1 + r_front;
+            y_safe = y_safe > ext->dsc.header.h - 1 ? ext->dsc.header.h - 1 : y_safe;
+
+            c = lv_img_buf_get_px_color(&ext->dsc, x, y_safe, color);
+            if(has_alpha) opa = lv_img_buf_get_px_alpha(&ext->dsc, x, y_safe);
+
+            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
+            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
+
+            rsum += c.ch.red;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            gsum += (c.ch.green_h << 3) + c.ch.green_l;
+#else
+            gsum += c.ch.green;
+#endif
+            bsum += c.ch.blue;
+            if(has_alpha) asum += opa;
+        }
+    }
+
+    _lv_mem_buf_release(col_buf);
+}
+
+/**
+ * Tell whether the blur can work on the channels of the pixels directly instead of getting and setting the pixels
+ * @param dsc the canvas' image
+ * @param r size of the box
+ * @return true: `blur_fast` can be used
+ */
+static bool blur_is_fast(const lv_img_dsc_t * dsc, uint16_t r)
+{
+    if(r < 2 || r > BLUR_WIN_MAX) return false;
+
+    lv_img_cf_t cf = dsc->header.cf;
+    return cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+}
+
+/**
+ * Apply box blur on the channels of the pixels.
+ * The lines along the blur (the rows for vertical blur) are blurred in strips of `BLUR_STRIP_W` lines together
+ * by sliding the boxes along the strip. This way the memory is read in cache friendly chunks
+ * and the sums of the channels can be updated with SIMD. For horizontal blur the same is done on the columns.
+ * @param dsc the canvas' image with true color format
+ * @param a the area to blur. It's on the canvas.
+ * @param r size of the box (2..`BLUR_WIN_MAX`)
+ * @param hor true: horizontal blur; false: vertical blur
+ * @return true: blurred; false: out of memory
+ */
+static bool blur_fast(lv_img_dsc_t * dsc, const lv_area_t * a, uint16_t r, bool hor)
+{
+    uint16_t r_back = r / 2;
+    uint16_t r_front = r / 2;
+
+    if((r & 0x1) == 0) r_back--;
+
+    /*Positions of the lines across the strips and along the box*/
+    lv_coord_t line_first = hor ? a->y1 : a->x1;
+    lv_coord_t line_last = hor ? a->y2 : a->x2;
+    lv_coord_t pos_first = hor ? a->x1 : a->y1;
+    lv_coord_t pos_last = hor ? a->x2 : a->y2;
+    lv_coord_t pos_max = hor ? dsc->header.w - 1 : dsc->header.h - 1;
+
+    /*Keep the original lines of the box in a ring because the lines leaving the box are already overwritten*/
+    uint32_t strip_size = BLUR_STRIP_W * BLUR_CH_CNT;
+    uint32_t ring_cnt = r + 1;
+    /*The ring can be large so don't keep it among the temporal buffers. Use the slow blur if it doesn't fit.*/
+    uint8_t * ring = lv_mem_alloc(ring_cnt * strip_size);
+    if(ring == NULL) return false;
+    uint8_t * out_buf = _lv_mem_buf_get(strip_size);
+    uint16_t * sum = _lv_mem_buf_get(strip_size * sizeof(uint16_t));
+
+    lv_coord_t line;
+    lv_coord_t pos;
+    uint32_t i;
+    for(line = line_first; line <= line_last; line += BLUR_STRIP_W) {
+        lv_coord_t strip_w = LV_MATH_MIN(BLUR_STRIP_W, line_last - line + 1);
+        uint32_t len = strip_w * BLUR_CH_CNT;
+
+        _lv_memset_00(sum, len * sizeof(uint16_t));
+        for(pos = pos_first - r_back; pos <= pos_first + r_front; pos++) {
+            lv_coord_t pos_safe = LV_MATH_MIN(LV_MATH_MAX(pos, 0), pos_max);
+            uint8_t * ch = &ring[(pos_safe % ring_cnt) * strip_size];
+            /*Read the lines out of the canvas only once*/
+            if(pos == pos_safe || pos == pos_first - r_back) {
+                if(hor) blur_line_read(dsc, pos_safe, line, strip_w, true, ch);
+                else blur_line_read(dsc, line, pos_safe, strip_w, false, ch);
+            }
+            for(i = 0; i < len; i++) sum[i] += ch[i];
+        }
+
+        for(pos = pos_first; pos <= pos_last; pos++) {
+            /*Nothing enters or leaves the box after the last line*/
+            const uint8_t * sub = &ring[(pos % ring_cnt) * strip_size];
+            const uint8_t * add = sub;
+            if(pos < pos_last) {
+                lv_coord_t pos_sub = LV_MATH_MAX(pos - r_back, 0);
+                sub = &ring[(pos_sub % ring_cnt) * strip_size];
+
+                lv_coord_t pos_add = LV_MATH_MIN(pos + 1 + r_front, pos_max);
+                uint8_t * ch = &ring[(pos_add % ring_cnt) * strip_size];
+                if(pos_add == pos + 1 + r_front) {
+                    if(hor) blur_line_read(dsc, pos_add, line, strip_w, true, ch);
+                    else blur_line_read(dsc, line, pos_add, strip_w, false, ch);
+                }
+                add = ch;
+            }
+
+            lv_coord_t x = hor ? pos : line;
+            lv_coord_t y = hor ? line : pos;
+            uint8_t * out = blur_line_out(dsc, x, y, hor, out_buf);
+#if LV_GPU_SIMD_ENABLED
+            lv_gpu_simd_blur_step(sum, add, sub, out, r, len);
+#else
+            uint32_t rec = 0x10000 / r;
+            for(i = 0; i < len; i++) {
+                /*`(sum * rec) >> 16` is the quotient or one less*/
+                uint32_t q = (sum[i] * rec) >> 16;
+                if(sum[i] - q * r >= r) q++;
+                out[i] = q;
+                sum[i] = sum[i] - sub[i] + add[i];
+            }
+#endif
+            blur_line_write(dsc, x, y, strip_w, hor, out);
+        }
+    }
+
+    lv_mem_free(ring);
+    _lv_mem_buf_release(out_buf);
+    _lv_mem_buf_release(sum);
+
+    return true;
+}
+
+/**
+ * Read the channels of the pixels of a line.
+ * With 32 bit colors the bytes of the pixels are the channels, else the red, green, blue and alpha channels are unpacked.
+ * @param dsc the canvas' image with true color format
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the first pixel
+ * @param len number of pixels
+ * @param col true: the line is a column; false: the line is a row
+ * @param ch store `len * BLUR_CH_CNT` channels here
+ */
+static void blur_line_read(const lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, bool col,
+                           uint8_t * ch)
+{
+    uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+    uint32_t px_step = col ? (uint32_t)dsc->header.w * px_size : px_size;
+    const uint8_t * px = &dsc->data[((uint32_t)y * dsc->header.w + x) * px_size];
+
+    lv_coord_t i;
+#if LV_COLOR_DEPTH == 32
+    if(!col) {
+        _lv_memcpy(ch, px, len * BLUR_CH_CNT);
+        return;
+    }
+
+    /*The canvas' buffer is drawn as `lv_color_t` array so it's aligned*/
+    for(i = 0; i < len; i++) {
+        *((lv_color_t *)ch) = *((const lv_color_t *)px);
+        px += px_step;
+        ch += BLUR_CH_CNT;
+    }
+#else
+    bool has_alpha = dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    for(i = 0; i < len; i++) {
+        lv_color_t c;
+        _lv_memcpy_small(&c, px, sizeof(lv_color_t));
+        ch[0] = c.ch.red;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+        ch[1] = (c.ch.green_h << 3) + c.ch.green_l;
+#else
+        ch[1] = c.ch.green;
+#endif
+        ch[2] = c.ch.blue;
+        ch[3] = has_alpha ? px[px_size - 1] : LV_OPA_COVER;
+
+        px += px_step;
+        ch += BLUR_CH_CNT;
+    }
+#endif
+}
+
+/**
+ * Get where to put the blurred channels of a line
+ * @param dsc the canvas' image with true color format
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the first pixel
+ * @param col true: the line is a column; false: the line is a row
+ * @param ch buffer for the channels
+ * @return pointer to the row in the canvas' buffer with 32 bit colors, else `ch`
+ */
+static uint8_t * blur_line_out(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool col, uint8_t * ch)
+{
+#if LV_COLOR_DEPTH == 32
+    if(!col) return (uint8_t *)&dsc->data[((uint32_t)y * dsc->header.w + x) * sizeof(lv_color_t)];
+#else
+    LV_UNUSED(dsc);
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+    LV_UNUSED(col);
+#endif
+    return ch;
+}
+
+/**
+ * Write the blurred channels to a line. Nothing to do if they were written directly to the canvas' buffer.
+ * @param dsc the canvas' image with true color format
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the first pixel
+ * @param len number of pixels
+ * @param col true: the line is a column; false: the line is a row
+ * @param ch the channels returned by `blur_line_out`
+ */
+static void blur_line_write(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, bool col,
+                            const uint8_t * ch)
+{
+    uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+    uint32_t px_step = col ? (uint32_t)dsc->header.w * px_size : px_size;
+    uint8_t * px = (uint8_t *)&dsc->data[((uint32_t)y * dsc->header.w + x) * px_size];
+    if(px == ch) return;
+
+    lv_coord_t i;
+#if LV_COLOR_DEPTH == 32
+    for(i = 0; i < len; i++) {
+        *((lv_color_t *)px) = *((const lv_color_t *)ch);
+        px += px_step;
+        ch += BLUR_CH_CNT;
+    }
+#else
+    bool has_alpha = dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    for(i = 0; i < len; i++) {
+        lv_color_t c;
+        _lv_memcpy_small(&c, px, sizeof(lv_color_t));
+        c.ch.red = ch[0];
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+        c.ch.green_h = ch[1] >> 3;
+        c.ch.green_l = ch[1] & 0x7;
+#else
+        c.ch.green = ch[1];
+#endif
+        c.ch.blue = ch[2];
+        _lv_memcpy_small(px, &c, sizeof(lv_color_t));
+        if(has_alpha) px[px_size - 1] = ch[3];
+
+        px += px_step;
+        ch += BLUR_CH_CNT;
+    }
+#endif
+}
+
 #endif
@@ -166,6 +166,17 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
  */
 void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
 
+/**
+ * Blur the canvas in both directions. The blur of `r` size is split into `pass_cnt` smaller box blurs
+ * which give about the same amount of blur but the more passes the closer the result is to a Gaussian blur.
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param r radius of the blur
+ * @param pass_cnt number of box blurs in each direction.
+ *                 1: the same as `lv_canvas_blur_hor` and `lv_canvas_blur_ver`; 3: close to a Gaussian blur
+ */
+void lv_canvas_blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r, uint8_t pass_cnt);
+
 /**
  * Fill the canvas with color
  * @param canvas pointer to a canvas
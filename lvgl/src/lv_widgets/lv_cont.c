@@ -15,12 +15,18 @@
 #include <string.h>
 
 #include "../lv_misc/lv_debug.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_draw/lv_draw_mask.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_misc/lv_area.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+    #include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -30,12 +36,24 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_CONT_LAYOUT_DEFER
+/*A container whose layout and fit needs to be refreshed*/
+typedef struct {
+    lv_obj_t * cont;
+    uint16_t depth;     /*Number of ancestors of `cont`*/
+} lv_cont_layout_dirty_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t lv_cont_signal(lv_obj_t * cont, lv_signal_t sign, void * param);
 static lv_style_list_t * lv_cont_get_style(lv_obj_t * cont, uint8_t type);
+static void lv_cont_refr(lv_obj_t * cont, bool layout);
+#if LV_CONT_LAYOUT_DEFER
+static void lv_cont_layout_remove(lv_obj_t * cont);
+static void lv_cont_layout_refr_dirty(lv_obj_t * cont);
+#endif
 static void lv_cont_refr_layout(lv_obj_t * cont);
 static void lv_cont_layout_col(lv_obj_t * cont);
 static void lv_cont_layout_row(lv_obj_t * cont);
@@ -49,6 +67,10 @@ static void lv_cont_refr_autofit(lv_obj_t * cont);
  **********************/
 static lv_design_cb_t ancestor_design;
 static lv_signal_cb_t ancestor_signal;
+#if LV_CONT_LAYOUT_DEFER
+static lv_obj_t ** flush_conts;     /*The containers being refreshed by `lv_layout_flush`*/
+static uint32_t flush_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -90,6 +112,9 @@ lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->fit_top    = LV_FIT_NONE;
     ext->fit_bottom = LV_FIT_NONE;
     ext->layout     = LV_LAYOUT_OFF;
+#if LV_CONT_LAYOUT_DEFER
+    ext->layout_dirty = 0;
+#endif
 
     lv_obj_set_signal_cb(cont, lv_cont_signal);
 
@@ -120,6 +145,95 @@ lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy)
     return cont;
 }
 
+/**
+ * Refresh the layouts and auto-fits of the changed containers now, the children before their parents.
+ * With `LV_CONT_LAYOUT_DEFER` it's called before every screen refresh. Call it to get the new
+ * coordinates of the objects earlier. Without `LV_CONT_LAYOUT_DEFER` it does nothing.
+ */
+void lv_layout_flush(void)
+{
+#if LV_CONT_LAYOUT_DEFER
+    static bool flushing = false;
+    if(flushing) return;    /*Called from a signal or event during the flush*/
+    flushing = true;
+
+    /*Refresh the deepest container first. This way a parent is fitted to its children only once
+     *after all of them are refreshed and not again for every resized child.
+     *Refreshing a container can make its children or its parent dirty again, so repeat until all are refreshed*/
+    while(_lv_ll_get_head(&LV_GC_ROOT(_lv_cont_layout_ll))) {
+        uint32_t cnt = 0;
+        uint16_t depth_max = 0;
+        lv_cont_layout_dirty_t * dirty;
+        _LV_LL_READ(LV_GC_ROOT(_lv_cont_layout_ll), dirty) {
+            cnt++;
+            if(dirty->depth > depth_max) depth_max = dirty->depth;
+        }
+
+        /*Sort the containers by depth (the deepest first) with a counting sort*/
+        lv_obj_t ** conts = lv_mem_alloc(cnt * sizeof(lv_obj_t *));
+        uint32_t * depth_start = lv_mem_alloc((depth_max + 1) * sizeof(uint32_t));
+        if(conts == NULL || depth_start == NULL) {
+            lv_mem_free(conts);
+            lv_mem_free(depth_start);
+
+            /*Out of memory: refresh them in the order they were added*/
+            dirty = _lv_ll_get_head(&LV_GC_ROOT(_lv_cont_layout_ll));
+            lv_obj_t * cont = dirty->cont;
+            _lv_ll_remove(&LV_GC_ROOT(_lv_cont_layout_ll), dirty);
+            lv_mem_free(dirty);
+            lv_cont_layout_refr_dirty(cont);
+            continue;
+        }
+
+        _lv_memset_00(depth_start, (depth_max + 1) * sizeof(uint32_t));
+        _LV_LL_READ(LV_GC_ROOT(_lv_cont_layout_ll), dirty) {
+            depth_start[dirty->depth]++;
+        }
+
+        uint32_t start = 0;
+        int32_t d;
+        for(d = depth_max; d >= 0; d--) {
+            uint32_t d_cnt = depth_start[d];
+            depth_start[d] = start;
+            start += d_cnt;
+        }
+
+        dirty = _lv_ll_get_head(&LV_GC_ROOT(_lv_cont_layout_ll));
+        while(dirty) {
+            conts[depth_start[dirty->depth]++] = dirty->cont;
+            _lv_ll_remove(&LV_GC_ROOT(_lv_cont_layout_ll), dirty);
+            lv_mem_free(dirty);
+            dirty = _lv_ll_get_head(&LV_GC_ROOT(_lv_cont_layout_ll));
+        }
+        lv_mem_free(depth_start);
+
+        /*The containers still have `layout_dirty` set so changes of the not yet refreshed ones are ignored.
+         *The containers deleted meanwhile are cleared in the array by `lv_cont_layout_remove`*/
+        flush_conts = conts;
+        flush_cnt = cnt;
+        uint32_t i;
+        for(i = 0; i < cnt; i++) {
+            if(conts[i]) lv_cont_layout_refr_dirty(conts[i]);
+        }
+        flush_conts = NULL;
+        flush_cnt = 0;
+        lv_mem_free(conts);
+    }
+
+    flushing = false;
+#endif
+}
+
+/**
+ * Initialize the list of the containers to refresh. Called from `lv_init()`.
+ */
+void _lv_cont_layout_init(void)
+{
+#if LV_CONT_LAYOUT_DEFER
+    _lv_ll_init(&LV_GC_ROOT(_lv_cont_layout_ll), sizeof(lv_cont_layout_dirty_t));
+#endif
+}
+
 /*=====================
  * Setter functions
  *====================*/
@@ -267,23 +381,25 @@ static lv_res_t lv_cont_signal(lv_obj_t * cont, lv_signal_t sign, void * param)
     if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
 
     if(sign == LV_SIGNAL_STYLE_CHG) { /*Recalculate the padding if the style changed*/
-        lv_cont_refr_layout(cont);
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr(cont, true);
     }
     else if(sign == LV_SIGNAL_CHILD_CHG) {
-        lv_cont_refr_layout(cont);
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr(cont, true);
     }
     else if(sign == LV_SIGNAL_COORD_CHG) {
         if(lv_obj_get_width(cont) != lv_area_get_width(param) || lv_obj_get_height(cont) != lv_area_get_height(param)) {
-            lv_cont_refr_layout(cont);
-            lv_cont_refr_autofit(cont);
+            lv_cont_refr(cont, true);
         }
     }
     else if(sign == LV_SIGNAL_PARENT_SIZE_CHG) {
         /*MAX and EDGE fit needs to be refreshed if the parent's size has changed*/
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr(cont, false);
+    }
+#if LV_CONT_LAYOUT_DEFER
+    else if(sign == LV_SIGNAL_CLEANUP) {
+        lv_cont_layout_remove(cont);
     }
+#endif
 
     return res;
 }
@@ -303,6 +419,98 @@ static lv_style_list_t * lv_cont_get_style(lv_obj_t * cont, uint8_t type)
     return style_dsc_p;
 }
 
+/**
+ * Refresh the layout and the auto-fit of a container, or with `LV_CONT_LAYOUT_DEFER`
+ * add it to the containers which are refreshed by `lv_layout_flush()`
+ * @param cont pointer to a container object
+ * @param layout true: refresh the layout too; false: refresh only the auto-fit
+ */
+static void lv_cont_refr(lv_obj_t * cont, bool layout)
+{
+#if LV_CONT_LAYOUT_DEFER
+    LV_UNUSED(layout);
+
+    /*Changes during the container's own layout are ignored like without deferring*/
+    if(lv_obj_is_protected(cont, LV_PROTECT_CHILD_CHG)) return;
+
+    lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+    if(ext->layout_dirty) return;
+    if(ext->layout == LV_LAYOUT_OFF && ext->fit_left == LV_FIT_NONE && ext->fit_right == LV_FIT_NONE &&
+       ext->fit_top == LV_FIT_NONE && ext->fit_bottom == LV_FIT_NONE) {
+        return;
+    }
+
+    lv_cont_layout_dirty_t * dirty = _lv_ll_ins_tail(&LV_GC_ROOT(_lv_cont_layout_ll));
+    LV_ASSERT_MEM(dirty);
+    if(dirty) {
+        dirty->cont = cont;
+        dirty->depth = 0;
+        lv_obj_t * scr = cont;
+        while(scr->parent) {
+            dirty->depth++;
+            scr = scr->parent;
+        }
+        ext->layout_dirty = 1;
+
+        /*Be sure the display will be refreshed (and the layout flushed) even if nothing is invalidated*/
+        lv_disp_t * disp = lv_obj_get_disp(scr);
+        if(disp && disp->refr_task) lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
+        return;
+    }
+    /*Refresh it now if out of memory*/
+    lv_cont_refr_layout(cont);
+    lv_cont_refr_autofit(cont);
+#else
+    if(layout) lv_cont_refr_layout(cont);
+    lv_cont_refr_autofit(cont);
+#endif
+}
+
+#if LV_CONT_LAYOUT_DEFER
+/**
+ * Remove a deleted container from the containers to refresh
+ * @param cont pointer to a container object
+ */
+static void lv_cont_layout_remove(lv_obj_t * cont)
+{
+    lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+    if(ext->layout_dirty == 0) return;
+
+    ext->layout_dirty = 0;
+
+    lv_cont_layout_dirty_t * dirty;
+    _LV_LL_READ(LV_GC_ROOT(_lv_cont_layout_ll), dirty) {
+        if(dirty->cont == cont) {
+            _lv_ll_remove(&LV_GC_ROOT(_lv_cont_layout_ll), dirty);
+            lv_mem_free(dirty);
+            return;
+        }
+    }
+
+    /*Not refreshed yet by the running `lv_layout_flush`*/
+    uint32_t i;
+    for(i = 0; i < flush_cnt; i++) {
+        if(flush_conts[i] == cont) {
+            flush_conts[i] = NULL;
+            return;
+        }
+    }
+}
+
+/**
+ * Refresh the layout and the auto-fit of a container removed from the containers to refresh
+ * @param cont pointer to a container object
+ */
+static void lv_cont_layout_refr_dirty(lv_obj_t * cont)
+{
+    lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+    ext->layout_dirty = 0;
+
+    lv_cont_refr_layout(cont);
+    lv_cont_refr_autofit(cont);
+}
+#endif
+
 /**
  * Refresh the layout of a container
  * @param cont pointer to an object which layout should be refreshed
@@ -105,6 +105,9 @@ typedef struct {
     lv_fit_t fit_right : 2;  /*A fit type from `lv_fit_t` enum */
     lv_fit_t fit_top : 2;    /*A fit type from `lv_fit_t` enum */
     lv_fit_t fit_bottom : 2; /*A fit type from `lv_fit_t` enum */
+#if LV_CONT_LAYOUT_DEFER
+    uint8_t layout_dirty : 1; /*1: the layout and fit will be refreshed by `lv_layout_flush()`*/
+#endif
 } lv_cont_ext_t;
 
 /*Part of the container*/
@@ -126,6 +129,18 @@ enum {
  */
 lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy);
 
+/**
+ * Refresh the layouts and auto-fits of the changed containers now, the children before their parents.
+ * With `LV_CONT_LAYOUT_DEFER` it's called before every screen refresh. Call it to get the new
+ * coordinates of the objects earlier. Without `LV_CONT_LAYOUT_DEFER` it does nothing.
+ */
+void lv_layout_flush(void);
+
+/**
+ * Initialize the list of the containers to refresh. Called from `lv_init()`.
+ */
+void _lv_cont_layout_init(void);
+
 /*=====================
  * Setter functions
  *====================*/
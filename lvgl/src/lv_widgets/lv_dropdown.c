@@ -625,6 +625,8 @@ void lv_dropdown_open(lv_obj_t * ddlist)
     lv_label_set_text_static(label, ext->options);
 
     lv_cont_set_fit2(ext->page, LV_FIT_TIGHT, LV_FIT_NONE);
+    lv_layout_flush();  /*To get the fitted size*/
+
     /*Set small width to the width of the button*/
     if(lv_obj_get_width(ext->page) < lv_obj_get_width(ddlist) &&
        (ext->dir == LV_DROPDOWN_DIR_UP || ext->dir == LV_DROPDOWN_DIR_DOWN)) {
@@ -1319,6 +1321,9 @@ static void position_to_selected(lv_obj_t * ddlist)
     lv_obj_t * label = get_label(ddlist);
     if(label == NULL) return;
 
+    /*The coordinates are read so refresh the layouts first*/
+    lv_layout_flush();
+
     lv_coord_t h = lv_obj_get_height(ext->page);
     lv_style_int_t line_space = lv_obj_get_style_text_line_space(ddlist, LV_DROPDOWN_PART_LIST);
 
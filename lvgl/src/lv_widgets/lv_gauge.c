@@ -424,11 +424,8 @@ static lv_design_res_t lv_gauge_design(lv_obj_t * gauge, const lv_area_t * clip_
         lv_gauge_ext_t * ext           = lv_obj_get_ext_attr(gauge);
         lv_gauge_draw_labels(gauge, clip_area);
 
-        /*Add the strong lines*/
-        uint16_t line_cnt_tmp = ext->lmeter.line_cnt;
-        ext->lmeter.line_cnt         = ext->label_count;                 /*Only to labels*/
-        lv_linemeter_draw_scale(gauge, clip_area, LV_GAUGE_PART_MAJOR);
-        ext->lmeter.line_cnt = line_cnt_tmp; /*Restore the parameters*/
+        /*Add the strong lines only to the labels*/
+        _lv_linemeter_draw_scale_lines(gauge, clip_area, LV_GAUGE_PART_MAJOR, ext->label_count);
 
         lv_gauge_draw_needle(gauge, clip_area);
     }
@@ -53,6 +53,12 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void get_txt_coords(const lv_obj_t * label, lv_area_t * area);
+#if LV_LABEL_LINE_CACHE
+static const lv_draw_label_lines_t * get_lines(const lv_obj_t * label, const lv_font_t * font,
+                                               lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag);
+#endif
+static uint32_t get_line_on_y(const lv_draw_label_lines_t * lines, lv_coord_t y, lv_coord_t letter_height,
+                              lv_coord_t line_space);
 
 /**********************
  *  STATIC VARIABLES
@@ -112,6 +118,10 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    _lv_memset_00(&ext->lines, sizeof(ext->lines));
+#endif
+
 #if LV_LABEL_TEXT_SEL
     ext->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     ext->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -147,6 +157,9 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
             LV_ASSERT_MEM(ext->text);
             if(ext->text == NULL) return NULL;
             _lv_memcpy(ext->text, copy_ext->text, _lv_mem_get_size(copy_ext->text));
+#if LV_LABEL_LINE_CACHE
+            ext->lines.txt = NULL;  /*The text is changed. The style refresh below updates the lines.*/
+#endif
         }
 
         if(copy_ext->dot_tmp_alloc && copy_ext->dot.tmp_ptr) {
@@ -569,14 +582,27 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
 
+    const lv_draw_label_lines_t * lines = NULL;
+#if LV_LABEL_LINE_CACHE
+    lines = get_lines(label, font, letter_space, max_w, flag);
+#endif
+
     /*Search the line of the index letter */;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+    if(lines) {
+        uint32_t line_id = _lv_draw_label_lines_find(lines, byte_id);
+        line_start = lines->line_start[line_id];
+        new_line_start = lines->line_start[line_id + 1];
+        y = line_id * (letter_height + line_space);
+    }
+    else {
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -677,22 +703,42 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
     if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+    const lv_draw_label_lines_t * lines = NULL;
+#if LV_LABEL_LINE_CACHE
+    lines = get_lines(label, font, letter_space, max_w, flag);
+#endif
 
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
+    /*Search the line of the index letter */;
+    if(lines) {
+        uint32_t line_id = get_line_on_y(lines, pos.y, letter_height, line_space);
+        line_start = lines->line_start[line_id];
+        new_line_start = line_start;
+        if(line_id < lines->line_cnt) {
+            new_line_start = lines->line_start[line_id + 1];
             /* Include the NULL terminator in the last line */
             uint32_t tmp = new_line_start;
             uint32_t letter;
             letter = _lv_txt_encoded_prev(txt, &tmp);
             if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
         }
-        y += letter_height + line_space;
+    }
+    else {
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                /* Include the NULL terminator in the last line */
+                uint32_t tmp = new_line_start;
+                uint32_t letter;
+                letter = _lv_txt_encoded_prev(txt, &tmp);
+                if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
+                break;
+            }
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
 #if LV_USE_BIDI
@@ -761,8 +807,8 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
         logical_pos = _lv_bidi_get_logical_pos(&txt[line_start], NULL,
                                                txt_len, lv_obj_get_base_dir(label), cid, &is_rtl);
         if(is_rtl) logical_pos++;
-        _lv_mem_buf_release(bidi_txt);
     }
+    _lv_mem_buf_release(bidi_txt);
 #else
     logical_pos = _lv_txt_encoded_get_char_id(bidi_txt, i);
 #endif
@@ -838,14 +884,26 @@ bool lv_label_is_char_under_pos(const lv_obj_t * label, lv_point_t * pos)
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
 
+    const lv_draw_label_lines_t * lines = NULL;
+#if LV_LABEL_LINE_CACHE
+    lines = get_lines(label, font, letter_space, max_w, flag);
+#endif
+
     /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+    if(lines) {
+        uint32_t line_id = get_line_on_y(lines, pos->y, letter_height, line_space);
+        line_start = lines->line_start[line_id];
+        new_line_start = line_id < lines->line_cnt ? lines->line_start[line_id + 1] : line_start;
+    }
+    else {
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -1000,6 +1058,9 @@ void lv_label_refr_text(lv_obj_t * label)
 #if LV_LABEL_LONG_TXT_HINT
     ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+#if LV_LABEL_LINE_CACHE
+    ext->lines.txt = NULL;
+#endif
 
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
@@ -1220,6 +1281,13 @@ void lv_label_refr_text(lv_obj_t * label)
         /*Do nothing*/
     }
 
+#if LV_LABEL_LINE_CACHE
+    /*If the size has changed the lines are already updated with the new size in the recursive call*/
+    if(ext->lines.txt == NULL) {
+        _lv_draw_label_lines_build(&ext->lines, ext->text, font, letter_space, max_w, flag);
+    }
+#endif
+
     lv_obj_invalidate(label);
 }
 
@@ -1285,6 +1353,9 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         label_draw_dsc.ofs_y = ext->offset.y;
         label_draw_dsc.flag = flag;
         lv_obj_init_draw_label_dsc(label, LV_LABEL_PART_MAIN, &label_draw_dsc);
+#if LV_LABEL_LINE_CACHE
+        label_draw_dsc.lines = &ext->lines;
+#endif
 
         /* In SROLL and SROLL_CIRC mode the CENTER and RIGHT are pointless so remove them.
          * (In addition they will result misalignment is this case)*/
@@ -1298,13 +1369,13 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
                 label_draw_dsc.flag &= ~LV_TXT_FLAG_CENTER;
             }
         }
-#if LV_LABEL_LONG_TXT_HINT
+#if LV_LABEL_LONG_TXT_HINT && LV_USE_REFR_THREADS == 0
         lv_draw_label_hint_t * hint = &ext->hint;
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
             hint = NULL;
 
 #else
-        /*Just for compatibility*/
+        /*Just for compatibility. (The hint is updated while drawing so it's not used by the rendering threads)*/
         lv_draw_label_hint_t * hint = NULL;
 #endif
 
@@ -1367,6 +1438,9 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_LABEL_LINE_CACHE
+        _lv_draw_label_lines_free(&ext->lines);
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
@@ -1416,6 +1490,9 @@ static void lv_label_revert_dots(lv_obj_t * label)
     lv_label_dot_tmp_free(label);
 
     ext->dot_end = LV_LABEL_DOT_END_INV;
+#if LV_LABEL_LINE_CACHE
+    ext->lines.txt = NULL;  /*The text is changed*/
+#endif
 }
 
 #if LV_USE_ANIMATION
@@ -1510,4 +1587,45 @@ static void get_txt_coords(const lv_obj_t * label, lv_area_t * area)
     area->y2 -= bottom;
 }
 
+#if LV_LABEL_LINE_CACHE
+/**
+ * Get the stored line breaks of a label if they can be used with the given parameters
+ * @param label pointer to a label object
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the text area
+ * @param flag flags of the text
+ * @return pointer to the line table or NULL if the lines need to be calculated
+ */
+static const lv_draw_label_lines_t * get_lines(const lv_obj_t * label, const lv_font_t * font,
+                                               lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(ext->lines.line_cnt == 0) return NULL;
+    if(_lv_draw_label_lines_match(&ext->lines, ext->text, font, letter_space, max_w, flag) == false) return NULL;
+
+    return &ext->lines;
+}
+#endif
+
+/**
+ * Get the first line whose bottom is not above a y coordinate
+ * @param lines pointer to a line table
+ * @param y the y coordinate relative to the text
+ * @param letter_height height of a line
+ * @param line_space space between the lines
+ * @return index of the line or `lines->line_cnt` if `y` is below the text
+ */
+static uint32_t get_line_on_y(const lv_draw_label_lines_t * lines, lv_coord_t y, lv_coord_t letter_height,
+                              lv_coord_t line_space)
+{
+    if(y <= letter_height) return 0;
+
+    int32_t line_h = letter_height + line_space;
+    if(line_h <= 0) return lines->line_cnt;
+
+    uint32_t line_id = (y - letter_height + line_h - 1) / line_h;
+    return LV_MATH_MIN(line_id, lines->line_cnt);
+}
+
 #endif
@@ -13,6 +13,7 @@
 #include "../lv_draw/lv_draw.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_core/lv_group.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_math.h"
 
 /*********************
@@ -29,6 +30,12 @@
  **********************/
 static lv_design_res_t lv_linemeter_design(lv_obj_t * lmeter, const lv_area_t * clip_area, lv_design_mode_t mode);
 static lv_res_t lv_linemeter_signal(lv_obj_t * lmeter, lv_signal_t sign, void * param);
+static int16_t get_level(lv_linemeter_ext_t * ext, uint16_t line_cnt, int32_t value);
+static const lv_linemeter_scale_line_t * get_scale_lines(lv_obj_t * lmeter, uint8_t part, uint16_t line_cnt,
+                                                         lv_coord_t r_out, lv_coord_t r_in, int16_t angle_ofs);
+static bool get_lines_area(lv_obj_t * lmeter, int16_t level1, int16_t level2, lv_area_t * area);
+static void scale_line_calc(lv_linemeter_scale_line_t * line, uint16_t id, uint16_t line_cnt, uint16_t scale_angle,
+                            int16_t angle_ofs, lv_coord_t r_out, lv_coord_t r_in);
 
 /**********************
  *  STATIC VARIABLES
@@ -77,6 +84,9 @@ lv_obj_t * lv_linemeter_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->scale_angle = 240;
     ext->angle_ofs = 0;
     ext->mirrored = 0;
+#if LV_LINEMETER_SCALE_CACHE
+    _lv_memset_00(ext->scale_cache, sizeof(ext->scale_cache));
+#endif
 
     /*The signal and design functions are not copied so set them here*/
     lv_obj_set_signal_cb(linemeter, lv_linemeter_signal);
@@ -126,13 +136,18 @@ void lv_linemeter_set_value(lv_obj_t * lmeter, int32_t value)
     ext->cur_value = value > ext->max_value ? ext->max_value : value;
     ext->cur_value = ext->cur_value < ext->min_value ? ext->min_value : ext->cur_value;
 
-    int16_t level_old =
-        (int32_t)((int32_t)(old_value - ext->min_value) * (ext->line_cnt - 1)) / (ext->max_value - ext->min_value);
-    int16_t level_new =
-        (int32_t)((int32_t)(ext->cur_value - ext->min_value) * (ext->line_cnt - 1)) / (ext->max_value - ext->min_value);
+    int16_t level_old = get_level(ext, ext->line_cnt, old_value);
+    int16_t level_new = get_level(ext, ext->line_cnt, ext->cur_value);
 
     if(level_new == level_old) return;
 
+    /*Only the lines between the old and new level change their color*/
+    lv_area_t a;
+    if(get_lines_area(lmeter, level_old, level_new, &a)) {
+        lv_obj_invalidate_area(lmeter, &a);
+        return;
+    }
+
     lv_obj_invalidate(lmeter);
 }
 
@@ -305,6 +320,20 @@ bool lv_linemeter_get_mirror(lv_obj_t * lmeter)
 }
 
 void lv_linemeter_draw_scale(lv_obj_t * lmeter, const lv_area_t * clip_area, uint8_t part)
+{
+    lv_linemeter_ext_t * ext    = lv_obj_get_ext_attr(lmeter);
+    _lv_linemeter_draw_scale_lines(lmeter, clip_area, part, ext->line_cnt);
+}
+
+/**
+ * Draw the scale of a line meter with an other number of lines.
+ * The line meter is not modified so other rendering threads can draw it at the same time.
+ * @param lmeter pointer to a line meter object
+ * @param clip_area the scale will be drawn only in this area
+ * @param part the part whose scale should be drawn
+ * @param line_cnt number of lines to draw on the scale
+ */
+void _lv_linemeter_draw_scale_lines(lv_obj_t * lmeter, const lv_area_t * clip_area, uint8_t part, uint16_t line_cnt)
 {
     lv_linemeter_ext_t * ext    = lv_obj_get_ext_attr(lmeter);
 
@@ -319,10 +348,8 @@ void lv_linemeter_draw_scale(lv_obj_t * lmeter, const lv_area_t * clip_area, uin
     lv_coord_t x_ofs  = lmeter->coords.x1 + r_out + left;
     lv_coord_t y_ofs  = lmeter->coords.y1 + r_out + top;
     int16_t angle_ofs = ext->angle_ofs + 90 + (360 - ext->scale_angle) / 2;
-    int16_t level = ext->mirrored ?
-                    (int32_t)((int32_t)(ext->max_value - ext->cur_value) * (ext->line_cnt - 1)) / (ext->max_value - ext->min_value) :
-                    (int32_t)((int32_t)(ext->cur_value - ext->min_value) * (ext->line_cnt - 1)) / (ext->max_value - ext->min_value);
-    uint8_t i;
+    int16_t level = get_level(ext, line_cnt, ext->cur_value);
+    uint16_t i;
 
     lv_color_t main_color = lv_obj_get_style_line_color(lmeter, part);
     lv_color_t grad_color = lv_obj_get_style_scale_grad_color(lmeter, part);
@@ -335,125 +362,82 @@ void lv_linemeter_draw_scale(lv_obj_t * lmeter, const lv_area_t * clip_area, uin
     line_dsc.raw_end = 1;
 #endif
 
+    lv_style_int_t line_width = line_dsc.width;
     lv_style_int_t end_line_width = lv_obj_get_style_scale_end_line_width(lmeter, part);
 
+    /*The masks are added only before the first line to draw
+     *to not slow down the drawing of the other parts if no lines are in the clip area*/
 #if LV_LINEMETER_PRECISE > 0
-    lv_area_t mask_area;
-    mask_area.x1 = x_ofs - r_in;
-    mask_area.x2 = x_ofs + r_in - 1;
-    mask_area.y1 = y_ofs - r_in;
-    mask_area.y2 = y_ofs + r_in - 1;
-
+    bool mask_added = false;
     lv_draw_mask_radius_param_t mask_in_param;
-    lv_draw_mask_radius_init(&mask_in_param, &mask_area, LV_RADIUS_CIRCLE, true);
-    int16_t mask_in_id = lv_draw_mask_add(&mask_in_param, 0);
+    int16_t mask_in_id = LV_MASK_ID_INV;
 #endif
 
-
 #if LV_LINEMETER_PRECISE > 1
-    mask_area.x1 = x_ofs - r_out;
-    mask_area.x2 = x_ofs + r_out - 1;
-    mask_area.y1 = y_ofs - r_out;
-    mask_area.y2 = y_ofs + r_out - 1;
     lv_draw_mask_radius_param_t mask_out_param;
-    lv_draw_mask_radius_init(&mask_out_param, &mask_area, LV_RADIUS_CIRCLE, false);
-    int16_t mask_out_id = lv_draw_mask_add(&mask_out_param, 0);
-    /*In calculation use a larger radius to avoid rounding errors */
-    lv_coord_t r_out_extra = r_out + LV_DPI;
-#else
-    lv_coord_t r_out_extra = r_out;
+    int16_t mask_out_id = LV_MASK_ID_INV;
 #endif
 
-    for(i = 0; i < ext->line_cnt; i++) {
-        /* `* 256` for extra precision*/
-        int32_t angle_upscale = (i * ext->scale_angle * 256) / (ext->line_cnt - 1);
-        int32_t angle_normal = angle_upscale >> 8;
-
-        int32_t angle_low = (angle_upscale >> 8);
-        int32_t angle_high = angle_low + 1;
-        int32_t angle_rem = angle_upscale & 0xFF;
+    const lv_linemeter_scale_line_t * lines = get_scale_lines(lmeter, part, line_cnt, r_out, r_in, angle_ofs);
+    lv_linemeter_scale_line_t line_tmp;
 
-        /*Interpolate sine and cos*/
-        int32_t sin_low = _lv_trigo_sin(angle_low + angle_ofs);
-        int32_t sin_high = _lv_trigo_sin(angle_high + angle_ofs);
-        int32_t sin_mid = (sin_low * (256 - angle_rem) + sin_high * angle_rem) >> 8;
-
-        int32_t cos_low = _lv_trigo_sin(angle_low + 90 + angle_ofs);
-        int32_t cos_high = _lv_trigo_sin(angle_high + 90 + angle_ofs);
-        int32_t cos_mid = (cos_low * (256 - angle_rem) + cos_high * angle_rem) >> 8;
-
-        /*Use the interpolated values to get x and y coordinates*/
-        int32_t y_out_extra = (int32_t)((int32_t)sin_mid * r_out_extra) >> (LV_TRIGO_SHIFT - 8);
-        int32_t x_out_extra = (int32_t)((int32_t)cos_mid * r_out_extra) >> (LV_TRIGO_SHIFT - 8);
-
-        /*Rounding*/
-        if(x_out_extra > 0) x_out_extra = (x_out_extra + 127) >> 8;
-        else x_out_extra = (x_out_extra - 127) >> 8;
-
-        if(y_out_extra > 0) y_out_extra = (y_out_extra + 127) >> 8;
-        else y_out_extra = (y_out_extra - 127) >> 8;
-
-        x_out_extra += x_ofs;
-        y_out_extra += y_ofs;
-
-        /*With no extra precision use the coordinates on the inner radius*/
-#if LV_LINEMETER_PRECISE == 0
-        /*Use the interpolated values to get x and y coordinates*/
-        int32_t y_in_extra = (int32_t)((int32_t)sin_mid * r_in) >> (LV_TRIGO_SHIFT - 8);
-        int32_t x_in_extra = (int32_t)((int32_t)cos_mid * r_in) >> (LV_TRIGO_SHIFT - 8);
-
-        /*Rounding*/
-        if(x_in_extra > 0) x_in_extra = (x_in_extra + 127) >> 8;
-        else x_in_extra = (x_in_extra - 127) >> 8;
-
-        if(y_in_extra > 0) y_in_extra = (y_in_extra + 127) >> 8;
-        else y_in_extra = (y_in_extra - 127) >> 8;
+    for(i = 0; i < line_cnt; i++) {
+        const lv_linemeter_scale_line_t * line;
+        if(lines) {
+            line = &lines[i];
+        }
+        else {
+            scale_line_calc(&line_tmp, i, line_cnt, ext->scale_angle, angle_ofs, r_out, r_in);
+            line = &line_tmp;
+        }
 
-        x_in_extra += x_ofs;
-        y_in_extra += y_ofs;
-#else
-        int32_t x_in_extra = x_ofs;
-        int32_t y_in_extra = y_ofs;
-#endif
+        /*The lines after the level (before it if mirrored) are drawn with the end style*/
+        bool end_line = (!ext->mirrored && i > level) || (ext->mirrored && i < level);
+        line_dsc.width = end_line ? end_line_width : line_width;
 
         /*Use smaller clip area only around the visible line*/
-        int32_t y_in  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + angle_ofs) * r_in) >> LV_TRIGO_SHIFT;
-        int32_t x_in  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + 90 + angle_ofs) * r_in) >> LV_TRIGO_SHIFT;
-
-        x_in += x_ofs;
-        y_in += y_ofs;
-
-        int32_t y_out  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + angle_ofs) * r_out) >> LV_TRIGO_SHIFT;
-        int32_t x_out  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + 90 + angle_ofs) * r_out) >> LV_TRIGO_SHIFT;
-
-        x_out += x_ofs;
-        y_out += y_ofs;
-
         lv_area_t clip_sub;
-        clip_sub.x1 = LV_MATH_MIN(x_in, x_out) - line_dsc.width;
-        clip_sub.x2 = LV_MATH_MAX(x_in, x_out) + line_dsc.width;
-        clip_sub.y1 = LV_MATH_MIN(y_in, y_out) - line_dsc.width;
-        clip_sub.y2 = LV_MATH_MAX(y_in, y_out) + line_dsc.width;
+        clip_sub.x1 = line->area.x1 + x_ofs - line_dsc.width;
+        clip_sub.x2 = line->area.x2 + x_ofs + line_dsc.width;
+        clip_sub.y1 = line->area.y1 + y_ofs - line_dsc.width;
+        clip_sub.y2 = line->area.y2 + y_ofs + line_dsc.width;
 
         if(_lv_area_intersect(&clip_sub, &clip_sub, clip_area) == false) continue;
 
+#if LV_LINEMETER_PRECISE > 0
+        if(!mask_added) {
+            lv_area_t mask_area;
+            mask_area.x1 = x_ofs - r_in;
+            mask_area.x2 = x_ofs + r_in - 1;
+            mask_area.y1 = y_ofs - r_in;
+            mask_area.y2 = y_ofs + r_in - 1;
+            lv_draw_mask_radius_init(&mask_in_param, &mask_area, LV_RADIUS_CIRCLE, true);
+            mask_in_id = lv_draw_mask_add(&mask_in_param, 0);
+
+#if LV_LINEMETER_PRECISE > 1
+            mask_area.x1 = x_ofs - r_out;
+            mask_area.x2 = x_ofs + r_out - 1;
+            mask_area.y1 = y_ofs - r_out;
+            mask_area.y2 = y_ofs + r_out - 1;
+            lv_draw_mask_radius_init(&mask_out_param, &mask_area, LV_RADIUS_CIRCLE, false);
+            mask_out_id = lv_draw_mask_add(&mask_out_param, 0);
+#endif
+            mask_added = true;
+        }
+#endif
+
         lv_point_t p1;
         lv_point_t p2;
 
-        p2.x = x_in_extra;
-        p2.y = y_in_extra;
+        p2.x = line->p_in.x + x_ofs;
+        p2.y = line->p_in.y + y_ofs;
 
-        p1.x = x_out_extra;
-        p1.y = y_out_extra;
+        p1.x = line->p_out.x + x_ofs;
+        p1.y = line->p_out.y + y_ofs;
 
         /* Set the color of the lines */
-        if((!ext->mirrored && i > level) || (ext->mirrored && i < level)) {
-            line_dsc.color = end_color;
-            line_dsc.width = end_line_width;
-        }
-        else {
-            line_dsc.color = lv_color_mix(grad_color, main_color, (255 * i) / ext->line_cnt);
-        }
+        if(end_line) line_dsc.color = end_color;
+        else line_dsc.color = lv_color_mix(grad_color, main_color, (255 * i) / line_cnt);
 
         lv_draw_line(&p1, &p2, &clip_sub, &line_dsc);
     }
@@ -466,12 +450,12 @@ void lv_linemeter_draw_scale(lv_obj_t * lmeter, const lv_area_t * clip_area, uin
     lv_draw_mask_remove_id(mask_out_id);
 #endif
 
-    if(part == LV_LINEMETER_PART_MAIN && level < ext->line_cnt - 1) {
+    if(part == LV_LINEMETER_PART_MAIN && level < line_cnt - 1) {
         lv_style_int_t border_width = lv_obj_get_style_scale_border_width(lmeter, part);
         lv_style_int_t end_border_width = lv_obj_get_style_scale_end_border_width(lmeter, part);
 
         if(border_width || end_border_width) {
-            int16_t end_angle = ((level) * ext->scale_angle) / (ext->line_cnt - 1) + angle_ofs;
+            int16_t end_angle = ((level) * ext->scale_angle) / (line_cnt - 1) + angle_ofs;
             lv_draw_line_dsc_t arc_dsc;
             lv_draw_line_dsc_init(&arc_dsc);
             lv_obj_init_draw_line_dsc(lmeter, part, &arc_dsc);
@@ -545,7 +529,14 @@ static lv_res_t lv_linemeter_signal(lv_obj_t * lmeter, lv_signal_t sign, void *
     if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
 
     if(sign == LV_SIGNAL_CLEANUP) {
-        /*Nothing to cleanup. (No dynamically allocated memory in 'ext')*/
+#if LV_LINEMETER_SCALE_CACHE
+        lv_linemeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+        uint8_t i;
+        for(i = 0; i < sizeof(ext->scale_cache) / sizeof(ext->scale_cache[0]); i++) {
+            lv_mem_free(ext->scale_cache[i].lines);
+            ext->scale_cache[i].lines = NULL;
+        }
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         lv_obj_refresh_ext_draw_pad(lmeter);
@@ -554,4 +545,239 @@ static lv_res_t lv_linemeter_signal(lv_obj_t * lmeter, lv_signal_t sign, void *
 
     return res;
 }
+
+/**
+ * Get the index of the last line with the active color
+ * @param ext pointer to the extended data of a line meter
+ * @param line_cnt number of lines on the scale
+ * @param value a value of the line meter
+ * @return index of the line. If mirrored the lines before it have the end color
+ */
+static int16_t get_level(lv_linemeter_ext_t * ext, uint16_t line_cnt, int32_t value)
+{
+    if(ext->mirrored) {
+        return (int32_t)((int32_t)(ext->max_value - value) * (line_cnt - 1)) / (ext->max_value - ext->min_value);
+    }
+    else {
+        return (int32_t)((int32_t)(value - ext->min_value) * (line_cnt - 1)) / (ext->max_value - ext->min_value);
+    }
+}
+
+/**
+ * Get the lines of the scale of a part. With `LV_LINEMETER_SCALE_CACHE` they are calculated only
+ * if the size, the angles or the number of lines has changed since the last call.
+ * With `LV_USE_REFR_THREADS` the lines are checked and calculated under the draw lock.
+ * The returned lines are used after the lock is released. It is safe because the parameters
+ * don't change during a refresh, so the other threads find the same lines valid and don't rebuild them.
+ * @param lmeter pointer to a line meter object
+ * @param part the part whose scale is drawn
+ * @param line_cnt number of lines on the scale
+ * @param r_out outer radius of the scale
+ * @param r_in inner radius of the scale
+ * @param angle_ofs angle of the first line
+ * @return the `line_cnt` lines of the scale or NULL if they are not cached
+ */
+static const lv_linemeter_scale_line_t * get_scale_lines(lv_obj_t * lmeter, uint8_t part, uint16_t line_cnt,
+                                                         lv_coord_t r_out, lv_coord_t r_in, int16_t angle_ofs)
+{
+#if LV_LINEMETER_SCALE_CACHE
+    lv_linemeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+    lv_linemeter_scale_cache_t * cache = &ext->scale_cache[part == LV_LINEMETER_PART_MAIN ? 0 : 1];
+
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_lock();
+#endif
+
+    if(cache->lines == NULL || cache->line_cnt != line_cnt || cache->scale_angle != ext->scale_angle ||
+       cache->angle_ofs != angle_ofs || cache->r_out != r_out || cache->r_in != r_in) {
+
+        if(cache->lines == NULL || cache->line_cnt != line_cnt) {
+            lv_mem_free(cache->lines);
+            cache->lines = NULL;
+            /*Calculate the lines while drawing if out of memory*/
+            if(line_cnt > 0) cache->lines = lv_mem_alloc(line_cnt * sizeof(lv_linemeter_scale_line_t));
+        }
+
+        if(cache->lines) {
+            cache->line_cnt = line_cnt;
+            cache->scale_angle = ext->scale_angle;
+            cache->angle_ofs = angle_ofs;
+            cache->r_out = r_out;
+            cache->r_in = r_in;
+
+            uint16_t i;
+            for(i = 0; i < line_cnt; i++) {
+                scale_line_calc(&cache->lines[i], i, line_cnt, ext->scale_angle, angle_ofs, r_out, r_in);
+            }
+        }
+    }
+
+    const lv_linemeter_scale_line_t * lines = cache->lines;
+
+#if LV_USE_REFR_THREADS
+    _lv_refr_draw_unlock();
+#endif
+
+    return lines;
+#else
+    LV_UNUSED(lmeter);
+    LV_UNUSED(part);
+    LV_UNUSED(line_cnt);
+    LV_UNUSED(r_out);
+    LV_UNUSED(r_in);
+    LV_UNUSED(angle_ofs);
+    return NULL;
+#endif
+}
+
+/**
+ * Get the area of the lines of the main part between two levels (inclusive).
+ * @param lmeter pointer to a line meter object
+ * @param level1 index of a line
+ * @param level2 index of an other line
+ * @param area store the area here
+ * @return true: `area` is set; false: the whole object needs to be refreshed
+ */
+static bool get_lines_area(lv_obj_t * lmeter, int16_t level1, int16_t level2, lv_area_t * area)
+{
+#if LV_LINEMETER_SCALE_CACHE
+    lv_linemeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+
+    /*The lines of other parts (e.g. the major lines of a gauge) also depend on the value*/
+    if(ext->scale_cache[1].lines) return false;
+
+    /*The arcs on the scale also change*/
+    if(lv_obj_get_style_scale_border_width(lmeter, LV_LINEMETER_PART_MAIN) ||
+       lv_obj_get_style_scale_end_border_width(lmeter, LV_LINEMETER_PART_MAIN)) return false;
+
+    lv_style_int_t left = lv_obj_get_style_pad_left(lmeter, LV_LINEMETER_PART_MAIN);
+    lv_style_int_t right = lv_obj_get_style_pad_right(lmeter, LV_LINEMETER_PART_MAIN);
+    lv_style_int_t top = lv_obj_get_style_pad_top(lmeter, LV_LINEMETER_PART_MAIN);
+
+    lv_coord_t r_out = (lv_obj_get_width(lmeter) - left - right) / 2 ;
+    lv_coord_t r_in  = r_out - lv_obj_get_style_scale_width(lmeter, LV_LINEMETER_PART_MAIN);
+    if(r_in < 1) r_in = 1;
+    int16_t angle_ofs = ext->angle_ofs + 90 + (360 - ext->scale_angle) / 2;
+
+    /*Use the cached lines only if they were drawn with the current parameters*/
+    lv_linemeter_scale_cache_t * cache = &ext->scale_cache[0];
+    if(cache->lines == NULL || cache->line_cnt != ext->line_cnt || cache->scale_angle != ext->scale_angle ||
+       cache->angle_ofs != angle_ofs || cache->r_out != r_out || cache->r_in != r_in) {
+        return false;
+    }
+
+    int32_t first = LV_MATH_MAX(LV_MATH_MIN(level1, level2), 0);
+    int32_t last = LV_MATH_MIN(LV_MATH_MAX(level1, level2), ext->line_cnt - 1);
+    if(first > last) return false;
+
+    *area = cache->lines[first].area;
+    int32_t i;
+    for(i = first + 1; i <= last; i++) {
+        _lv_area_join(area, area, &cache->lines[i].area);
+    }
+
+    lv_style_int_t line_w = lv_obj_get_style_line_width(lmeter, LV_LINEMETER_PART_MAIN);
+    lv_style_int_t end_line_w = lv_obj_get_style_scale_end_line_width(lmeter, LV_LINEMETER_PART_MAIN);
+    lv_coord_t w = LV_MATH_MAX(line_w, end_line_w);
+    lv_coord_t x_ofs = lmeter->coords.x1 + r_out + left;
+    lv_coord_t y_ofs = lmeter->coords.y1 + r_out + top;
+    area->x1 += x_ofs - w;
+    area->x2 += x_ofs + w;
+    area->y1 += y_ofs - w;
+    area->y2 += y_ofs + w;
+
+    return true;
+#else
+    LV_UNUSED(lmeter);
+    LV_UNUSED(level1);
+    LV_UNUSED(level2);
+    LV_UNUSED(area);
+    return false;
+#endif
+}
+
+/**
+ * Calculate the end points of a line of the scale relative to the center
+ * @param line store the result here
+ * @param id index of the line
+ * @param line_cnt number of lines on the scale
+ * @param scale_angle angle of the scale
+ * @param angle_ofs angle of the first line
+ * @param r_out outer radius of the scale
+ * @param r_in inner radius of the scale
+ */
+static void scale_line_calc(lv_linemeter_scale_line_t * line, uint16_t id, uint16_t line_cnt, uint16_t scale_angle,
+                            int16_t angle_ofs, lv_coord_t r_out, lv_coord_t r_in)
+{
+#if LV_LINEMETER_PRECISE > 1
+    /*In calculation use a larger radius to avoid rounding errors */
+    lv_coord_t r_out_extra = r_out + LV_DPI;
+#else
+    lv_coord_t r_out_extra = r_out;
+#endif
+
+    /* `* 256` for extra precision*/
+    int32_t angle_upscale = ((int32_t)id * scale_angle * 256) / (line_cnt - 1);
+    int32_t angle_normal = angle_upscale >> 8;
+
+    int32_t angle_low = (angle_upscale >> 8);
+    int32_t angle_high = angle_low + 1;
+    int32_t angle_rem = angle_upscale & 0xFF;
+
+    /*Interpolate sine and cos*/
+    int32_t sin_low = _lv_trigo_sin(angle_low + angle_ofs);
+    int32_t sin_high = _lv_trigo_sin(angle_high + angle_ofs);
+    int32_t sin_mid = (sin_low * (256 - angle_rem) + sin_high * angle_rem) >> 8;
+
+    int32_t cos_low = _lv_trigo_sin(angle_low + 90 + angle_ofs);
+    int32_t cos_high = _lv_trigo_sin(angle_high + 90 + angle_ofs);
+    int32_t cos_mid = (cos_low * (256 - angle_rem) + cos_high * angle_rem) >> 8;
+
+    /*Use the interpolated values to get x and y coordinates*/
+    int32_t y_out_extra = (int32_t)((int32_t)sin_mid * r_out_extra) >> (LV_TRIGO_SHIFT - 8);
+    int32_t x_out_extra = (int32_t)((int32_t)cos_mid * r_out_extra) >> (LV_TRIGO_SHIFT - 8);
+
+    /*Rounding*/
+    if(x_out_extra > 0) x_out_extra = (x_out_extra + 127) >> 8;
+    else x_out_extra = (x_out_extra - 127) >> 8;
+
+    if(y_out_extra > 0) y_out_extra = (y_out_extra + 127) >> 8;
+    else y_out_extra = (y_out_extra - 127) >> 8;
+
+    line->p_out.x = x_out_extra;
+    line->p_out.y = y_out_extra;
+
+    /*With no extra precision use the coordinates on the inner radius*/
+#if LV_LINEMETER_PRECISE == 0
+    /*Use the interpolated values to get x and y coordinates*/
+    int32_t y_in_extra = (int32_t)((int32_t)sin_mid * r_in) >> (LV_TRIGO_SHIFT - 8);
+    int32_t x_in_extra = (int32_t)((int32_t)cos_mid * r_in) >> (LV_TRIGO_SHIFT - 8);
+
+    /*Rounding*/
+    if(x_in_extra > 0) x_in_extra = (x_in_extra + 127) >> 8;
+    else x_in_extra = (x_in_extra - 127) >> 8;
+
+    if(y_in_extra > 0) y_in_extra = (y_in_extra + 127) >> 8;
+    else y_in_extra = (y_in_extra - 127) >> 8;
+
+    line->p_in.x = x_in_extra;
+    line->p_in.y = y_in_extra;
+#else
+    line->p_in.x = 0;
+    line->p_in.y = 0;
+#endif
+
+    /*The area between the inner and outer radius*/
+    int32_t y_in  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + angle_ofs) * r_in) >> LV_TRIGO_SHIFT;
+    int32_t x_in  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + 90 + angle_ofs) * r_in) >> LV_TRIGO_SHIFT;
+
+    int32_t y_out  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + angle_ofs) * r_out) >> LV_TRIGO_SHIFT;
+    int32_t x_out  = (int32_t)((int32_t)_lv_trigo_sin(angle_normal + 90 + angle_ofs) * r_out) >> LV_TRIGO_SHIFT;
+
+    line->area.x1 = LV_MATH_MIN(x_in, x_out);
+    line->area.x2 = LV_MATH_MAX(x_in, x_out);
+    line->area.y1 = LV_MATH_MIN(y_in, y_out);
+    line->area.y2 = LV_MATH_MAX(y_in, y_out);
+}
+
 #endif
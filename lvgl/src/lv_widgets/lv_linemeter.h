@@ -26,6 +26,25 @@ extern "C" {
 /**********************
  *      TYPEDEFS
  **********************/
+/*End points of a line of the scale relative to the center*/
+typedef struct {
+    lv_point_t p_out;   /*Outer end point (further out with extra precision)*/
+    lv_point_t p_in;    /*Inner end point (the center with extra precision)*/
+    lv_area_t area;     /*Area of the line between the inner and outer radius*/
+} lv_linemeter_scale_line_t;
+
+#if LV_LINEMETER_SCALE_CACHE
+/*The lines of a scale and the parameters they were calculated with*/
+typedef struct {
+    lv_linemeter_scale_line_t * lines;
+    uint16_t line_cnt;
+    uint16_t scale_angle;
+    int16_t angle_ofs;
+    lv_coord_t r_out;
+    lv_coord_t r_in;
+} lv_linemeter_scale_cache_t;
+#endif
+
 /*Data of line meter*/
 typedef struct {
     /*No inherited ext.*/ /*Ext. of ancestor*/
@@ -37,6 +56,9 @@ typedef struct {
     int32_t min_value;
     int32_t max_value;
     uint8_t mirrored : 1;
+#if LV_LINEMETER_SCALE_CACHE
+    lv_linemeter_scale_cache_t scale_cache[2];  /*Of the main part and an other part (e.g. the major lines of a gauge)*/
+#endif
 } lv_linemeter_ext_t;
 
 /*Styles*/
@@ -150,6 +172,16 @@ uint16_t lv_linemeter_get_angle_offset(lv_obj_t * lmeter);
 
 void lv_linemeter_draw_scale(lv_obj_t * lmeter, const lv_area_t * clip_area, uint8_t part);
 
+/**
+ * Draw the scale of a line meter with an other number of lines.
+ * The line meter is not modified so other rendering threads can draw it at the same time.
+ * @param lmeter pointer to a line meter object
+ * @param clip_area the scale will be drawn only in this area
+ * @param part the part whose scale should be drawn
+ * @param line_cnt number of lines to draw on the scale
+ */
+void _lv_linemeter_draw_scale_lines(lv_obj_t * lmeter, const lv_area_t * clip_area, uint8_t part, uint16_t line_cnt);
+
 /**
  * get the mirror setting for the line meter
  * @param lmeter pointer to a line meter object
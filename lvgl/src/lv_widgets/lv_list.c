@@ -547,6 +547,9 @@ void lv_list_up(const lv_obj_t * list)
 {
     LV_ASSERT_OBJ(list, LV_OBJX_NAME);
 
+    /*The coordinates are read so refresh the layouts first*/
+    lv_layout_flush();
+
     /*Search the first list element which 'y' coordinate is below the parent
      * and position the list to show this element on the bottom*/
     lv_obj_t * scrl = lv_page_get_scrollable(list);
@@ -588,6 +591,9 @@ void lv_list_down(const lv_obj_t * list)
 {
     LV_ASSERT_OBJ(list, LV_OBJX_NAME);
 
+    /*The coordinates are read so refresh the layouts first*/
+    lv_layout_flush();
+
     /*Search the first list element which 'y' coordinate is above the parent
      * and position the list to show this element on the top*/
     lv_obj_t * scrl = lv_page_get_scrollable(list);
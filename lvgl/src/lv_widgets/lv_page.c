@@ -440,6 +440,9 @@ bool lv_page_on_edge(lv_obj_t * page, lv_page_edge_t edge)
     lv_area_t page_coords;
     lv_area_t scrl_coords;
 
+    /*The coordinates are read so refresh the layouts first*/
+    lv_layout_flush();
+
     lv_obj_get_coords(scrl, &scrl_coords);
     lv_obj_get_coords(page, &page_coords);
 
@@ -486,6 +489,9 @@ void lv_page_focus(lv_obj_t * page, const lv_obj_t * obj, lv_anim_enable_t anim_
     lv_anim_del(ext->scrl, (lv_anim_exec_xcb_t)lv_obj_set_y);
 #endif
 
+    /*The coordinates are read so refresh the layouts first*/
+    lv_layout_flush();
+
     /*if using focus mode, change target to parent*/
     obj = lv_obj_get_focused_obj(obj);
 
@@ -209,6 +209,8 @@ all_obj_minimal_features = {
 all_obj_all_features = {
   "LV_DPI":100,
   "LV_MEM_SIZE":32*1024,
+  "LV_MEM_TLSF":1,
+  "LV_USE_OBJ_POOL":1,
   "LV_HOR_RES_MAX":480,
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
@@ -303,6 +305,22 @@ advanced_features = {
   "LV_USE_API_EXTENSION_V6":1,
   "LV_USE_USER_DATA":1,
   "LV_IMG_CACHE_DEF_SIZE":32,
+  "LV_FONT_GLYPH_CACHE_CNT":64,
+  "LV_SHADOW_CACHE_SIZE":64,
+  "LV_SHADOW_CACHE_CNT":4,
+  "LV_SHADOW_CACHE_MAX_BYTES":8*1024,
+  "LV_IMG_DECODER_FILE_BUF_SIZE":2*1024,
+  "LV_USE_FONT_LOOKUP_TABLES":1,
+  "LV_USE_GPU_SIMD":1,
+  "LV_USE_OCCLUSION_CULLING":1,
+  "LV_USE_STYLE_RES_TABLE":1,
+  "LV_LABEL_LINE_CACHE":1,
+  "LV_CONT_LAYOUT_DEFER":1,
+  "LV_INDEV_HIT_INDEX":1,
+  "LV_LINEMETER_SCALE_CACHE":1,
+  "LV_USE_PROF":1,
+  "LV_USE_REFR_THREADS":1,
+  "LV_USE_FLUSH_THREAD":1,
   "LV_USE_LOG":1,
   "LV_USE_THEME_MATERIAL":1,  
   "LV_USE_THEME_EMPTY":1,  
@@ -0,0 +1,200 @@
+/**
+ * @file lv_test_anim.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_anim.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define VAR_CNT     20
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_ANIMATION
+static void get_and_del(void);
+static void del_while_running(void);
+static void start_anim(void * var, lv_anim_exec_xcb_t exec_cb, uint32_t time);
+static void exec_x(void * var, lv_anim_value_t v);
+static void exec_y(void * var, lv_anim_value_t v);
+static void ready_del_next(lv_anim_t * a);
+static void tick_and_refr(uint32_t ms);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_ANIMATION
+static lv_point_t vars[VAR_CNT];
+static uint32_t ready_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_anim(void)
+{
+#if LV_USE_ANIMATION
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_anim tests");
+    lv_test_print("===================");
+
+    get_and_del();
+    del_while_running();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_ANIMATION
+
+static void get_and_del(void)
+{
+    lv_test_print("");
+    lv_test_print("Get and delete the animations of variables:");
+    lv_test_print("-------------------------------------------");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint16_t cnt_start = lv_anim_count_running();
+    uint32_t i;
+    for(i = 0; i < VAR_CNT; i++) {
+        start_anim(&vars[i], exec_x, 1000);
+        start_anim(&vars[i], exec_y, 1000);
+    }
+    lv_test_assert_int_eq(cnt_start + 2 * VAR_CNT, lv_anim_count_running(), "Number of animations");
+
+    bool found = true;
+    for(i = 0; i < VAR_CNT; i++) {
+        lv_anim_t * a = lv_anim_get(&vars[i], exec_y);
+        if(a == NULL || a->var != &vars[i] || a->exec_cb != exec_y) found = false;
+    }
+    lv_test_assert_true(found, "Get the animations");
+
+    lv_test_print("Start an animation again");
+    start_anim(&vars[0], exec_x, 500);
+    lv_test_assert_int_eq(cnt_start + 2 * VAR_CNT, lv_anim_count_running(), "The old animation is replaced");
+    lv_test_assert_int_eq(500, lv_anim_get(&vars[0], exec_x)->time, "Time of the new animation");
+
+    lv_test_print("Delete one animation of the variables");
+    for(i = 0; i < VAR_CNT; i += 2) lv_anim_del(&vars[i], exec_x);
+    lv_test_assert_int_eq(cnt_start + VAR_CNT + VAR_CNT / 2, lv_anim_count_running(), "Number of animations");
+    lv_test_assert_true(lv_anim_get(&vars[0], exec_x) == NULL, "Deleted animation");
+    lv_test_assert_true(lv_anim_get(&vars[0], exec_y) != NULL, "The other animation is kept");
+
+    lv_test_print("Delete all animations of the variables");
+    bool del = true;
+    for(i = 0; i < VAR_CNT; i++) {
+        if(!lv_anim_del(&vars[i], NULL)) del = false;
+    }
+    lv_test_assert_true(del, "Deleted");
+    lv_test_assert_int_eq(cnt_start, lv_anim_count_running(), "Number of animations");
+    lv_test_assert_true(lv_anim_del(&vars[0], NULL) == false, "Nothing to delete");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Memory leak");
+}
+
+static void del_while_running(void)
+{
+    lv_test_print("");
+    lv_test_print("Delete animations in the callbacks:");
+    lv_test_print("-----------------------------------");
+
+    uint16_t cnt_start = lv_anim_count_running();
+    uint32_t i;
+    for(i = 0; i < VAR_CNT; i++) {
+        vars[i].x = 0;
+        vars[i].y = 0;
+        start_anim(&vars[i], exec_x, 1);
+        start_anim(&vars[i], exec_y, 1);
+    }
+
+    /*Every ready animation deletes the animations of the next variable,
+     *so (about) half of the variables get their end values*/
+    ready_cnt = 0;
+    tick_and_refr(5);
+
+    uint32_t end_cnt = 0;
+    bool valid = true;
+    for(i = 0; i < VAR_CNT; i++) {
+        if(vars[i].x == 100) end_cnt++;
+        if(vars[i].x != 0 && vars[i].x != 100) valid = false;
+    }
+
+    lv_test_assert_int_eq(cnt_start, lv_anim_count_running(), "All animations are ready or deleted");
+    lv_test_assert_int_eq(2 * end_cnt, ready_cnt, "Ready callbacks of the animations which reached the end");
+    lv_test_assert_int_gt(0, end_cnt, "Some animations are ready");
+    lv_test_assert_true(end_cnt < VAR_CNT, "Some animations are deleted");
+    lv_test_assert_true(valid, "Start or end values");
+}
+
+static void start_anim(void * var, lv_anim_exec_xcb_t exec_cb, uint32_t time)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_ready_cb(&a, ready_del_next);
+    lv_anim_start(&a);
+}
+
+static void exec_x(void * var, lv_anim_value_t v)
+{
+    ((lv_point_t *)var)->x = v;
+}
+
+static void exec_y(void * var, lv_anim_value_t v)
+{
+    ((lv_point_t *)var)->y = v;
+}
+
+/**
+ * Delete the animations of the next variable
+ */
+static void ready_del_next(lv_anim_t * a)
+{
+    ready_cnt++;
+
+    lv_point_t * var = a->var;
+    if(var + 1 < &vars[VAR_CNT]) lv_anim_del(var + 1, NULL);
+}
+
+/**
+ * Let some time elapse and refresh the animations
+ */
+static void tick_and_refr(uint32_t ms)
+{
+    lv_tick_inc(ms);
+    lv_anim_refr_now();
+}
+
+#endif /*LV_USE_ANIMATION*/
+#endif /*LV_BUILD_TEST*/
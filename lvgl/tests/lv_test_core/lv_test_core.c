@@ -11,8 +11,15 @@
 #if LV_BUILD_TEST
 #include "lv_test_core.h"
 #include "lv_test_obj.h"
+#include "lv_test_mem.h"
 #include "lv_test_style.h"
 #include "lv_test_font_loader.h"
+#include "lv_test_img_cache.h"
+#include "lv_test_shadow_cache.h"
+#include "lv_test_img_decoder.h"
+#include "lv_test_anim.h"
+#include "lv_test_indev.h"
+#include "lv_test_prof.h"
 
 /*********************
  *      DEFINES
@@ -45,9 +52,16 @@ void lv_test_core(void)
     lv_test_print("Start lv_core tests");
     lv_test_print("*******************");
 
+    lv_test_mem();
     lv_test_obj();
     lv_test_style();
     lv_test_font_loader();
+    lv_test_img_cache();
+    lv_test_shadow_cache();
+    lv_test_img_decoder();
+    lv_test_anim();
+    lv_test_indev();
+    lv_test_prof();
 }
 
 
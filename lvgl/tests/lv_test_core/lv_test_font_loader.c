@@ -15,6 +15,7 @@
 #include "../src/lv_font/lv_font_loader.h"
 
 #include "lv_test_font_loader.h" 
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -30,6 +31,16 @@
 
 #if LV_USE_FILESYSTEM
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void lazy_load(lv_font_t * f_ref, const char * path);
+static bool compare_bitmaps(lv_font_t * f1, lv_font_t * f2);
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+static void glyph_cache(lv_font_t * f1, lv_font_t * f2);
+#endif
+#if LV_USE_FONT_LOOKUP_TABLES
+static void lookup_tables(lv_font_t * f1, lv_font_t * f2);
+static uint32_t ref_glyph_id(const lv_font_fmt_txt_dsc_t * dsc, uint32_t letter);
+static int8_t ref_kern_value(const lv_font_fmt_txt_kern_pair_t * kern, uint32_t gid_left, uint32_t gid_right);
+#endif
 #endif
 
 /**********************
@@ -59,15 +70,281 @@ void lv_test_font_loader(void)
     compare_fonts(&font_2, font_2_bin);
     compare_fonts(&font_3, font_3_bin);
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+    glyph_cache(&font_1, font_1_bin);
+#endif
+
+#if LV_USE_FONT_LOOKUP_TABLES
+    lookup_tables(&font_1, font_1_bin);
+#endif
+
     lv_font_free(font_1_bin);
     lv_font_free(font_2_bin);
     lv_font_free(font_3_bin);
+
+    lazy_load(&font_1, "f:font_1.fnt");
+    lazy_load(&font_2, "f:font_2.fnt");
+    lazy_load(&font_3, "f:font_3.fnt");
 #else
     lv_test_print("SKIP: font load test because it requires LV_USE_FILESYSTEM 1 and LV_FONT_FMT_TXT_LARGE 0");
 #endif
 }
 
 #if LV_USE_FILESYSTEM
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_CNT
+static void glyph_cache(lv_font_t * f1, lv_font_t * f2)
+{
+    lv_test_print("");
+    lv_test_print("Cache the glyphs of a compressed font:");
+    lv_test_print("--------------------------------------");
+
+    lv_font_glyph_cache_clear();
+    lv_font_glyph_cache_reset_stat();
+
+    lv_font_glyph_dsc_t g;
+    lv_test_assert_true(lv_font_get_glyph_dsc(f1, &g, 'A', '\0'), "Glyph of 'A'");
+    uint32_t size = (g.box_w * g.box_h * g.bpp + 7) / 8;
+
+    const uint8_t * b1 = lv_font_get_glyph_bitmap(f1, 'A');
+    const uint8_t * b1_again = lv_font_get_glyph_bitmap(f1, 'A');
+    lv_test_assert_ptr_eq(b1, b1_again, "The same bitmap is returned again");
+
+    const uint8_t * b2 = lv_font_get_glyph_bitmap(f2, 'A');
+    lv_test_assert_true(b1 != b2, "Other font has other cached bitmap");
+    lv_test_assert_array_eq(b1, b2, size, "Content of the cached bitmaps");
+
+    lv_font_glyph_cache_stat_t stat;
+    lv_font_glyph_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.hit_cnt, "Cache hits");
+    lv_test_assert_int_eq(2, stat.miss_cnt, "Cache misses");
+    lv_test_assert_int_eq(2, stat.glyph_cnt, "Cached glyphs");
+
+    lv_test_print("Fill the cache with more glyphs than its size");
+    uint32_t i;
+    for(i = 0; i < LV_FONT_GLYPH_CACHE_CNT + 1; i++) {
+        lv_font_get_glyph_bitmap(f1, '!' + (i % 94));
+        lv_font_get_glyph_bitmap(f2, '!' + (i % 94));
+    }
+    lv_font_glyph_cache_get_stat(&stat);
+    lv_test_assert_true(stat.glyph_cnt <= LV_FONT_GLYPH_CACHE_CNT, "Number of cached glyphs is limited");
+    lv_test_assert_true(stat.evict_cnt > 0, "Glyphs are evicted");
+
+    lv_font_glyph_cache_clear();
+    lv_font_glyph_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.glyph_cnt, "Cached glyphs after clear");
+    lv_test_assert_int_eq(0, stat.size, "Cache size after clear");
+}
+#endif
+
+#if LV_USE_FONT_LOOKUP_TABLES
+static void lookup_tables(lv_font_t * f1, lv_font_t * f2)
+{
+    lv_test_print("");
+    lv_test_print("Find the glyphs and kerning values in lookup tables:");
+    lv_test_print("----------------------------------------------------");
+
+    lv_font_fmt_txt_dsc_t * dsc1 = (lv_font_fmt_txt_dsc_t *) f1->dsc;
+    lv_font_fmt_txt_dsc_t * dsc2 = (lv_font_fmt_txt_dsc_t *) f2->dsc;
+    lv_font_fmt_txt_free_lookup(f1);
+    lv_font_fmt_txt_free_lookup(f2);
+
+    lv_test_print("Get the glyph of every code point in the built-in and in the loaded font");
+    bool same = true;
+    uint32_t letter;
+    for(letter = 1; letter <= 0xFFFF && same; letter++) {
+        if(letter == '\t') continue;   /*Replaced by a space*/
+
+        uint32_t gid = ref_glyph_id(dsc1, letter);
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        bool found1 = lv_font_get_glyph_dsc(f1, &g1, letter, '\0');
+        bool found2 = lv_font_get_glyph_dsc(f2, &g2, letter, '\0');
+        if(found1 != (gid != 0) || found2 != found1) same = false;
+        else if(gid) {
+            const lv_font_fmt_txt_glyph_dsc_t * gdsc = &dsc1->glyph_dsc[gid];
+            if(g1.box_w != gdsc->box_w || g1.ofs_y != gdsc->ofs_y || g1.adv_w != (gdsc->adv_w + 8) >> 4) same = false;
+            if(g2.box_w != g1.box_w || g2.ofs_y != g1.ofs_y || g2.adv_w != g1.adv_w) same = false;
+        }
+    }
+    lv_test_assert_true(same, "The glyphs are the same as with search");
+    lv_test_assert_true(dsc1->lookup != NULL, "The built-in font has lookup tables");
+    lv_test_assert_true(dsc2->lookup != NULL && dsc2->lookup != dsc1->lookup, "The loaded font has its own lookup tables");
+
+    lv_test_print("Get the kerning values of kerning pairs");
+    /*"AV", "To" and "VA" ordered by the glyph IDs*/
+    uint8_t pair_ids[6];
+    pair_ids[0] = ref_glyph_id(dsc1, 'A');
+    pair_ids[1] = ref_glyph_id(dsc1, 'V');
+    pair_ids[2] = ref_glyph_id(dsc1, 'T');
+    pair_ids[3] = ref_glyph_id(dsc1, 'o');
+    pair_ids[4] = ref_glyph_id(dsc1, 'V');
+    pair_ids[5] = ref_glyph_id(dsc1, 'A');
+    static const int8_t pair_values[] = {-20, -10, -24};
+
+    lv_font_fmt_txt_kern_pair_t kern_pairs;
+    kern_pairs.glyph_ids = pair_ids;
+    kern_pairs.values = pair_values;
+    kern_pairs.pair_cnt = 3;
+    kern_pairs.glyph_ids_size = 0;
+
+    lv_font_fmt_txt_dsc_t kern_dsc = *dsc1;
+    kern_dsc.kern_dsc = &kern_pairs;
+    kern_dsc.kern_classes = 0;
+    kern_dsc.kern_scale = 16;
+    kern_dsc.lookup = NULL;
+
+    lv_font_t kern_font = *f1;
+    kern_font.dsc = &kern_dsc;
+
+    /*Run twice to get the values from the hash too*/
+    same = true;
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        uint32_t left;
+        for(left = '!'; left <= '~'; left++) {
+            uint32_t right;
+            for(right = '!'; right <= '~'; right++) {
+                uint32_t gid_left = ref_glyph_id(dsc1, left);
+                uint32_t gid_right = ref_glyph_id(dsc1, right);
+                int32_t adv_w = dsc1->glyph_dsc[gid_left].adv_w + ref_kern_value(&kern_pairs, gid_left, gid_right);
+                adv_w = (adv_w + 8) >> 4;
+
+                lv_font_glyph_dsc_t g;
+                lv_font_get_glyph_dsc(&kern_font, &g, left, right);
+                if(g.adv_w != adv_w) same = false;
+            }
+        }
+    }
+    lv_test_assert_true(same, "The kerning values are the same as with search");
+    lv_test_assert_true(lv_font_get_glyph_width(&kern_font, 'A', 'V') < lv_font_get_glyph_width(&kern_font, 'A', 'B'),
+                        "\"AV\" is kerned");
+
+    lv_font_fmt_txt_free_lookup(&kern_font);
+    lv_test_assert_true(kern_dsc.lookup == NULL, "No lookup tables after free");
+
+    lv_font_fmt_txt_free_lookup(f1);
+    lv_test_assert_true(dsc1->lookup == NULL, "No lookup tables of the built-in font after free");
+    lv_test_assert_true(lv_font_get_glyph_width(f1, 'A', '\0') > 0, "The tables are built again");
+    lv_test_assert_true(dsc1->lookup != NULL, "The built-in font has lookup tables again");
+}
+
+/**
+ * Find the glyph ID of a letter by walking the cmaps
+ */
+static uint32_t ref_glyph_id(const lv_font_fmt_txt_dsc_t * dsc, uint32_t letter)
+{
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        uint32_t rcp = letter - cmap->range_start;
+        if(rcp >= cmap->range_length) continue;
+
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) return cmap->glyph_id_start + rcp;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            return cmap->glyph_id_start + ((const uint8_t *)cmap->glyph_id_ofs_list)[rcp];
+        }
+
+        uint32_t j;
+        for(j = 0; j < cmap->list_length; j++) {
+            if(cmap->unicode_list[j] != rcp) continue;
+            if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) return cmap->glyph_id_start + j;
+            else return cmap->glyph_id_start + ((const uint8_t *)cmap->glyph_id_ofs_list)[j];
+        }
+        return 0;
+    }
+    return 0;
+}
+
+/**
+ * Find the kerning value of a glyph pair by walking the pairs
+ */
+static int8_t ref_kern_value(const lv_font_fmt_txt_kern_pair_t * kern, uint32_t gid_left, uint32_t gid_right)
+{
+    const uint8_t * ids = kern->glyph_ids;
+    uint32_t i;
+    for(i = 0; i < kern->pair_cnt; i++) {
+        if(ids[i * 2] == gid_left && ids[i * 2 + 1] == gid_right) return kern->values[i];
+    }
+    return 0;
+}
+#endif
+
+static void lazy_load(lv_font_t * f_ref, const char * path)
+{
+    lv_test_print("");
+    lv_test_print("Load a font lazily:");
+    lv_test_print("-------------------");
+
+    /*Decompress and cache everything of the reference font before measuring the memory*/
+    compare_bitmaps(f_ref, f_ref);
+
+#if LV_MEM_CUSTOM == 0
+    _lv_font_clean_up_fmt_txt();
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_font_t * font_bin = lv_font_load(path);
+    lv_mem_monitor_t mon_full;
+    lv_mem_monitor(&mon_full);
+    lv_font_free(font_bin);
+#endif
+
+    lv_font_t * font_lazy = lv_font_load_lazy(path, 4);
+    lv_test_assert_true(font_lazy != NULL, "Load the font");
+    if(font_lazy == NULL) return;
+
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon_lazy;
+    lv_mem_monitor(&mon_lazy);
+    lv_test_assert_int_gt(mon_full.free_size, mon_lazy.free_size, "Uses less memory than the fully loaded font");
+#endif
+
+    /*Twice to read the glyphs again after they were evicted from the small cache*/
+    lv_test_assert_true(compare_bitmaps(f_ref, font_lazy), "The bitmaps are the same as in the built-in font");
+    lv_test_assert_true(compare_bitmaps(f_ref, font_lazy), "The bitmaps are the same again");
+
+    lv_font_free(font_lazy);
+
+#if LV_MEM_CUSTOM == 0
+    _lv_font_clean_up_fmt_txt();
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing the font");
+#endif
+}
+
+/**
+ * Compare the bitmaps of every glyph of two fonts
+ */
+static bool compare_bitmaps(lv_font_t * f1, lv_font_t * f2)
+{
+    uint32_t letter;
+    for(letter = 0x20; letter <= 0xFFFF; letter++) {
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        bool found1 = lv_font_get_glyph_dsc(f1, &g1, letter, '\0');
+        bool found2 = lv_font_get_glyph_dsc(f2, &g2, letter, '\0');
+        if(found1 != found2) return false;
+        if(!found1 || g1.box_w * g1.box_h == 0) continue;
+        if(g1.box_w != g2.box_w || g1.box_h != g2.box_h || g1.bpp != g2.bpp) return false;
+
+        /*The bitmaps can be in a common buffer so save the first*/
+        uint32_t size = (g1.box_w * g1.box_h * g1.bpp + 7) / 8;
+        uint8_t * b1 = _lv_mem_buf_get(size);
+        const uint8_t * b1_font = lv_font_get_glyph_bitmap(f1, letter);
+        if(b1_font) _lv_memcpy(b1, b1_font, size);
+
+        const uint8_t * b2 = lv_font_get_glyph_bitmap(f2, letter);
+        bool same = b1_font && b2 && memcmp(b1, b2, size) == 0;
+        _lv_mem_buf_release(b1);
+        if(!same) return false;
+    }
+
+    return true;
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     lv_test_assert_true(f1 != NULL && f2 != NULL, "font not null");
@@ -0,0 +1,185 @@
+/**
+ * @file lv_test_img_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_cache.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hit_miss_evict(void);
+static void max_bytes(void);
+static lv_res_t decoded_info_cb(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t decoded_open_cb(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t img_buf[3][4 * 4];
+static lv_img_dsc_t decoded_img[4];
+static lv_color_t decoded_buf[4 * 4];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_img_cache tests");
+    lv_test_print("========================");
+
+    hit_miss_evict();
+    max_bytes();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void hit_miss_evict(void)
+{
+    lv_test_print("");
+    lv_test_print("Hit, miss and evict images in the cache:");
+    lv_test_print("----------------------------------------");
+
+    lv_img_dsc_t img[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        _lv_memset_00(&img[i], sizeof(lv_img_dsc_t));
+        img[i].header.cf = LV_IMG_CF_TRUE_COLOR;
+        img[i].header.w = 4;
+        img[i].header.h = 4;
+        img[i].data_size = sizeof(img_buf[i]);
+        img[i].data = (const uint8_t *)img_buf[i];
+    }
+
+    lv_img_cache_set_size(2);
+    lv_img_cache_reset_stat();
+
+    lv_img_cache_stat_t stat;
+    lv_test_print("Open the first image twice");
+    lv_img_cache_entry_t * e0 = _lv_img_cache_open(&img[0], LV_COLOR_BLACK);
+    lv_test_assert_ptr_eq(e0, _lv_img_cache_open(&img[0], LV_COLOR_BLACK), "Same entry for the same image");
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.hit_cnt, "Hit count");
+    lv_test_assert_int_eq(1, stat.miss_cnt, "Miss count");
+
+    lv_test_print("Open two other images");
+    _lv_img_cache_open(&img[1], LV_COLOR_BLACK);
+    _lv_img_cache_open(&img[0], LV_COLOR_BLACK);
+    _lv_img_cache_open(&img[2], LV_COLOR_BLACK);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.evict_cnt, "Evict count");
+    lv_test_assert_int_eq(2, stat.entry_cnt, "Cached images");
+
+    lv_test_print("The least recently used image was closed");
+    _lv_img_cache_open(&img[0], LV_COLOR_BLACK);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(3, stat.hit_cnt, "Hit count after reopening the recently used image");
+    _lv_img_cache_open(&img[1], LV_COLOR_BLACK);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(4, stat.miss_cnt, "Miss count after reopening the evicted image");
+
+    lv_test_print("Invalidate an image");
+    lv_img_cache_invalidate_src(&img[1]);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.entry_cnt, "Cached images after invalidation");
+
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_reset_stat();
+}
+
+static void max_bytes(void)
+{
+    lv_test_print("");
+    lv_test_print("Limit the memory used by the decoded images:");
+    lv_test_print("--------------------------------------------");
+
+    /*A decoder which decodes the images to a buffer so they use memory in the cache*/
+    lv_img_decoder_t * dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, decoded_info_cb);
+    lv_img_decoder_set_open_cb(dec, decoded_open_cb);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        _lv_memset_00(&decoded_img[i], sizeof(lv_img_dsc_t));
+        decoded_img[i].header.cf = LV_IMG_CF_TRUE_COLOR;
+        decoded_img[i].header.w = 4;
+        decoded_img[i].header.h = 4;
+        decoded_img[i].data_size = sizeof(img_buf[0]);
+        decoded_img[i].data = (const uint8_t *)img_buf[0];
+    }
+    uint32_t img_size = lv_img_buf_get_img_size(4, 4, LV_IMG_CF_TRUE_COLOR);
+
+    /*More entries than images to have empty entries in the cache*/
+    lv_img_cache_set_size(8);
+    lv_img_cache_set_max_bytes(img_size * 5 / 2);
+    lv_img_cache_reset_stat();
+
+    lv_img_cache_stat_t stat;
+    lv_test_print("Open four images with empty entries in the cache");
+    for(i = 0; i < 4; i++) _lv_img_cache_open(&decoded_img[i], LV_COLOR_BLACK);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(2, stat.entry_cnt, "Cached images");
+    lv_test_assert_int_eq(2 * img_size, stat.size, "Size of the cached images");
+    lv_test_assert_int_eq(2, stat.evict_cnt, "Evict count");
+
+    lv_test_print("The most recently used images are kept");
+    _lv_img_cache_open(&decoded_img[3], LV_COLOR_BLACK);
+    _lv_img_cache_open(&decoded_img[2], LV_COLOR_BLACK);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(2, stat.hit_cnt, "Hit count");
+
+    lv_test_print("Decrease the limit");
+    lv_img_cache_set_max_bytes(img_size);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.entry_cnt, "Cached images");
+    lv_test_assert_int_eq(img_size, stat.size, "Size of the cached images");
+
+    lv_img_cache_set_max_bytes(LV_IMG_CACHE_DEF_MAX_BYTES);
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_reset_stat();
+    lv_img_decoder_delete(dec);
+}
+
+static lv_res_t decoded_info_cb(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+
+    const lv_img_dsc_t * img = src;
+    if(img < &decoded_img[0] || img > &decoded_img[3]) return LV_RES_INV;
+
+    *header = img->header;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoded_open_cb(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    dsc->img_data = (const uint8_t *)decoded_buf;
+    return LV_RES_OK;
+}
+#endif
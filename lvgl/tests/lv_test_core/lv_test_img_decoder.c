@@ -0,0 +1,269 @@
+/**
+ * @file lv_test_img_decoder.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_decoder.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define IMG_W       37
+#define IMG_H       23
+#define IMG_FILE    "lv_test_img_decoder.bin"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_FILESYSTEM
+static void same_lines(void);
+static void few_reads(void);
+static void truncated_file(void);
+static bool lines_eq(const lv_img_dsc_t * img, const char * path, bool bottom_up);
+static void read_lines(const char * path);
+static void get_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
+static void create_img(lv_img_dsc_t * img, lv_img_cf_t cf, uint32_t seed);
+static void write_img(const lv_img_dsc_t * img, uint32_t size);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_FILESYSTEM
+static uint8_t img_data[IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static uint8_t line_buf[IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static uint8_t ref_line_buf[IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+static const lv_img_cf_t cfs[] = {
+    LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_TRUE_COLOR_ALPHA,
+#if LV_IMG_CF_INDEXED
+    LV_IMG_CF_INDEXED_1BIT, LV_IMG_CF_INDEXED_4BIT, LV_IMG_CF_INDEXED_8BIT,
+#endif
+#if LV_IMG_CF_ALPHA
+    LV_IMG_CF_ALPHA_2BIT, LV_IMG_CF_ALPHA_8BIT,
+#endif
+};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_decoder(void)
+{
+#if LV_USE_FILESYSTEM
+    lv_test_print("");
+    lv_test_print("==========================");
+    lv_test_print("Start lv_img_decoder tests");
+    lv_test_print("==========================");
+
+    same_lines();
+    few_reads();
+    truncated_file();
+
+    remove(IMG_FILE);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_FILESYSTEM
+
+static void same_lines(void)
+{
+    lv_test_print("");
+    lv_test_print("Read the same lines from files as from variables:");
+    lv_test_print("-------------------------------------------------");
+
+    bool read_ok = true;
+    bool map_ok = true;
+    bool bottom_up_ok = true;
+    uint32_t c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_img_dsc_t img;
+        create_img(&img, cfs[c], c + 1);
+        write_img(&img, img.data_size);
+
+        if(!lines_eq(&img, "f:" IMG_FILE, false)) read_ok = false;
+        if(!lines_eq(&img, "f:" IMG_FILE, true)) bottom_up_ok = false;
+        if(!lines_eq(&img, "m:" IMG_FILE, false)) map_ok = false;
+    }
+
+    lv_test_assert_true(read_ok, "Read files");
+    lv_test_assert_true(bottom_up_ok, "Read files from bottom to top");
+    lv_test_assert_true(map_ok, "Mapped files");
+}
+
+static void few_reads(void)
+{
+    lv_test_print("");
+    lv_test_print("Count the reads of the files:");
+    lv_test_print("-----------------------------");
+
+    lv_img_dsc_t img;
+    create_img(&img, LV_IMG_CF_TRUE_COLOR_ALPHA, 100);
+    write_img(&img, img.data_size);
+
+    lv_img_decoder_file_stat_t stat;
+    lv_img_decoder_reset_file_stat();
+    read_lines("f:" IMG_FILE);
+    lv_img_decoder_get_file_stat(&stat);
+#if LV_IMG_DECODER_FILE_BUF_SIZE
+    lv_test_print("The rows are read in strips");
+    lv_test_assert_true(stat.read_cnt < IMG_H / 4, "Fewer reads than rows");
+    lv_test_assert_int_gt(IMG_H / 2, stat.buf_hit_cnt, "Lines found in the buffer");
+#else
+    lv_test_print("Every line is read");
+    lv_test_assert_int_eq(IMG_H, stat.read_cnt, "A read for every line");
+#endif
+
+    lv_test_print("Mapped files are not read");
+    lv_img_decoder_reset_file_stat();
+    read_lines("m:" IMG_FILE);
+    lv_img_decoder_get_file_stat(&stat);
+    lv_test_assert_int_eq(1, stat.map_cnt, "Map count");
+    lv_test_assert_int_eq(0, stat.read_cnt, "Read count");
+    lv_test_assert_int_eq(IMG_H, stat.buf_hit_cnt, "Lines found in the mapped file");
+}
+
+static void truncated_file(void)
+{
+    lv_test_print("");
+    lv_test_print("Read a truncated file:");
+    lv_test_print("----------------------");
+
+    lv_img_dsc_t img;
+    create_img(&img, LV_IMG_CF_TRUE_COLOR, 200);
+    write_img(&img, img.data_size - 1);
+
+    static const char * paths[] = {"f:" IMG_FILE, "m:" IMG_FILE};
+    uint32_t i;
+    for(i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        lv_img_decoder_dsc_t dsc;
+        lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_open(&dsc, paths[i], LV_COLOR_BLACK), "Open the file");
+        lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, 0, IMG_W, line_buf), "Read the first line");
+        lv_test_assert_int_eq(LV_RES_INV, lv_img_decoder_read_line(&dsc, 0, IMG_H - 1, IMG_W, line_buf),
+                              "Read the last line");
+        lv_img_decoder_close(&dsc);
+    }
+}
+
+/**
+ * Compare the lines of an image variable with the lines of the same image in a file
+ * @param bottom_up true: read the lines from bottom to top
+ */
+static bool lines_eq(const lv_img_dsc_t * img, const char * path, bool bottom_up)
+{
+    static const lv_coord_t parts[][2] = {{0, IMG_W}, {3, 10}, {IMG_W - 5, 5}, {1, 1}};
+
+    lv_img_decoder_dsc_t ref_dsc;
+    lv_img_decoder_dsc_t dsc;
+    if(lv_img_decoder_open(&ref_dsc, img, LV_COLOR_BLACK) != LV_RES_OK) return false;
+    if(lv_img_decoder_open(&dsc, path, LV_COLOR_BLACK) != LV_RES_OK) {
+        lv_img_decoder_close(&ref_dsc);
+        return false;
+    }
+
+    bool eq = true;
+    lv_coord_t i;
+    for(i = 0; i < IMG_H; i++) {
+        lv_coord_t y = bottom_up ? IMG_H - 1 - i : i;
+        uint32_t p;
+        for(p = 0; p < sizeof(parts) / sizeof(parts[0]); p++) {
+            lv_coord_t x = parts[p][0];
+            lv_coord_t len = parts[p][1];
+            get_line(&ref_dsc, x, y, len, ref_line_buf);
+            memset(line_buf, 0, len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+            if(lv_img_decoder_read_line(&dsc, x, y, len, line_buf) != LV_RES_OK) eq = false;
+            else if(memcmp(line_buf, ref_line_buf, len * LV_IMG_PX_SIZE_ALPHA_BYTE)) eq = false;
+        }
+    }
+
+    lv_img_decoder_close(&dsc);
+    lv_img_decoder_close(&ref_dsc);
+
+    return eq;
+}
+
+/**
+ * Read the lines of an image file from top to bottom
+ */
+static void read_lines(const char * path)
+{
+    lv_img_decoder_dsc_t dsc;
+    if(lv_img_decoder_open(&dsc, path, LV_COLOR_BLACK) != LV_RES_OK) return;
+
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) lv_img_decoder_read_line(&dsc, 0, y, IMG_W, line_buf);
+
+    lv_img_decoder_close(&dsc);
+}
+
+/**
+ * Get a line of an opened image variable
+ */
+static void get_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    memset(buf, 0, len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    if(dsc->img_data) {
+        uint32_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+        memcpy(buf, &dsc->img_data[(y * dsc->header.w + x) * px_size], len * px_size);
+    }
+    else {
+        lv_img_decoder_read_line(dsc, x, y, len, buf);
+    }
+}
+
+/**
+ * Fill an image with random bytes (including its palette)
+ */
+static void create_img(lv_img_dsc_t * img, lv_img_cf_t cf, uint32_t seed)
+{
+    memset(img, 0, sizeof(lv_img_dsc_t));
+    img->header.cf = cf;
+    img->header.w = IMG_W;
+    img->header.h = IMG_H;
+    img->data_size = lv_img_buf_get_img_size(IMG_W, IMG_H, cf);
+    img->data = img_data;
+
+    uint32_t i;
+    for(i = 0; i < img->data_size; i++) {
+        seed = seed * 1103515245 + 12345;
+        img_data[i] = seed >> 24;
+    }
+}
+
+/**
+ * Write an image into `IMG_FILE` in the format of the built-in decoder
+ * @param size number of bytes to write after the header
+ */
+static void write_img(const lv_img_dsc_t * img, uint32_t size)
+{
+    FILE * fp = fopen(IMG_FILE, "wb");
+    if(fp == NULL) return;
+    fwrite(&img->header, sizeof(lv_img_header_t), 1, fp);
+    fwrite(img->data, 1, size, fp);
+    fclose(fp);
+}
+
+#endif /*LV_USE_FILESYSTEM*/
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,191 @@
+/**
+ * @file lv_test_indev.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_indev.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define OBJ_CNT     12
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_INDEV_HIT_INDEX
+static void same_obj(void);
+static void index_update(void);
+static lv_obj_t * create_objs(void);
+static lv_obj_t * search(lv_coord_t x, lv_coord_t y);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_indev(void)
+{
+#if LV_INDEV_HIT_INDEX
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_indev tests");
+    lv_test_print("====================");
+
+    same_obj();
+    index_update();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_INDEV_HIT_INDEX
+
+static void same_obj(void)
+{
+    lv_test_print("");
+    lv_test_print("Find the same objects with and without the index:");
+    lv_test_print("-------------------------------------------------");
+
+    lv_obj_t * cont = create_objs();
+
+    /*The screen is searched with the index, the container recursively*/
+    uint32_t cnt = 0;
+    uint32_t diff_cnt = 0;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = cont->coords.y1; y <= cont->coords.y2; y += 3) {
+        for(x = cont->coords.x1; x <= cont->coords.x2; x += 3) {
+            lv_point_t p = {x, y};
+            lv_obj_t * obj = lv_indev_search_obj(lv_scr_act(), &p);
+            if(obj != lv_indev_search_obj(cont, &p)) diff_cnt++;
+            if(obj != cont) cnt++;
+        }
+    }
+
+    lv_test_assert_int_eq(0, diff_cnt, "Same objects");
+    lv_test_assert_int_gt(0, cnt, "Children of the container are found");
+
+    lv_obj_del(cont);
+}
+
+static void index_update(void)
+{
+    lv_test_print("");
+    lv_test_print("Update the index when the objects change:");
+    lv_test_print("-----------------------------------------");
+
+    lv_obj_t * cont = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(cont, 80, 60);
+    lv_obj_t * obj1 = lv_obj_create(cont, NULL);
+    lv_obj_set_size(obj1, 20, 20);
+    lv_obj_t * obj2 = lv_obj_create(cont, NULL);
+    lv_obj_set_size(obj2, 20, 20);
+
+    lv_test_assert_true(search(10, 10) == obj2, "The last created object is on the top");
+
+    lv_obj_move_background(obj2);
+    lv_test_assert_true(search(10, 10) == obj1, "Moved to the background");
+
+    lv_obj_set_pos(obj2, 50, 30);
+    lv_test_assert_true(search(60, 40) == obj2, "Found at the new position");
+
+    lv_obj_set_size(obj2, 5, 5);
+    lv_test_assert_true(search(60, 40) == cont, "Not found out of the new size");
+
+    lv_obj_set_hidden(obj1, true);
+    lv_test_assert_true(search(10, 10) == cont, "Hidden object");
+    lv_obj_set_hidden(obj1, false);
+
+    lv_obj_set_click(obj1, false);
+    lv_test_assert_true(search(10, 10) == cont, "Not clickable object");
+    lv_obj_set_click(obj1, true);
+
+    lv_obj_add_state(obj1, LV_STATE_DISABLED);
+    lv_test_assert_true(search(10, 10) == cont, "Disabled object");
+    lv_obj_clear_state(obj1, LV_STATE_DISABLED);
+    lv_test_assert_true(search(10, 10) == obj1, "Enabled again");
+
+    lv_obj_del(obj1);
+    lv_test_assert_true(search(10, 10) == cont, "Deleted object");
+
+    lv_obj_set_parent(obj2, lv_scr_act());
+    lv_obj_set_pos(obj2, 100, 10);
+    lv_test_assert_true(search(102, 12) == obj2, "New parent");
+
+    /*Both the old and the new screen's index has to be updated*/
+    lv_point_t p = {102, 12};
+    lv_test_assert_true(lv_indev_search_obj(lv_layer_top(), &p) == NULL, "Not on the top layer");
+    lv_obj_set_parent(obj2, lv_layer_top());
+    lv_test_assert_true(search(102, 12) == lv_scr_act(), "Removed from the old screen");
+    lv_test_assert_true(lv_indev_search_obj(lv_layer_top(), &p) == obj2, "Found on the new screen");
+
+    lv_obj_del(obj2);
+    lv_obj_del(cont);
+}
+
+/**
+ * Create a container on the whole screen with overlapping, nested, hidden,
+ * disabled, not clickable and advanced hit-testing children
+ * @return the container
+ */
+static lv_obj_t * create_objs(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(cont, lv_obj_get_width(lv_scr_act()), lv_obj_get_height(lv_scr_act()));
+
+    lv_coord_t w = lv_obj_get_width(cont) / 4;
+    lv_coord_t h = lv_obj_get_height(cont) / 3;
+    uint32_t i;
+    for(i = 0; i < OBJ_CNT; i++) {
+        lv_obj_t * obj = lv_obj_create(cont, NULL);
+        lv_obj_set_size(obj, w + (i % 3) * 7, h - (i % 2) * 9);
+        lv_obj_set_pos(obj, (i % 4) * w - 5, (i / 4) * h + (i % 3) * 4);
+        lv_obj_set_ext_click_area(obj, 3, 3, 3, 3);
+
+        /*A smaller child partially out of its parent*/
+        lv_obj_t * child = lv_obj_create(obj, NULL);
+        lv_obj_set_size(child, w / 2, h / 2);
+        lv_obj_set_pos(child, w / 2 + 2, -5);
+
+        if(i % 5 == 1) lv_obj_set_hidden(obj, true);
+        if(i % 5 == 2) lv_obj_set_click(obj, false);
+        if(i % 5 == 3) lv_obj_add_state(obj, LV_STATE_DISABLED);
+        if(i % 5 == 4) lv_obj_set_adv_hittest(child, true);
+    }
+
+    return cont;
+}
+
+/**
+ * Search the object on a point of the active screen
+ */
+static lv_obj_t * search(lv_coord_t x, lv_coord_t y)
+{
+    lv_point_t p = {x, y};
+    return lv_indev_search_obj(lv_scr_act(), &p);
+}
+
+#endif /*LV_INDEV_HIT_INDEX*/
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,177 @@
+/**
+ * @file lv_test_mem.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_mem.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ALLOC_CNT   16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void alloc_free(void);
+static void realloc_keep_content(void);
+static void pool_alloc_free(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_mem(void)
+{
+    lv_test_print("");
+    lv_test_print("==================");
+    lv_test_print("Start lv_mem tests");
+    lv_test_print("==================");
+
+    alloc_free();
+    realloc_keep_content();
+    pool_alloc_free();
+}
+
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void alloc_free(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocate and free memories:");
+    lv_test_print("---------------------------");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_test_print("Allocate memories with different sizes");
+    void * p[ALLOC_CNT];
+    uint32_t i;
+    for(i = 0; i < ALLOC_CNT; i++) {
+        p[i] = lv_mem_alloc(i * 7 + 1);
+        lv_test_assert_true(p[i] != NULL, "Allocated memory");
+        lv_test_assert_int_gt(i * 7, _lv_mem_get_size(p[i]), "Size of the allocated memory");
+    }
+
+    lv_test_assert_int_eq(0, _lv_mem_get_size(lv_mem_alloc(0)), "Size of a 0 byte allocation");
+
+    lv_test_print("Free every second memory, then the others");
+    for(i = 0; i < ALLOC_CNT; i += 2) lv_mem_free(p[i]);
+    for(i = 1; i < ALLOC_CNT; i += 2) lv_mem_free(p[i]);
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing every memory");
+    lv_test_assert_int_eq(mon_start.free_biggest_size, mon_end.free_biggest_size,
+                          "Biggest free size after freeing every memory");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity");
+}
+
+static void realloc_keep_content(void)
+{
+    lv_test_print("");
+    lv_test_print("Reallocate a memory:");
+    lv_test_print("--------------------");
+
+    uint8_t * p = lv_mem_alloc(16);
+    uint32_t i;
+    for(i = 0; i < 16; i++) p[i] = i;
+
+    lv_test_print("Grow the memory");
+    p = lv_mem_realloc(p, 200);
+    lv_test_assert_true(p != NULL, "Reallocated memory");
+    lv_test_assert_int_gt(199, _lv_mem_get_size(p), "Size of the grown memory");
+    for(i = 0; i < 16; i++) {
+        if(p[i] != i) break;
+    }
+    lv_test_assert_int_eq(16, i, "Content of the grown memory");
+
+    lv_test_print("Shrink the memory");
+    p = lv_mem_realloc(p, 8);
+    for(i = 0; i < 8; i++) {
+        if(p[i] != i) break;
+    }
+    lv_test_assert_int_eq(8, i, "Content of the shrunk memory");
+
+    lv_mem_free(p);
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity");
+}
+
+static void pool_alloc_free(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocate from a memory pool:");
+    lv_test_print("----------------------------");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_mem_pool_t pool;
+    _lv_mem_pool_init(&pool, 10, 4);
+
+    lv_test_print("Allocate blocks for 3 slabs");
+    uint8_t * p[ALLOC_CNT / 2 + 2];
+    uint32_t i;
+    for(i = 0; i < ALLOC_CNT / 2 + 2; i++) {
+        p[i] = _lv_mem_pool_alloc(&pool);
+        lv_test_assert_true(p[i] != NULL, "Allocated block");
+        _lv_memset(p[i], i, 10);
+    }
+
+    for(i = 0; i < ALLOC_CNT / 2 + 2; i++) {
+        if(p[i][0] != i || p[i][9] != i) break;
+    }
+    lv_test_assert_int_eq(ALLOC_CNT / 2 + 2, i, "Content of the blocks");
+
+    lv_mem_pool_t other_pool;
+    _lv_mem_pool_init(&other_pool, 10, 4);
+    uint8_t * other = _lv_mem_pool_alloc(&other_pool);
+    lv_test_assert_true(_lv_mem_pool_owns(&pool, p[5]), "Block is in the pool");
+    lv_test_assert_true(!_lv_mem_pool_owns(&pool, other), "Block of an other pool is not in the pool");
+    lv_test_assert_int_eq(LV_RES_INV, _lv_mem_pool_free(&pool, other), "Free a block of an other pool");
+    _lv_mem_pool_free(&other_pool, other);
+    _lv_mem_pool_trim(&other_pool);
+
+    lv_test_print("Free and allocate a block again");
+    _lv_mem_pool_free(&pool, p[1]);
+    lv_test_assert_ptr_eq(p[1], _lv_mem_pool_alloc(&pool), "Reuse the freed block");
+
+    lv_test_print("Free all blocks and the slabs");
+    for(i = 0; i < ALLOC_CNT / 2 + 2; i++) {
+        lv_test_assert_int_eq(LV_RES_OK, _lv_mem_pool_free(&pool, p[i]), "Free block");
+    }
+    _lv_mem_pool_trim(&pool);
+    lv_test_assert_true(pool.slab == NULL, "No slabs after trim");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing the pool");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity");
+}
+#endif
@@ -24,6 +24,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_delete_change_parent(void);
+static void create_delete_screen(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -45,6 +46,7 @@ void lv_test_obj(void)
     lv_test_print("==================");
 
     create_delete_change_parent();
+    create_delete_screen();
 }
 
 
@@ -87,4 +89,33 @@ static void create_delete_change_parent(void)
     lv_obj_del(obj_parent);
     lv_test_assert_int_eq(0, lv_obj_count_children(lv_scr_act()), "Screen's children count after delete");
 }
+
+static void create_delete_screen(void)
+{
+    lv_test_print("");
+    lv_test_print("Create and delete a screen with widgets:");
+    lv_test_print("----------------------------------------");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_test_print("Create a screen with buttons and labels");
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_t * btn = lv_btn_create(scr, NULL);
+        lv_label_create(btn, NULL);
+    }
+    lv_test_assert_int_eq(5, lv_obj_count_children(scr), "Screen's children count after creation");
+
+    lv_test_print("Delete the screen");
+    lv_obj_del(scr);
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after deleting the screen");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity");
+}
 #endif
@@ -0,0 +1,175 @@
+/**
+ * @file lv_test_prof.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_prof.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_PROF
+static void frame_stat(void);
+static void chrome_trace(void);
+static void trace_write_cb(void * user_data, const char * buf, uint32_t len);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_PROF
+static char trace_buf[128 * 1024];
+static uint32_t trace_len;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_prof(void)
+{
+#if LV_USE_PROF
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_prof tests");
+    lv_test_print("====================");
+
+    frame_stat();
+    chrome_trace();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_PROF
+
+static void frame_stat(void)
+{
+    lv_test_print("");
+    lv_test_print("Measure the stages of a frame:");
+    lv_test_print("------------------------------");
+
+    lv_obj_t * btn = lv_btn_create(lv_scr_act(), NULL);
+    lv_obj_t * label = lv_label_create(btn, NULL);
+    lv_label_set_text(label, "Profile");
+    lv_refr_now(NULL);
+
+    lv_prof_reset();
+    lv_test_assert_int_eq(0, lv_prof_get_frame_cnt(), "No frames after reset");
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_test_assert_int_eq(1, lv_prof_get_frame_cnt(), "One frame after refresh");
+
+    lv_prof_frame_t frame;
+    lv_test_assert_true(lv_prof_get_frame(0, &frame), "Get the latest frame");
+    lv_test_assert_true(lv_prof_get_frame(1, &frame) == false, "No second frame");
+
+    lv_test_assert_int_eq(1, frame.stages[LV_PROF_STAGE_REFR].cnt, "One refresh in the frame");
+    lv_test_assert_int_gt(0, frame.stages[LV_PROF_STAGE_AREA].cnt, "Areas are drawn");
+    lv_test_assert_int_gt(2, frame.stages[LV_PROF_STAGE_DESIGN].cnt, "Screen, button and label are designed");
+    lv_test_assert_int_gt(0, frame.stages[LV_PROF_STAGE_DRAW_RECT].cnt, "Rectangles are drawn");
+    lv_test_assert_int_gt(0, frame.stages[LV_PROF_STAGE_DRAW_LABEL].cnt, "Labels are drawn");
+    lv_test_assert_int_gt(0, frame.stages[LV_PROF_STAGE_BLEND_FILL].cnt, "Areas are filled");
+    lv_test_assert_true(frame.stages[LV_PROF_STAGE_DESIGN].self_time <= frame.stages[LV_PROF_STAGE_DESIGN].time,
+                        "Self time is not larger than the total time");
+    lv_test_assert_true(frame.stages[LV_PROF_STAGE_AREA].time <= frame.time, "Areas are part of the frame");
+
+    lv_test_print("Nothing is recorded if disabled");
+    lv_prof_set_enabled(false);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_prof_set_enabled(true);
+    lv_test_assert_int_eq(1, lv_prof_get_frame_cnt(), "No new frame while disabled");
+
+    lv_obj_del(btn);
+}
+
+static void chrome_trace(void)
+{
+    lv_test_print("");
+    lv_test_print("Export the events as Chrome trace:");
+    lv_test_print("----------------------------------");
+
+    lv_obj_t * btn = lv_btn_create(lv_scr_act(), NULL);
+    lv_refr_now(NULL);
+
+    /*Keep only the large stages*/
+    lv_prof_set_event_filter((1 << LV_PROF_STAGE_REFR) | (1 << LV_PROF_STAGE_DESIGN));
+    lv_prof_reset();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_prof_set_event_filter(0xFFFFFFFF);
+
+    uint32_t event_cnt = lv_prof_get_event_cnt();
+    lv_test_assert_int_gt(1, event_cnt, "Frame and design events are recorded");
+
+    bool btn_found = false;
+    bool only_filtered = true;
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_prof_event_t e;
+        lv_prof_get_event(i, &e);
+        if(e.stage != LV_PROF_STAGE_REFR && e.stage != LV_PROF_STAGE_DESIGN) only_filtered = false;
+        if(e.stage == LV_PROF_STAGE_DESIGN && e.name && strcmp(e.name, "lv_btn") == 0) btn_found = true;
+    }
+    lv_test_assert_true(only_filtered, "Only the filtered stages are stored");
+    lv_test_assert_true(btn_found, "The button's design event has the widget type as name");
+
+    lv_prof_event_t last;
+    lv_prof_get_event(event_cnt - 1, &last);
+    lv_test_assert_int_eq(LV_PROF_STAGE_REFR, last.stage, "The frame ends last");
+    lv_test_assert_int_eq(0, last.depth, "The frame is not enclosed by other events");
+
+    trace_len = 0;
+    uint32_t written = lv_prof_export_chrome_trace(trace_write_cb, NULL);
+    trace_buf[trace_len] = '\0';
+    lv_test_assert_int_eq(event_cnt, written, "All events are exported");
+    lv_test_assert_true(strncmp(trace_buf, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 39) == 0, "Trace header");
+    lv_test_assert_str_eq("]}\n", &trace_buf[trace_len - 3], "Trace footer");
+    lv_test_assert_true(strstr(trace_buf, "{\"name\":\"lv_btn\",\"cat\":\"design\",\"ph\":\"X\"") != NULL,
+                        "The button's event is exported");
+
+    uint32_t x_cnt = 0;
+    const char * p = trace_buf;
+    while((p = strstr(p, "\"ph\":\"X\"")) != NULL) {
+        x_cnt++;
+        p++;
+    }
+    lv_test_assert_int_eq(event_cnt, x_cnt, "Every event is a complete event");
+
+    lv_obj_del(btn);
+}
+
+static void trace_write_cb(void * user_data, const char * buf, uint32_t len)
+{
+    LV_UNUSED(user_data);
+    if(trace_len + len >= sizeof(trace_buf)) return;
+    memcpy(&trace_buf[trace_len], buf, len);
+    trace_len += len;
+}
+
+#endif /*LV_USE_PROF*/
+#endif /*LV_BUILD_TEST*/
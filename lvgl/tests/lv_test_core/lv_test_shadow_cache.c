@@ -0,0 +1,193 @@
+/**
+ * @file lv_test_shadow_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_shadow_cache.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CANVAS_W    120
+#define CANVAS_H    100
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE && LV_USE_CANVAS
+static void hit_miss_evict(void);
+static void same_shadow(void);
+static void draw_shadow(lv_obj_t * canvas, lv_coord_t w, lv_coord_t h, lv_coord_t sw, lv_coord_t spread,
+                        lv_coord_t radius);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE && LV_USE_CANVAS
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_H];
+static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_shadow_cache(void)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE && LV_USE_CANVAS
+    lv_test_print("");
+    lv_test_print("===========================");
+    lv_test_print("Start lv_shadow_cache tests");
+    lv_test_print("===========================");
+
+    hit_miss_evict();
+    same_shadow();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE && LV_USE_CANVAS
+
+static void hit_miss_evict(void)
+{
+    lv_test_print("");
+    lv_test_print("Hit, miss and evict shadows in the cache:");
+    lv_test_print("-----------------------------------------");
+
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+
+    lv_draw_shadow_cache_clear();
+    lv_draw_shadow_cache_reset_stat();
+
+    lv_draw_shadow_cache_stat_t stat;
+    lv_test_print("Draw the same shadow on rectangles of different size");
+    draw_shadow(canvas, 50, 40, 10, 0, 4);
+    draw_shadow(canvas, 60, 45, 10, 0, 4);
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.miss_cnt, "Miss count");
+    lv_test_assert_int_eq(1, stat.hit_cnt, "Hit count");
+    lv_test_assert_int_eq(1, stat.shadow_cnt, "Cached shadows");
+    lv_test_assert_int_eq((10 + 4) * (10 + 4), stat.size, "Size of the cached shadows");
+
+    lv_test_print("Draw more different shadows than the number of entries");
+    lv_coord_t r;
+    for(r = 0; r <= LV_SHADOW_CACHE_CNT; r++) draw_shadow(canvas, 50, 40, 10, 0, r);
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_eq(LV_SHADOW_CACHE_CNT, stat.shadow_cnt, "Cached shadows");
+    lv_test_assert_int_gt(0, stat.evict_cnt, "Evict count");
+
+    lv_test_print("The least recently used shadow was evicted");
+    lv_draw_shadow_cache_reset_stat();
+    draw_shadow(canvas, 50, 40, 10, 0, LV_SHADOW_CACHE_CNT);
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.hit_cnt, "Hit count of the recently used shadow");
+    draw_shadow(canvas, 50, 40, 10, 0, 0);
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.miss_cnt, "Miss count of the evicted shadow");
+
+    lv_test_print("Too large shadows are not cached");
+    lv_draw_shadow_cache_clear();
+    draw_shadow(canvas, 100, 80, LV_SHADOW_CACHE_SIZE, 0, 1);
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.shadow_cnt, "Cached shadows");
+
+#if LV_SHADOW_CACHE_MAX_BYTES
+    lv_test_print("Keep the memory limit");
+    for(r = 0; r <= LV_SHADOW_CACHE_CNT; r++) draw_shadow(canvas, 100, 80, LV_SHADOW_CACHE_SIZE - 20, 0, r);
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_true(stat.size <= LV_SHADOW_CACHE_MAX_BYTES, "Size of the cached shadows");
+    lv_test_assert_int_gt(0, stat.shadow_cnt, "Cached shadows");
+#endif
+
+    lv_draw_shadow_cache_clear();
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.size, "Size after clear");
+
+    lv_obj_del(canvas);
+}
+
+static void same_shadow(void)
+{
+    lv_test_print("");
+    lv_test_print("Cached shadows look the same as the calculated ones:");
+    lv_test_print("----------------------------------------------------");
+
+    static const lv_coord_t sizes[][2] = {{110, 90}, {90, 70}, {60, 40}, {40, 60}, {33, 33}, {20, 20}, {12, 40}, {5, 5}};
+    static const lv_coord_t params[][3] = {{10, 0, 6}, {10, 4, 6}, {15, 0, LV_RADIUS_CIRCLE}, {5, 2, 0}};
+
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+
+    lv_draw_shadow_cache_clear();
+    lv_draw_shadow_cache_reset_stat();
+
+    bool same = true;
+    uint32_t p;
+    uint32_t s;
+    for(p = 0; p < sizeof(params) / sizeof(params[0]); p++) {
+        for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            /*Calculate the shadow without the cache...*/
+            lv_draw_shadow_cache_clear();
+            draw_shadow(canvas, sizes[s][0], sizes[s][1], params[p][0], params[p][1], params[p][2]);
+            memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+
+            /*...and get it from the cache filled by a larger rectangle*/
+            lv_draw_shadow_cache_clear();
+            draw_shadow(canvas, sizes[0][0], sizes[0][1], params[p][0], params[p][1], params[p][2]);
+            draw_shadow(canvas, sizes[s][0], sizes[s][1], params[p][0], params[p][1], params[p][2]);
+            if(memcmp(ref_buf, canvas_buf, sizeof(canvas_buf))) same = false;
+        }
+    }
+
+    lv_draw_shadow_cache_stat_t stat;
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_gt(0, stat.hit_cnt, "Shadows are found in the cache");
+    lv_test_assert_true(same, "Same pixels");
+
+    lv_draw_shadow_cache_clear();
+    lv_obj_del(canvas);
+}
+
+/**
+ * Clear the canvas and draw a rectangle with shadow in its middle
+ */
+static void draw_shadow(lv_obj_t * canvas, lv_coord_t w, lv_coord_t h, lv_coord_t sw, lv_coord_t spread,
+                        lv_coord_t radius)
+{
+    lv_canvas_fill_bg(canvas, LV_COLOR_WHITE, LV_OPA_COVER);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.radius = radius;
+    dsc.bg_color = LV_COLOR_BLUE;
+    dsc.shadow_color = LV_COLOR_RED;
+    dsc.shadow_width = sw;
+    dsc.shadow_spread = spread;
+    dsc.shadow_ofs_x = 3;
+    dsc.shadow_ofs_y = 2;
+    lv_canvas_draw_rect(canvas, (CANVAS_W - w) / 2, (CANVAS_H - h) / 2, w, h, &dsc);
+}
+
+#endif
+#endif /*LV_BUILD_TEST*/
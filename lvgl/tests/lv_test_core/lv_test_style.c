@@ -29,6 +29,7 @@ static void cascade(void);
 static void copy(void);
 static void states(void);
 static void mem_leak(void);
+static void obj_resolve(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -55,6 +56,7 @@ void lv_test_style(void)
     copy();
     states();
     mem_leak();
+    obj_resolve();
 }
 
 
@@ -634,4 +636,49 @@ static void mem_leak(void)
     lv_mem_monitor(&mon_end);
     lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
 }
+
+static void obj_resolve(void)
+{
+    lv_test_print("");
+    lv_test_print("Get the properties of objects after changes:");
+    lv_test_print("--------------------------------------------");
+
+    lv_obj_t * parent1 = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_t * obj = lv_obj_create(parent1, NULL);
+    lv_obj_reset_style_list(obj, LV_OBJ_PART_MAIN);     /*Remove the theme's styles*/
+
+    lv_obj_set_style_local_text_color(parent1, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+    lv_obj_set_style_local_text_color(parent2, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_LIME);
+    lv_obj_set_style_local_pad_left(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 3);
+    lv_obj_set_style_local_pad_left(obj, LV_OBJ_PART_MAIN, LV_STATE_PRESSED, 7);
+
+    lv_test_print("Get the same properties twice");
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_obj_get_style_text_color(obj, LV_OBJ_PART_MAIN), "Inherited 'color' property");
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_obj_get_style_text_color(obj, LV_OBJ_PART_MAIN), "Inherited 'color' property again");
+    lv_test_assert_int_eq(3, lv_obj_get_style_pad_left(obj, LV_OBJ_PART_MAIN), "'int' property");
+    lv_test_assert_int_eq(3, lv_obj_get_style_pad_left(obj, LV_OBJ_PART_MAIN), "'int' property again");
+
+    lv_test_print("Change the parent's local style");
+    lv_obj_set_style_local_text_color(parent1, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLUE);
+    lv_test_assert_color_eq(LV_COLOR_BLUE, lv_obj_get_style_text_color(obj, LV_OBJ_PART_MAIN), "Inherited 'color' property after parent's change");
+
+    lv_test_print("Change the state");
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    lv_test_assert_int_eq(7, lv_obj_get_style_pad_left(obj, LV_OBJ_PART_MAIN), "'int' property in pressed state");
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    lv_test_assert_int_eq(3, lv_obj_get_style_pad_left(obj, LV_OBJ_PART_MAIN), "'int' property in default state again");
+
+    lv_test_print("Change the parent");
+    lv_obj_set_parent(obj, parent2);
+    lv_test_assert_color_eq(LV_COLOR_LIME, lv_obj_get_style_text_color(obj, LV_OBJ_PART_MAIN), "Inherited 'color' property from the new parent");
+
+    lv_test_print("Remove a local property");
+    lv_obj_remove_style_local_prop(obj, LV_OBJ_PART_MAIN, LV_STYLE_PAD_LEFT);
+    lv_test_assert_int_eq(0, lv_obj_get_style_pad_left(obj, LV_OBJ_PART_MAIN), "Removed 'int' property");
+
+    lv_obj_del(parent1);
+    lv_obj_del(parent2);
+}
+
 #endif
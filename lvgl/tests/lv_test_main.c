@@ -3,9 +3,13 @@
 #include <stdlib.h>
 #include "lv_test_core/lv_test_core.h"
 #include "lv_test_widgets/lv_test_label.h"
+#include "lv_test_widgets/lv_test_canvas.h"
+#include "lv_test_widgets/lv_test_cont.h"
+#include "lv_test_widgets/lv_test_linemeter.h"
 
 #if LV_BUILD_TEST
 #include <sys/time.h>
+#include <sys/mman.h>
 
 static void hal_init(void);
 static void dummy_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
@@ -21,6 +25,9 @@ int main(void)
 
     lv_test_core();
     lv_test_label();
+    lv_test_canvas();
+    lv_test_cont();
+    lv_test_linemeter();
 
     printf("Exit with success!\n");
     return 0;
@@ -82,6 +89,32 @@ static bool ready_cb(struct _lv_fs_drv_t * drv)
     (void) drv;
     return true;
 }
+
+static lv_fs_res_t map_cb(struct _lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p)
+{
+    (void) drv;
+
+    FILE * fp = *((FILE **) file_p);
+    if(fseek(fp, 0, SEEK_END) != 0) return LV_FS_RES_UNKNOWN;
+    long size = ftell(fp);
+    if(size <= 0) return LV_FS_RES_UNKNOWN;
+
+    void * data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+    if(data == MAP_FAILED) return LV_FS_RES_UNKNOWN;
+
+    *data_p = data;
+    *size_p = size;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t unmap_cb(struct _lv_fs_drv_t * drv, void * file_p, const void * data, uint32_t size)
+{
+    (void) drv;
+    (void) file_p;
+
+    munmap((void *)data, size);
+    return LV_FS_RES_OK;
+}
 #endif
 
 static void hal_init(void)
@@ -111,6 +144,12 @@ static void hal_init(void)
     drv.tell_cb = tell_cb;                 /*Callback to tell the cursor position  */
 
     lv_fs_drv_register(&drv);                 /*Finally register the drive*/
+
+    /*The same files on a drive which can map them into the memory*/
+    drv.letter = 'm';
+    drv.map_cb = map_cb;
+    drv.unmap_cb = unmap_cb;
+    lv_fs_drv_register(&drv);
 #endif
 }
 #include <stdio.h>
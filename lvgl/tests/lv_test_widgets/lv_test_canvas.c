@@ -0,0 +1,290 @@
+/**
+ * @file lv_test_canvas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_canvas.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CANVAS_W    40
+#define CANVAS_H    30
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_CANVAS
+static void blur_box(void);
+static void blur_gauss(void);
+static void fill_random(lv_obj_t * canvas, uint32_t seed);
+static void ref_blur(lv_img_dsc_t * dsc, const lv_area_t * area, uint16_t r, bool hor);
+static uint8_t ref_get_ch(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, uint8_t ch);
+static bool img_eq(lv_img_dsc_t * d1, lv_img_dsc_t * d2);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_CANVAS
+static uint8_t canvas_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(CANVAS_W, CANVAS_H)];
+static uint8_t ref_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(CANVAS_W, CANVAS_H)];
+static uint8_t orig_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(CANVAS_W, CANVAS_H)];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_canvas(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_canvas tests");
+    lv_test_print("====================");
+
+#if LV_USE_CANVAS
+    blur_box();
+    blur_gauss();
+#else
+    lv_test_print("Skip canvas test: LV_USE_CANVAS == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_CANVAS
+
+static void blur_box(void)
+{
+    lv_test_print("");
+    lv_test_print("Blur like the pixel by pixel reference:");
+    lv_test_print("---------------------------------------");
+
+    static const lv_img_cf_t cfs[] = {LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_TRUE_COLOR_ALPHA};
+    static const uint16_t rs[] = {2, 3, 8, 45};
+    static const lv_area_t areas[] = {{5, 4, 30, 20}, {-10, 20, 15, 50}, {0, 0, CANVAS_W - 1, 0}};
+
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+
+    bool hor_ok = true;
+    bool ver_ok = true;
+    uint32_t seed = 1;
+    uint32_t c;
+    uint32_t r;
+    uint32_t a;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, cfs[c]);
+        lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+        lv_img_dsc_t ref_dsc = *dsc;
+        ref_dsc.data = ref_buf;
+
+        for(r = 0; r < sizeof(rs) / sizeof(rs[0]); r++) {
+            /*The last round blurs the whole canvas*/
+            for(a = 0; a <= sizeof(areas) / sizeof(areas[0]); a++) {
+                const lv_area_t * area = a < sizeof(areas) / sizeof(areas[0]) ? &areas[a] : NULL;
+
+                fill_random(canvas, seed++);
+                memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+                lv_canvas_blur_hor(canvas, area, rs[r]);
+                ref_blur(&ref_dsc, area, rs[r], true);
+                if(!img_eq(dsc, &ref_dsc)) hor_ok = false;
+
+                fill_random(canvas, seed++);
+                memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+                lv_canvas_blur_ver(canvas, area, rs[r]);
+                ref_blur(&ref_dsc, area, rs[r], false);
+                if(!img_eq(dsc, &ref_dsc)) ver_ok = false;
+            }
+        }
+    }
+
+    lv_test_assert_true(hor_ok, "Horizontal blur");
+    lv_test_assert_true(ver_ok, "Vertical blur");
+
+    lv_obj_del(canvas);
+}
+
+static void blur_gauss(void)
+{
+    lv_test_print("");
+    lv_test_print("Blur in multiple passes:");
+    lv_test_print("------------------------");
+
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    lv_img_dsc_t ref_dsc = *dsc;
+    ref_dsc.data = ref_buf;
+
+    lv_test_print("One pass is the same as the horizontal and vertical blur");
+    fill_random(canvas, 100);
+    memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+    lv_canvas_blur(canvas, NULL, 7, 1);
+    ref_blur(&ref_dsc, NULL, 7, true);
+    ref_blur(&ref_dsc, NULL, 7, false);
+    lv_test_assert_true(img_eq(dsc, &ref_dsc), "Blurred with one pass");
+
+    lv_test_print("A single color remains the same");
+    lv_color_t color = lv_color_make(0x20, 0x80, 0xC0);
+    lv_canvas_fill_bg(canvas, color, LV_OPA_70);
+    memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+    lv_canvas_blur(canvas, NULL, 20, 3);
+    lv_test_assert_true(img_eq(dsc, &ref_dsc), "Single color after 3 passes");
+
+    lv_test_print("The blurred edge is monotonic");
+    lv_canvas_fill_bg(canvas, LV_COLOR_BLACK, LV_OPA_COVER);
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < CANVAS_H; y++) {
+        for(x = CANVAS_W / 2; x < CANVAS_W; x++) lv_canvas_set_px(canvas, x, y, LV_COLOR_WHITE);
+    }
+    lv_canvas_blur(canvas, NULL, 15, 3);
+
+    bool monotonic = true;
+    uint8_t prev = 0;
+    for(x = 0; x < CANVAS_W; x++) {
+        uint8_t act = ref_get_ch(dsc, x, CANVAS_H / 2, 0);
+        if(act < prev) monotonic = false;
+        prev = act;
+    }
+    lv_test_assert_true(monotonic, "Brightness along the edge");
+    lv_test_assert_true(ref_get_ch(dsc, 0, 0, 0) < ref_get_ch(dsc, CANVAS_W - 1, 0, 0), "Dark and light side");
+
+    lv_obj_del(canvas);
+}
+
+/**
+ * Fill the canvas with random colors and opacities
+ */
+static void fill_random(lv_obj_t * canvas, uint32_t seed)
+{
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    bool has_alpha = lv_img_cf_has_alpha(dsc->header.cf);
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < dsc->header.h; y++) {
+        for(x = 0; x < dsc->header.w; x++) {
+            seed = seed * 1103515245 + 12345;
+            lv_img_buf_set_px_color(dsc, x, y, lv_color_make(seed >> 24, seed >> 16, seed >> 8));
+            if(has_alpha) {
+                seed = seed * 1103515245 + 12345;
+                lv_opa_t opa = seed >> 24;
+                /*Have fully transparent and opaque pixels too*/
+                if(opa < 0x20) opa = LV_OPA_TRANSP;
+                else if(opa > 0xE0) opa = LV_OPA_COVER;
+                lv_img_buf_set_px_alpha(dsc, x, y, opa);
+            }
+        }
+    }
+}
+
+/**
+ * Blur an image by averaging the pixels of the box around each pixel
+ */
+static void ref_blur(lv_img_dsc_t * dsc, const lv_area_t * area, uint16_t r, bool hor)
+{
+    memcpy(orig_buf, dsc->data, sizeof(orig_buf));
+    lv_img_dsc_t orig = *dsc;
+    orig.data = orig_buf;
+
+    lv_area_t a;
+    lv_area_t canvas_area = {0, 0, dsc->header.w - 1, dsc->header.h - 1};
+    if(area == NULL) a = canvas_area;
+    else if(!_lv_area_intersect(&a, area, &canvas_area)) return;
+
+    int32_t r_back = r / 2;
+    int32_t r_front = r / 2;
+    if((r & 0x1) == 0) r_back--;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        for(x = a.x1; x <= a.x2; x++) {
+            uint32_t sum[4] = {0};
+            int32_t i;
+            for(i = -r_back; i <= r_front; i++) {
+                lv_coord_t xs = hor ? LV_MATH_MIN(LV_MATH_MAX(x + i, 0), dsc->header.w - 1) : x;
+                lv_coord_t ys = hor ? y : LV_MATH_MIN(LV_MATH_MAX(y + i, 0), dsc->header.h - 1);
+                uint8_t ch;
+                for(ch = 0; ch < 4; ch++) sum[ch] += ref_get_ch(&orig, xs, ys, ch);
+            }
+
+            lv_color_t c = lv_img_buf_get_px_color(dsc, x, y, LV_COLOR_BLACK);
+            c.ch.red = sum[0] / r;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            c.ch.green_h = (sum[1] / r) >> 3;
+            c.ch.green_l = (sum[1] / r) & 0x7;
+#else
+            c.ch.green = sum[1] / r;
+#endif
+            c.ch.blue = sum[2] / r;
+            lv_img_buf_set_px_color(dsc, x, y, c);
+            if(lv_img_cf_has_alpha(dsc->header.cf)) lv_img_buf_set_px_alpha(dsc, x, y, sum[3] / r);
+        }
+    }
+}
+
+/**
+ * Get a channel of a pixel
+ * @param ch 0: red, 1: green, 2: blue, 3: alpha
+ */
+static uint8_t ref_get_ch(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, uint8_t ch)
+{
+    lv_color_t c = lv_img_buf_get_px_color(dsc, x, y, LV_COLOR_BLACK);
+    switch(ch) {
+        case 0:
+            return c.ch.red;
+        case 1:
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+            return (c.ch.green_h << 3) + c.ch.green_l;
+#else
+            return c.ch.green;
+#endif
+        case 2:
+            return c.ch.blue;
+        default:
+            return lv_img_cf_has_alpha(dsc->header.cf) ? lv_img_buf_get_px_alpha(dsc, x, y) : LV_OPA_COVER;
+    }
+}
+
+/**
+ * Compare the colors and opacities of two images
+ */
+static bool img_eq(lv_img_dsc_t * d1, lv_img_dsc_t * d2)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < d1->header.h; y++) {
+        for(x = 0; x < d1->header.w; x++) {
+            uint8_t ch;
+            for(ch = 0; ch < 4; ch++) {
+                if(ref_get_ch(d1, x, y, ch) != ref_get_ch(d2, x, y, ch)) return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif /*LV_USE_CANVAS*/
+#endif /*LV_BUILD_TEST*/
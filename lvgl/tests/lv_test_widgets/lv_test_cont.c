@@ -0,0 +1,212 @@
+/**
+ * @file lv_test_cont.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_cont.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CHILD_CNT   8
+#define COORD_CNT   (1 + CHILD_CNT + 1 + 3)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_CONT
+static void same_layout(void);
+static void deferred_layout(void);
+static lv_obj_t * create_cont(lv_layout_t layout, bool flush_each);
+static uint32_t get_coords(lv_obj_t * obj, lv_area_t * coords);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_CONT
+static lv_area_t coords1[COORD_CNT];
+static lv_area_t coords2[COORD_CNT];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_cont(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_cont tests");
+    lv_test_print("===================");
+
+#if LV_USE_CONT
+    same_layout();
+    deferred_layout();
+#else
+    lv_test_print("Skip cont test: LV_USE_CONT == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_CONT
+
+static void same_layout(void)
+{
+    lv_test_print("");
+    lv_test_print("Refresh the layout after every child or once:");
+    lv_test_print("---------------------------------------------");
+
+    static const lv_layout_t layouts[] = {LV_LAYOUT_CENTER, LV_LAYOUT_COLUMN_MID, LV_LAYOUT_ROW_TOP,
+                                          LV_LAYOUT_PRETTY_MID, LV_LAYOUT_GRID
+                                         };
+
+    bool eq = true;
+    uint32_t i;
+    for(i = 0; i < sizeof(layouts) / sizeof(layouts[0]); i++) {
+        lv_obj_t * cont = create_cont(layouts[i], true);
+        uint32_t cnt1 = get_coords(cont, coords1);
+        lv_obj_del(cont);
+
+        cont = create_cont(layouts[i], false);
+        lv_layout_flush();
+        uint32_t cnt2 = get_coords(cont, coords2);
+        lv_obj_del(cont);
+
+        if(cnt1 != COORD_CNT || cnt2 != COORD_CNT || memcmp(coords1, coords2, sizeof(coords1))) eq = false;
+    }
+
+    lv_test_assert_true(eq, "Same coordinates");
+}
+
+static void deferred_layout(void)
+{
+#if LV_CONT_LAYOUT_DEFER
+    lv_test_print("");
+    lv_test_print("Defer the layout until it's needed:");
+    lv_test_print("-----------------------------------");
+
+    lv_obj_t * cont = lv_cont_create(lv_scr_act(), NULL);
+    lv_cont_set_layout(cont, LV_LAYOUT_COLUMN_LEFT);
+    lv_cont_set_fit(cont, LV_FIT_TIGHT);
+    lv_obj_t * child = lv_obj_create(cont, NULL);
+    lv_obj_set_size(child, 50, 30);
+    lv_layout_flush();
+    lv_coord_t h = lv_obj_get_height(cont);
+
+    lv_test_print("Add children without refreshing the layout");
+    child = lv_obj_create(cont, NULL);
+    lv_obj_set_size(child, 50, 30);
+    lv_test_assert_int_eq(h, lv_obj_get_height(cont), "Height before the refresh");
+    lv_refr_now(NULL);
+    lv_test_assert_int_gt(h, lv_obj_get_height(cont), "Height after the refresh");
+
+    lv_test_print("Align to the refreshed size");
+    h = lv_obj_get_height(cont);
+    child = lv_obj_create(cont, NULL);
+    lv_obj_set_size(child, 50, 30);
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_align(obj, cont, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 0);
+    lv_test_assert_int_gt(h, lv_obj_get_height(cont), "Height after aligning");
+    lv_test_assert_int_eq(cont->coords.y2 + 1, obj->coords.y1, "Aligned below the container");
+    lv_obj_del(obj);
+
+#if LV_USE_LIST
+    lv_test_print("Focus on a button added to a list");
+    lv_obj_t * list = lv_list_create(lv_scr_act(), NULL);
+    lv_obj_set_size(list, 100, 150);
+    lv_obj_t * first_btn = lv_list_add_btn(list, NULL, "Button");
+    lv_obj_t * btn = NULL;
+    uint32_t i;
+    for(i = 1; i < 20; i++) btn = lv_list_add_btn(list, NULL, "Button");
+    lv_list_focus(btn, LV_ANIM_OFF);
+    lv_test_assert_true(btn->coords.y1 >= list->coords.y1 && btn->coords.y2 <= list->coords.y2,
+                        "The button is visible");
+    lv_test_assert_int_lt(list->coords.y1, first_btn->coords.y2, "The first button is scrolled out");
+    lv_obj_del(list);
+#endif
+
+    lv_test_print("Delete a container before its layout is refreshed");
+    child = lv_obj_create(cont, NULL);
+    lv_obj_t * inner = lv_cont_create(cont, NULL);
+    lv_cont_set_fit(inner, LV_FIT_TIGHT);
+    lv_obj_create(inner, NULL);
+    lv_obj_del(cont);
+    lv_layout_flush();
+    lv_test_assert_true(true, "Deleted containers are not refreshed");
+#endif
+}
+
+/**
+ * Create a container with children of different size and a nested container
+ * @param flush_each true: refresh the layout after adding every child
+ */
+static lv_obj_t * create_cont(lv_layout_t layout, bool flush_each)
+{
+    lv_obj_t * cont = lv_cont_create(lv_scr_act(), NULL);
+    lv_obj_set_width(cont, 200);
+    lv_cont_set_layout(cont, layout);
+    lv_cont_set_fit2(cont, LV_FIT_NONE, LV_FIT_TIGHT);
+
+    uint32_t i;
+    for(i = 0; i < CHILD_CNT; i++) {
+        if(i == CHILD_CNT / 2) {
+            lv_obj_t * inner = lv_cont_create(cont, NULL);
+            lv_cont_set_layout(inner, LV_LAYOUT_COLUMN_LEFT);
+            lv_cont_set_fit(inner, LV_FIT_TIGHT);
+            uint32_t j;
+            for(j = 0; j < 3; j++) {
+                lv_obj_t * obj = lv_obj_create(inner, NULL);
+                lv_obj_set_size(obj, 15 + j * 5, 10);
+                if(flush_each) lv_layout_flush();
+            }
+        }
+
+        lv_obj_t * obj = lv_obj_create(cont, NULL);
+        lv_obj_set_size(obj, 10 + (i * 7) % 25, 10 + (i * 3) % 15);
+        if(flush_each) lv_layout_flush();
+    }
+
+    return cont;
+}
+
+/**
+ * Get the coordinates of an object and its descendants
+ * @param coords store the coordinates here, at most `COORD_CNT`
+ * @return number of stored coordinates
+ */
+static uint32_t get_coords(lv_obj_t * obj, lv_area_t * coords)
+{
+    uint32_t cnt = 0;
+    lv_obj_get_coords(obj, &coords[cnt++]);
+
+    lv_obj_t * child = lv_obj_get_child(obj, NULL);
+    while(child && cnt < COORD_CNT) {
+        cnt += get_coords(child, &coords[cnt]);
+        child = lv_obj_get_child(obj, child);
+    }
+
+    return cnt;
+}
+
+#endif /*LV_USE_CONT*/
+#endif /*LV_BUILD_TEST*/
@@ -11,6 +11,7 @@
 #include "lv_test_label.h"
 
 #if LV_BUILD_TEST
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -24,6 +25,10 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_copy(void);
+#if LV_LABEL_LINE_CACHE && LV_USE_CANVAS
+static void line_cache_draw(void);
+static void line_cache_label(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -46,6 +51,10 @@ void lv_test_label(void)
 
 #if LV_USE_LABEL
     create_copy();
+#if LV_LABEL_LINE_CACHE && LV_USE_CANVAS
+    line_cache_draw();
+    line_cache_label();
+#endif
 #else
     lv_test_print("Skip label test: LV_USE_LABEL == 0");
 #endif
@@ -67,4 +76,140 @@ static void create_copy(void)
     lv_test_assert_img_eq("lv_test_img32_label_1.png", "Create a label and leave the default settings");
 #endif
 }
+
+#if LV_LABEL_LINE_CACHE && LV_USE_CANVAS
+
+#define LINE_CACHE_CANVAS_W  100
+#define LINE_CACHE_CANVAS_H  120
+
+static const char * line_cache_txt = "Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n"
+                                     "Sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.\n\n"
+                                     "Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris.";
+
+static void line_cache_draw(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw a text with stored line breaks:");
+    lv_test_print("------------------------------------");
+
+    static lv_color_t buf_ref[LINE_CACHE_CANVAS_W * LINE_CACHE_CANVAS_H];
+    static lv_color_t buf_act[LINE_CACHE_CANVAS_W * LINE_CACHE_CANVAS_H];
+
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+
+    lv_draw_label_lines_t lines;
+    _lv_memset_00(&lines, sizeof(lines));
+    bool ok = _lv_draw_label_lines_build(&lines, line_cache_txt, dsc.font, dsc.letter_space, LINE_CACHE_CANVAS_W,
+                                         LV_TXT_FLAG_NONE);
+    lv_test_assert_true(ok, "Build the lines");
+    lv_test_assert_int_gt(3, lines.line_cnt, "The text is broken into lines");
+    lv_test_assert_int_eq(strlen(line_cache_txt), lines.line_start[lines.line_cnt], "The last line ends at the end");
+
+    /*Start above the canvas too to skip the invisible lines*/
+    lv_coord_t y_start[] = {0, -45};
+    lv_label_align_t aligns[] = {LV_LABEL_ALIGN_LEFT, LV_LABEL_ALIGN_CENTER, LV_LABEL_ALIGN_RIGHT};
+    uint32_t diff_cnt = 0;
+    uint32_t y;
+    uint32_t a;
+    for(y = 0; y < sizeof(y_start) / sizeof(y_start[0]); y++) {
+        for(a = 0; a < sizeof(aligns) / sizeof(aligns[0]); a++) {
+            lv_canvas_set_buffer(canvas, buf_ref, LINE_CACHE_CANVAS_W, LINE_CACHE_CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+            lv_canvas_fill_bg(canvas, LV_COLOR_WHITE, LV_OPA_COVER);
+            dsc.lines = NULL;
+            lv_canvas_draw_text(canvas, 0, y_start[y], LINE_CACHE_CANVAS_W, &dsc, line_cache_txt, aligns[a]);
+
+            lv_canvas_set_buffer(canvas, buf_act, LINE_CACHE_CANVAS_W, LINE_CACHE_CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+            lv_canvas_fill_bg(canvas, LV_COLOR_WHITE, LV_OPA_COVER);
+            dsc.lines = &lines;
+            lv_canvas_draw_text(canvas, 0, y_start[y], LINE_CACHE_CANVAS_W, &dsc, line_cache_txt, aligns[a]);
+
+            if(memcmp(buf_ref, buf_act, sizeof(buf_ref))) diff_cnt++;
+        }
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Same result with and without the stored lines");
+
+    lv_test_print("Stored lines of other texts are not used");
+    const char * other_txt = "Other text";
+    lv_canvas_set_buffer(canvas, buf_ref, LINE_CACHE_CANVAS_W, LINE_CACHE_CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, LV_COLOR_WHITE, LV_OPA_COVER);
+    dsc.lines = NULL;
+    lv_canvas_draw_text(canvas, 0, 0, LINE_CACHE_CANVAS_W, &dsc, other_txt, LV_LABEL_ALIGN_LEFT);
+
+    lv_canvas_set_buffer(canvas, buf_act, LINE_CACHE_CANVAS_W, LINE_CACHE_CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, LV_COLOR_WHITE, LV_OPA_COVER);
+    dsc.lines = &lines;
+    lv_canvas_draw_text(canvas, 0, 0, LINE_CACHE_CANVAS_W, &dsc, other_txt, LV_LABEL_ALIGN_LEFT);
+    lv_test_assert_true(memcmp(buf_ref, buf_act, sizeof(buf_ref)) == 0, "Other text is drawn correctly");
+
+    _lv_draw_label_lines_free(&lines);
+    lv_obj_del(canvas);
+}
+
+static void line_cache_label(void)
+{
+    lv_test_print("");
+    lv_test_print("Use the stored line breaks of a label:");
+    lv_test_print("--------------------------------------");
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, 120);
+    lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
+    lv_label_set_text(label, line_cache_txt);
+
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_test_assert_true(ext->lines.txt == ext->text, "The lines are stored");
+    uint32_t line_cnt = ext->lines.line_cnt;
+    lv_test_assert_int_gt(3, line_cnt, "The text is broken into lines");
+
+    lv_test_print("Letter positions are the same as without the stored lines");
+    uint32_t len = _lv_txt_get_encoded_length(line_cache_txt);
+    uint32_t diff_cnt = 0;
+    uint32_t i;
+    for(i = 0; i <= len; i++) {
+        lv_point_t p_act;
+        lv_point_t p_ref;
+        lv_label_get_letter_pos(label, i, &p_act);
+        ext->lines.txt = NULL;
+        lv_label_get_letter_pos(label, i, &p_ref);
+        ext->lines.txt = ext->text;
+        if(p_act.x != p_ref.x || p_act.y != p_ref.y) diff_cnt++;
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Letter positions");
+
+    lv_test_print("Letters on points are the same as without the stored lines");
+    diff_cnt = 0;
+    lv_point_t p;
+    for(p.y = -5; p.y < lv_obj_get_height(label) + 20; p.y += 7) {
+        for(p.x = -5; p.x < lv_obj_get_width(label) + 5; p.x += 9) {
+            uint32_t id_act = lv_label_get_letter_on(label, &p);
+            bool under_act = lv_label_is_char_under_pos(label, &p);
+            ext->lines.txt = NULL;
+            uint32_t id_ref = lv_label_get_letter_on(label, &p);
+            bool under_ref = lv_label_is_char_under_pos(label, &p);
+            ext->lines.txt = ext->text;
+            if(id_act != id_ref || under_act != under_ref) diff_cnt++;
+        }
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Letters on points");
+
+    lv_test_print("The lines are updated if the width changes");
+    lv_obj_set_width(label, 60);
+    lv_test_assert_true(ext->lines.txt == ext->text, "The lines are stored");
+    lv_test_assert_int_eq(lv_area_get_width(&label->coords), ext->lines.max_w, "The new width is used");
+    lv_test_assert_int_gt(line_cnt, ext->lines.line_cnt, "More lines in narrower label");
+
+    lv_test_print("The lines are updated if the text changes");
+    line_cnt = ext->lines.line_cnt;
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "\nNew line");
+    lv_test_assert_true(ext->lines.txt == ext->text, "The lines are stored");
+    lv_test_assert_int_gt(line_cnt, ext->lines.line_cnt, "New lines are added");
+
+    lv_obj_del(label);
+}
+#endif
+
 #endif
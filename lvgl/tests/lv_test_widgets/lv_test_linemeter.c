@@ -0,0 +1,252 @@
+/**
+ * @file lv_test_linemeter.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_linemeter.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LMETER_CNT  3
+#define GAUGE_BAND_CNT  8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_LINEMETER
+static void value_refr(void);
+static void scale_change(void);
+#if LV_USE_GAUGE
+static void gauge_bands(void);
+#endif
+static void create_lmeters(void);
+static bool refr_same_as_full(void);
+#if LV_LINEMETER_SCALE_CACHE
+static uint32_t get_inv_size(void);
+#endif
+static void screen_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_LINEMETER
+static lv_color_t screen_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+static lv_color_t refr_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+static lv_obj_t * lmeters[LMETER_CNT];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_linemeter(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_linemeter tests");
+    lv_test_print("========================");
+
+#if LV_USE_LINEMETER
+    /*Draw every refreshed area to its place to compare the whole screen*/
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver.flush_cb;
+    disp->driver.flush_cb = screen_flush_cb;
+
+    create_lmeters();
+    value_refr();
+    scale_change();
+
+    uint32_t i;
+    for(i = 0; i < LMETER_CNT; i++) lv_obj_del(lmeters[i]);
+
+#if LV_USE_GAUGE
+    gauge_bands();
+#endif
+    disp->driver.flush_cb = flush_cb_ori;
+#else
+    lv_test_print("Skip linemeter test: LV_USE_LINEMETER == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_LINEMETER
+
+static void value_refr(void)
+{
+    lv_test_print("");
+    lv_test_print("Refresh the line meters on value change:");
+    lv_test_print("----------------------------------------");
+
+    bool same = true;
+    uint32_t i;
+    uint32_t v;
+    for(v = 0; v <= 100; v += 9) {
+        for(i = 0; i < LMETER_CNT; i++) lv_linemeter_set_value(lmeters[i], (v + i * 31) % 101);
+        if(!refr_same_as_full()) same = false;
+    }
+
+    lv_test_assert_true(same, "Same as a full redraw");
+
+#if LV_LINEMETER_SCALE_CACHE
+    lv_linemeter_set_value(lmeters[0], 50);
+    lv_refr_now(NULL);
+    lv_linemeter_set_value(lmeters[0], 60);
+    lv_test_assert_int_lt(lv_area_get_size(&lmeters[0]->coords), get_inv_size(),
+                          "Only the changed lines are invalidated");
+    lv_refr_now(NULL);
+#endif
+}
+
+static void scale_change(void)
+{
+    lv_test_print("");
+    lv_test_print("Refresh the line meters after the scale changes:");
+    lv_test_print("------------------------------------------------");
+
+    lv_obj_set_size(lmeters[0], lv_obj_get_width(lmeters[0]) / 2, lv_obj_get_height(lmeters[0]) / 2);
+    lv_linemeter_set_scale(lmeters[1], 180, 7);
+    lv_linemeter_set_angle_offset(lmeters[2], 45);
+    lv_obj_set_style_local_scale_width(lmeters[2], LV_LINEMETER_PART_MAIN, LV_STATE_DEFAULT, 4);
+    lv_refr_now(NULL);
+
+    bool same = true;
+    uint32_t i;
+    uint32_t v;
+    for(v = 0; v <= 100; v += 13) {
+        for(i = 0; i < LMETER_CNT; i++) lv_linemeter_set_value(lmeters[i], (v + i * 17) % 101);
+        if(!refr_same_as_full()) same = false;
+    }
+
+    lv_test_assert_true(same, "Same as a full redraw");
+}
+
+#if LV_USE_GAUGE
+static void gauge_bands(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw a gauge in several bands:");
+    lv_test_print("------------------------------");
+
+    /*With `LV_USE_REFR_THREADS` the bands are drawn parallel and the major scale has less lines
+     *than the main scale so both scales are drawn with their own line count at the same time*/
+    lv_obj_t * gauge = lv_gauge_create(lv_scr_act(), NULL);
+    lv_obj_set_size(gauge, lv_obj_get_height(lv_scr_act()), lv_obj_get_height(lv_scr_act()));
+    lv_gauge_set_scale(gauge, 240, 31, 7);
+    lv_gauge_set_value(gauge, 0, 40);
+
+    /*Use a small draw buffer to refresh the screen in several bands*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * buf_ori = disp->driver.buffer;
+    static lv_disp_buf_t band_buf;
+    static lv_color_t band_buf1[LV_HOR_RES_MAX * LV_VER_RES_MAX / GAUGE_BAND_CNT];
+    lv_disp_buf_init(&band_buf, band_buf1, NULL, sizeof(band_buf1) / sizeof(band_buf1[0]));
+    disp->driver.buffer = &band_buf;
+
+    /*Without anti-aliasing the lines slightly depend on the band borders
+     *so compare with the same bands drawn earlier*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    memcpy(refr_fb, screen_fb, sizeof(screen_fb));
+
+    bool same = true;
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+        if(memcmp(refr_fb, screen_fb, sizeof(screen_fb)) != 0) same = false;
+    }
+
+    disp->driver.buffer = buf_ori;
+    lv_obj_del(gauge);
+
+    lv_test_assert_true(same, "Same in every refresh");
+}
+#endif
+
+/**
+ * Create some normal and mirrored line meters next to each other
+ */
+static void create_lmeters(void)
+{
+    lv_coord_t size = LV_MATH_MIN(lv_obj_get_width(lv_scr_act()) / LMETER_CNT, lv_obj_get_height(lv_scr_act()));
+
+    uint32_t i;
+    for(i = 0; i < LMETER_CNT; i++) {
+        lmeters[i] = lv_linemeter_create(lv_scr_act(), NULL);
+        lv_obj_set_size(lmeters[i], size, size);
+        lv_obj_set_pos(lmeters[i], i * size, 0);
+        lv_linemeter_set_scale(lmeters[i], 200 + i * 40, 11 + i * 10);
+        lv_linemeter_set_mirror(lmeters[i], i == 1);
+    }
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/**
+ * Refresh the invalidated areas then redraw the whole screen and compare the results
+ * @return true: the screens are the same
+ */
+static bool refr_same_as_full(void)
+{
+    lv_refr_now(NULL);
+    memcpy(refr_fb, screen_fb, sizeof(screen_fb));
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    return memcmp(refr_fb, screen_fb, sizeof(screen_fb)) == 0;
+}
+
+#if LV_LINEMETER_SCALE_CACHE
+/**
+ * Get the number of invalidated pixels on the default display
+ */
+static uint32_t get_inv_size(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t size = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i] == 0) size += lv_area_get_size(&disp->inv_areas[i]);
+    }
+
+    return size;
+}
+#endif
+
+static void screen_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&screen_fb[y * LV_HOR_RES_MAX + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+#endif /*LV_USE_LINEMETER*/
+#endif /*LV_BUILD_TEST*/